@@ -27,16 +27,21 @@
 #include <sup/oac-tree-server/automation_server.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 #include <sup/oac-tree-server/epics_config_utils.h>
+#include <sup/oac-tree-server/epics_server_config.h>
 
 #include <sup/cli/command_line_parser.h>
 #include <sup/epics/epics_protocol_factory.h>
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
 
 using namespace sup::oac_tree_server;
 
+// Interval for rescanning a watched directory when no changes were reported:
+const sup::dto::uint32 kWatchRescanIntervalMs = 60000;
+
 int main(int argc, char* argv[])
 {
   sup::cli::CommandLineParser parser;
@@ -54,6 +59,48 @@ int main(int argc, char* argv[])
       .SetParameter(true)
       .SetValueName("directory_name");
 
+  parser.AddOption({"-c", "--coalesce"}, "Only publish the latest state of instructions, variables "
+                   "and jobs when updates arrive faster than they can be published");
+
+  parser.AddOption({"-p", "--publishers"}, "Publish the values of all procedures with a fixed "
+                   "number of threads (0 means the number of hardware threads)")
+      .SetParameter(true)
+      .SetValueName("n_publishers");
+
+  parser.AddOption({"-k", "--keyframe-interval"}, "Publish variable updates as their changed "
+                   "fields only, with a full update every given number of updates")
+      .SetParameter(true)
+      .SetValueName("n_updates");
+
+  parser.AddOption({"-r", "--retain-entries"}, "Number of log, message and output value entries "
+                   "retained per job for clients that missed them (default 1024)")
+      .SetParameter(true)
+      .SetValueName("n_entries");
+
+  parser.AddOption({"-b", "--batch-interval"}, "Publish log and message entries in batches, "
+                   "at most every given number of milliseconds")
+      .SetParameter(true)
+      .SetValueName("milliseconds");
+
+  parser.AddOption({"-n", "--native"}, "Publish structured values without base64 encoding "
+                   "(clients not supporting protocol version 1.1 cannot decode them)");
+
+  parser.AddOption({"-l", "--lazy"}, "Only instantiate the published values and the job of a "
+                   "procedure when it is first used by a client");
+
+  parser.AddOption({"-i", "--idle-timeout"}, "In lazy mode, tear down jobs that are not running "
+                   "and were not used for the given number of seconds")
+      .SetParameter(true)
+      .SetValueName("seconds");
+
+  parser.AddOption({"-u", "--input-timeout"}, "Abandon requests for user input that were not "
+                   "answered within the given number of seconds")
+      .SetParameter(true)
+      .SetValueName("seconds");
+
+  parser.AddOption({"-w", "--watch"}, "Watch the directory given with --dir and add, replace or "
+                   "remove jobs when its procedure files are added, modified or deleted");
+
   parser.AddPositionalOption("FILE...", "File(s) to be parsed and run as procedures");
 
   if (!parser.Parse(argc, argv))
@@ -64,12 +111,79 @@ int main(int argc, char* argv[])
 
   auto proc_list = utils::GetProcedureList(parser);
   auto service_name = parser.GetValue<std::string>("--service");
-  auto anyvalue_manager_registry = utils::CreateEPICSAnyValueManagerRegistry(proc_list.size());
+  EPICSServerConfig server_config{};
+  server_config.m_coalesce_updates = parser.IsSet("--coalesce");
+  server_config.m_native_channels = parser.IsSet("--native");
+  server_config.m_error_handler = [](const std::string& message) {
+    std::cerr << message << std::endl;
+  };
+  std::unique_ptr<IAnyValueManagerRegistry> anyvalue_manager_registry;
+  if (parser.IsSet("--publishers"))
+  {
+    auto n_publishers = parser.GetValue<sup::dto::uint32>("--publishers");
+    anyvalue_manager_registry =
+      utils::CreateShardedEPICSAnyValueManagerRegistry(n_publishers, server_config);
+  }
+  else
+  {
+    // Jobs that are added later share the managers of the initial jobs, so at least one is needed:
+    auto n_managers = std::max<std::size_t>(proc_list.size(), 1u);
+    anyvalue_manager_registry =
+      utils::CreateEPICSAnyValueManagerRegistry(n_managers, server_config);
+  }
 
-  AutomationServer auto_server{service_name, *anyvalue_manager_registry};
-  for (auto& proc : proc_list)
+  ServerJobInfoIOConfig job_info_io_config{};
+  if (parser.IsSet("--keyframe-interval"))
+  {
+    job_info_io_config.m_variable_keyframe_interval =
+      parser.GetValue<sup::dto::uint32>("--keyframe-interval");
+  }
+  if (parser.IsSet("--retain-entries"))
+  {
+    job_info_io_config.m_output_entry_history_size =
+      parser.GetValue<sup::dto::uint32>("--retain-entries");
+  }
+  if (parser.IsSet("--batch-interval"))
+  {
+    job_info_io_config.m_entry_batch_interval_ms =
+      parser.GetValue<sup::dto::uint32>("--batch-interval");
+  }
+  if (parser.IsSet("--input-timeout"))
+  {
+    job_info_io_config.m_user_input_timeout_ms =
+      parser.GetValue<sup::dto::uint32>("--input-timeout") * 1000u;
+  }
+  ServerJobConfig server_job_config{};
+  server_job_config.m_lazy_instantiation = parser.IsSet("--lazy");
+  if (parser.IsSet("--idle-timeout"))
+  {
+    server_job_config.m_idle_timeout_ms =
+      parser.GetValue<sup::dto::uint32>("--idle-timeout") * 1000u;
+  }
+  AutomationServer auto_server{service_name, *anyvalue_manager_registry, job_info_io_config,
+                               server_job_config};
+  std::unique_ptr<utils::ProcedureDirectoryWatcher> dir_watcher;
+  if (parser.IsSet("--watch") && parser.IsSet("--dir"))
+  {
+    dir_watcher = std::make_unique<utils::ProcedureDirectoryWatcher>(
+      parser.GetValue<std::string>("--dir"), auto_server, std::cerr);
+  }
+  // Torn down jobs are instantiated again by parsing their file again:
+  std::vector<std::string> filenames;
+  std::vector<ProcedureFactory> factories;
+  for (const auto& proc : proc_list)
+  {
+    filenames.push_back(proc->GetFilename());
+    factories.push_back(utils::CreateProcedureFileFactory(filenames.back()));
+  }
+  // Jobs are set up concurrently, but their indices follow the order of the files:
+  auto job_indices = auto_server.AddJobs(std::move(proc_list), factories);
+  if (dir_watcher)
   {
-    auto_server.AddJob(std::move(proc));
+    for (std::size_t idx = 0; idx < job_indices.size(); ++idx)
+    {
+      dir_watcher->RegisterJob(filenames[idx], job_indices[idx]);
+    }
   }
   // Instantiate RPC server for obtaining job information
   auto info_server_protocol = std::make_unique<InfoProtocolServer>(auto_server);
@@ -86,6 +200,13 @@ int main(int argc, char* argv[])
 
   while(true)
   {
-    std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (!dir_watcher)
+    {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      continue;
+    }
+    // The timeout also rescans the directory periodically, in case changes were missed:
+    (void)dir_watcher->WaitForChanges(kWatchRescanIntervalMs);
+    dir_watcher->Update();
   }
 }
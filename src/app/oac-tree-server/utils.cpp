@@ -24,9 +24,20 @@
 
 #include <sup/oac-tree/sequence_parser.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 const std::string kProcedureExtension = ".xml";
+// Interval for scanning a directory that cannot be watched with inotify:
+const sup::dto::uint32 kDirectoryPollIntervalMs = 1000;
 
 namespace
 {
@@ -38,6 +49,24 @@ bool EndsWith(const std::string& str, const std::string& end)
   }
   return false;
 }
+
+int CreateDirectoryWatch(const std::string& directory)
+{
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  // Attribute changes include modifications of the write time without a write, e.g. by touch:
+  const uint32_t mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO
+                        | IN_ATTRIB;
+  if (inotify_add_watch(fd, directory.c_str(), mask) < 0)
+  {
+    (void)close(fd);
+    return -1;
+  }
+  return fd;
+}
 }
 
 namespace sup
@@ -47,32 +76,258 @@ namespace oac_tree_server
 namespace utils
 {
 
+std::vector<std::string> GetDirectoryProcedureFilenames(const std::string& directory)
+{
+  std::vector<std::string> result{};
+  for (const auto& entry : std::filesystem::directory_iterator(directory))
+  {
+    if (entry.is_regular_file() && EndsWith(entry.path().string(), kProcedureExtension))
+    {
+      result.push_back(entry.path());
+    }
+  }
+  // Directory iteration order is unspecified, while job indices need to be deterministic:
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
 std::vector<std::string> GetProcedureFilenames(sup::cli::CommandLineParser& parser)
 {
   std::vector<std::string> result{};
   if (parser.IsSet("--dir")) {
     auto dir = parser.GetValue<std::string>("--dir");
-    for (const auto& entry : std::filesystem::directory_iterator(dir))
+    result = GetDirectoryProcedureFilenames(dir);
+  }
+  auto positional_args = parser.GetPositionalValues();
+  result.insert(result.end(), positional_args.begin(), positional_args.end());
+  return result;
+}
+
+ProcedureList ParseProcedureFiles(const std::vector<std::string>& filenames,
+                                  std::ostream& error_stream)
+{
+  std::vector<std::unique_ptr<sup::oac_tree::Procedure>> procedures(filenames.size());
+  std::vector<std::string> errors(filenames.size());
+  std::atomic<std::size_t> next_idx{0};
+  auto parse_func = [&filenames, &procedures, &errors, &next_idx]() {
+    for (auto idx = next_idx++; idx < filenames.size(); idx = next_idx++)
     {
-      if (entry.is_regular_file() && EndsWith(entry.path().string(), kProcedureExtension))
+      try
       {
-        result.push_back(entry.path());
+        procedures[idx] = sup::oac_tree::ParseProcedureFile(filenames[idx]);
+      }
+      catch(const std::exception& e)
+      {
+        errors[idx] = e.what();
       }
     }
+  };
+  auto n_threads = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                         filenames.size());
+  std::vector<std::future<void>> workers{};
+  for (std::size_t i = 0; i < n_threads; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, parse_func));
+  }
+  for (auto& worker : workers)
+  {
+    worker.get();
+  }
+  ProcedureList result;
+  for (std::size_t idx = 0; idx < filenames.size(); ++idx)
+  {
+    if (procedures[idx])
+    {
+      result.push_back(std::move(procedures[idx]));
+      continue;
+    }
+    error_stream << "Could not load procedure from file [" << filenames[idx] << "]: "
+                 << errors[idx] << std::endl;
   }
-  auto positional_args = parser.GetPositionalValues();
-  result.insert(result.end(), positional_args.begin(), positional_args.end());
   return result;
 }
+
 ProcedureList GetProcedureList(sup::cli::CommandLineParser& parser)
 {
-  ProcedureList result;
   auto filenames = GetProcedureFilenames(parser);
+  return ParseProcedureFiles(filenames, std::cerr);
+}
+
+ProcedureFactory CreateProcedureFileFactory(const std::string& filename)
+{
+  return [filename]() { return sup::oac_tree::ParseProcedureFile(filename); };
+}
+
+ProcedureDirectoryWatcher::ProcedureDirectoryWatcher(const std::string& directory,
+                                                     AutomationServer& auto_server,
+                                                     std::ostream& error_stream)
+  : m_directory{directory}
+  , m_auto_server{auto_server}
+  , m_error_stream{error_stream}
+  , m_files{}
+  , m_inotify_fd{CreateDirectoryWatch(directory)}
+{
+  if (m_inotify_fd < 0)
+  {
+    m_error_stream << "Could not watch directory [" << m_directory << "] for changes; it will be "
+                   << "scanned every second instead" << std::endl;
+  }
+}
+
+ProcedureDirectoryWatcher::~ProcedureDirectoryWatcher()
+{
+  if (m_inotify_fd >= 0)
+  {
+    (void)close(m_inotify_fd);
+  }
+}
+
+void ProcedureDirectoryWatcher::RegisterJob(const std::string& filename, sup::dto::uint32 job_idx)
+{
+  // Only accept filenames as they are listed when scanning the directory:
+  std::filesystem::path path{filename};
+  if (path != std::filesystem::path(m_directory) / path.filename())
+  {
+    return;
+  }
+  std::error_code ec;
+  auto write_time = std::filesystem::last_write_time(filename, ec);
+  m_files[filename] = WatchedFile{ write_time, true, job_idx };
+}
+
+void ProcedureDirectoryWatcher::Update()
+{
+  std::vector<std::string> filenames;
+  try
+  {
+    filenames = GetDirectoryProcedureFilenames(m_directory);
+  }
+  catch(const std::filesystem::filesystem_error& e)
+  {
+    m_error_stream << "Could not scan directory [" << m_directory << "]: " << e.what()
+                   << std::endl;
+    return;
+  }
+  for (auto iter = m_files.begin(); iter != m_files.end();)
+  {
+    if (std::find(filenames.begin(), filenames.end(), iter->first) != filenames.end())
+    {
+      ++iter;
+      continue;
+    }
+    if (iter->second.m_has_job)
+    {
+      try
+      {
+        m_auto_server.RemoveJob(iter->second.m_job_idx);
+      }
+      catch(const std::exception& e)
+      {
+        m_error_stream << "Could not remove job for file [" << iter->first << "]: " << e.what()
+                       << std::endl;
+      }
+    }
+    iter = m_files.erase(iter);
+  }
   for (const auto& filename : filenames)
   {
-    result.emplace_back(sup::oac_tree::ParseProcedureFile(filename));
+    std::error_code ec;
+    auto write_time = std::filesystem::last_write_time(filename, ec);
+    if (ec)
+    {
+      // File was removed in the meantime and will be handled by the next update:
+      continue;
+    }
+    UpdateFile(filename, write_time);
+  }
+}
+
+bool ProcedureDirectoryWatcher::WaitForChanges(sup::dto::uint32 timeout_ms)
+{
+  if (m_inotify_fd < 0)
+  {
+    auto poll_interval_ms = std::min(timeout_ms, kDirectoryPollIntervalMs);
+    std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
+    return true;
+  }
+  pollfd poll_fd{ m_inotify_fd, POLLIN, 0 };
+  if (poll(&poll_fd, 1, static_cast<int>(timeout_ms)) <= 0)
+  {
+    return false;
+  }
+  // Update scans the whole directory, so the events themselves are only drained:
+  alignas(inotify_event) char buffer[4096];
+  while (read(m_inotify_fd, buffer, sizeof(buffer)) > 0)
+  {}
+  return true;
+}
+
+void ProcedureDirectoryWatcher::UpdateFile(const std::string& filename,
+                                           std::filesystem::file_time_type write_time)
+{
+  auto iter = m_files.find(filename);
+  if (iter != m_files.end() && iter->second.m_write_time == write_time)
+  {
+    return;
+  }
+  std::unique_ptr<sup::oac_tree::Procedure> proc;
+  try
+  {
+    proc = sup::oac_tree::ParseProcedureFile(filename);
+  }
+  catch(const std::exception& e)
+  {
+    m_error_stream << "Could not load procedure from file [" << filename << "]: " << e.what()
+                   << std::endl;
+  }
+  auto factory = CreateProcedureFileFactory(filename);
+  if (iter == m_files.end())
+  {
+    iter = m_files.emplace(filename, WatchedFile{ write_time, false, 0 }).first;
+    if (proc)
+    {
+      AddJob(filename, iter->second, std::move(proc), factory);
+    }
+    return;
+  }
+  // A modified file that fails to parse (e.g. while it is being written) keeps the current job:
+  auto& watched_file = iter->second;
+  watched_file.m_write_time = write_time;
+  if (!proc)
+  {
+    return;
+  }
+  if (watched_file.m_has_job)
+  {
+    try
+    {
+      m_auto_server.ReplaceJob(watched_file.m_job_idx, std::move(proc), factory);
+    }
+    catch(const std::exception& e)
+    {
+      m_error_stream << "Could not replace job for file [" << filename << "]: " << e.what()
+                     << std::endl;
+    }
+    return;
+  }
+  AddJob(filename, watched_file, std::move(proc), factory);
+}
+
+void ProcedureDirectoryWatcher::AddJob(const std::string& filename, WatchedFile& watched_file,
+                                       std::unique_ptr<sup::oac_tree::Procedure> proc,
+                                       const ProcedureFactory& factory)
+{
+  // When adding the job fails, the file is retried only after it was modified again:
+  try
+  {
+    watched_file.m_job_idx = m_auto_server.AddJob(std::move(proc), factory);
+    watched_file.m_has_job = true;
+  }
+  catch(const std::exception& e)
+  {
+    m_error_stream << "Could not add job for file [" << filename << "]: " << e.what()
+                   << std::endl;
   }
-  return result;
 }
 
 }  // namespace utils
@@ -23,12 +23,16 @@
 #ifndef SUP_OAC_TREE_SERVER_SUP_AUTOMATION_SERVER_UTILS_H_
 #define SUP_OAC_TREE_SERVER_SUP_AUTOMATION_SERVER_UTILS_H_
 
+#include <sup/oac-tree-server/automation_server.h>
 #include <sup/oac-tree-server/i_anyvalue_manager_registry.h>
 
 #include <sup/cli/command_line_parser.h>
 #include <sup/oac-tree/procedure.h>
 
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <ostream>
 
 namespace sup
 {
@@ -38,10 +42,90 @@ namespace utils
 {
 using ProcedureList = std::vector<std::unique_ptr<sup::oac_tree::Procedure>>;
 
+/**
+ * @brief Get the names of all procedure files in the given directory, sorted by name.
+ */
+std::vector<std::string> GetDirectoryProcedureFilenames(const std::string& directory);
+
+/**
+ * @brief Get the procedure filenames from the command line. Files found in a directory are sorted
+ * by name and precede the explicitly listed files, which keep their order.
+ */
 std::vector<std::string> GetProcedureFilenames(sup::cli::CommandLineParser& parser);
 
+/**
+ * @brief Parse the given procedure files concurrently. The order of the returned procedures
+ * follows the order of the filenames. Files that fail to parse are reported on the error stream
+ * and skipped, so they do not prevent loading the other files.
+ */
+ProcedureList ParseProcedureFiles(const std::vector<std::string>& filenames,
+                                  std::ostream& error_stream);
+
+/**
+ * @brief Parse all procedure files from the command line. Parse errors are reported on std::cerr.
+ */
 ProcedureList GetProcedureList(sup::cli::CommandLineParser& parser);
 
+/**
+ * @brief Create a factory that parses the procedure from the given file each time it is called.
+ */
+ProcedureFactory CreateProcedureFileFactory(const std::string& filename);
+
+/**
+ * @brief ProcedureDirectoryWatcher keeps the jobs of an AutomationServer in sync with the
+ * procedure files in a directory: jobs are added for new files, replaced when their file was
+ * modified and removed when their file was deleted. Each call to Update scans the directory once.
+ * WaitForChanges allows to only scan the directory after it was changed.
+ */
+class ProcedureDirectoryWatcher
+{
+public:
+  ProcedureDirectoryWatcher(const std::string& directory, AutomationServer& auto_server,
+                            std::ostream& error_stream);
+  ~ProcedureDirectoryWatcher();
+
+  ProcedureDirectoryWatcher(const ProcedureDirectoryWatcher&) = delete;
+  ProcedureDirectoryWatcher& operator=(const ProcedureDirectoryWatcher&) = delete;
+
+  /**
+   * @brief Register a job that was already added to the server for the given file, e.g. at
+   * startup. Files that are not in the watched directory are ignored.
+   */
+  void RegisterJob(const std::string& filename, sup::dto::uint32 job_idx);
+
+  /**
+   * @brief Scan the directory and add, replace or remove jobs accordingly. Failures are reported
+   * per file on the error stream and do not affect the other files.
+   */
+  void Update();
+
+  /**
+   * @brief Wait until files in the directory were added, modified or removed, using inotify. When
+   * the directory could not be watched, this waits for at most a second instead.
+   *
+   * @param timeout_ms Maximum time to wait in milliseconds.
+   * @return true when the directory may have changed and needs to be scanned with Update.
+   */
+  bool WaitForChanges(sup::dto::uint32 timeout_ms);
+
+private:
+  struct WatchedFile
+  {
+    std::filesystem::file_time_type m_write_time;
+    bool m_has_job;
+    sup::dto::uint32 m_job_idx;
+  };
+  void UpdateFile(const std::string& filename, std::filesystem::file_time_type write_time);
+  void AddJob(const std::string& filename, WatchedFile& watched_file,
+              std::unique_ptr<sup::oac_tree::Procedure> proc, const ProcedureFactory& factory);
+  const std::string m_directory;
+  AutomationServer& m_auto_server;
+  std::ostream& m_error_stream;
+  std::map<std::string, WatchedFile> m_files;
+  // File descriptor of the inotify instance, or -1 when the directory is not watched:
+  int m_inotify_fd;
+};
+
 }  // namespace utils
 
 }  // namespace oac_tree_server
@@ -30,10 +30,20 @@ namespace sup
 namespace oac_tree_server
 {
 
-void InitializeJobAndVariables(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
+/**
+ * @brief Add the AnyValues of the job state and variables and the input handler of a job.
+ *
+ * @return true when both the AnyValues and the input handler were added.
+ */
+bool InitializeJobAndVariables(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
                                sup::dto::uint32 n_vars);
 
-void InitializeInstructions(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
+/**
+ * @brief Add the AnyValues of the instructions of a job.
+ *
+ * @return true when the AnyValues were added.
+ */
+bool InitializeInstructions(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
                             sup::dto::uint32 n_instr);
 
 }  // namespace oac_tree_server
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_ASYNC_JOB_MANAGER_H_
+#define SUP_OAC_TREE_SERVER_ASYNC_JOB_MANAGER_H_
+
+#include <sup/oac-tree-server/i_async_job_manager.h>
+#include <sup/oac-tree-server/reply_executor.h>
+
+#include <memory>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Default number of threads used by AsyncJobManager to execute requests.
+ */
+const std::size_t kDefaultAsyncJobManagerThreads = 1;
+
+/**
+ * @brief AsyncJobManager is a non-blocking facade that implements IAsyncJobManager on top of a
+ * synchronous IJobManager, e.g. an AutomationProtocolClient or AutomationClientStack.
+ *
+ * @details Requests are queued and executed by a fixed number of worker threads, so at most that
+ * many requests are in flight at the same time; further requests wait for a free thread. Each
+ * request is a plain synchronous call on the wrapped job manager: there is no request id or
+ * pipelining on the wire. By default, a single thread executes the requests one after the other,
+ * so the caller is not blocked, but requests are not sped up. More threads are only accepted when
+ * the wrapped job manager supports concurrent calls (see IJobManager::SupportsConcurrentCalls).
+ *
+ * The wrapped job manager needs to outlive this object: requests that are still queued on
+ * destruction are executed before the destructor returns.
+ */
+class AsyncJobManager : public IAsyncJobManager
+{
+public:
+  explicit AsyncJobManager(IJobManager& job_manager);
+
+  /**
+   * @brief Construct with the given number of threads.
+   *
+   * @throws InvalidOperationException when the number of threads is zero, or larger than one for
+   * a job manager that does not support concurrent calls.
+   */
+  AsyncJobManager(IJobManager& job_manager, std::size_t n_threads);
+  ~AsyncJobManager() override;
+
+  std::future<std::string> GetServerPrefix() const override;
+
+  std::future<sup::dto::uint32> GetNumberOfJobs() const override;
+
+  std::future<sup::oac_tree::JobInfo> GetJobInfo(sup::dto::uint32 job_idx) const override;
+
+  std::future<JobManagerInfo> GetAllJobInfos(
+    const std::vector<sup::dto::uint32>& job_indices) const override;
+
+  std::future<std::vector<sup::dto::uint64>> GetJobGenerations() const override;
+
+  std::future<OutputEntries> GetOutputEntries(
+    sup::dto::uint32 job_idx, const OutputEntryIndices& last_indices) const override;
+
+  std::future<void> EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
+                                   bool breakpoint_active) override;
+
+  std::future<void> EditBreakpoints(sup::dto::uint32 job_idx,
+                                    const std::set<sup::dto::uint32>& instr_indices,
+                                    bool breakpoint_active) override;
+
+  std::future<void> SendJobCommand(sup::dto::uint32 job_idx,
+                                   sup::oac_tree::JobCommand command) override;
+
+  std::future<std::vector<bool>> SendJobCommands(
+    const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command) override;
+
+  /**
+   * @brief Get the number of threads that execute requests.
+   */
+  std::size_t GetNumberOfThreads() const;
+
+private:
+  IJobManager& m_job_manager;
+  std::unique_ptr<ReplyExecutor> m_executor;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_ASYNC_JOB_MANAGER_H_
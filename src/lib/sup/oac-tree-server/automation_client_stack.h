@@ -35,7 +35,8 @@ namespace oac_tree_server
 {
 /**
  * @brief AutomationClientStack creates a client IJobManager that takes ownership of the whole
- * underlying network stack.
+ * underlying network stack. It caches the JobInfo objects it retrieves and reuses them as long as
+ * the server reports the same job generation.
  */
 class AutomationClientStack : public IJobManager
 {
@@ -49,10 +50,23 @@ public:
 
   sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx) const override;
 
+  JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const override;
+
+  std::vector<sup::dto::uint64> GetJobGenerations() const override;
+
+  OutputEntries GetOutputEntries(sup::dto::uint32 job_idx,
+                                 const OutputEntryIndices& last_indices) const override;
+
   void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx, bool breakpoint_active) override;
 
+  void EditBreakpoints(sup::dto::uint32 job_idx, const std::set<sup::dto::uint32>& instr_indices,
+                       bool breakpoint_active) override;
+
   void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) override;
 
+  std::vector<bool> SendJobCommands(const std::vector<sup::dto::uint32>& job_indices,
+                                    sup::oac_tree::JobCommand command) override;
+
 private:
   class AutomationClientStackImpl;
   std::unique_ptr<AutomationClientStackImpl> m_impl;
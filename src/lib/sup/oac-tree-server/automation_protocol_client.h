@@ -51,11 +51,27 @@ public:
 
   sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx) const override;
 
+  JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const override;
+
+  std::vector<sup::dto::uint64> GetJobGenerations() const override;
+
+  OutputEntries GetOutputEntries(sup::dto::uint32 job_idx,
+                                 const OutputEntryIndices& last_indices) const override;
+
   void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx, bool breakpoint_active) override;
 
+  void EditBreakpoints(sup::dto::uint32 job_idx, const std::set<sup::dto::uint32>& instr_indices,
+                       bool breakpoint_active) override;
+
   void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) override;
 
+  std::vector<bool> SendJobCommands(const std::vector<sup::dto::uint32>& job_indices,
+                                    sup::oac_tree::JobCommand command) override;
+
 private:
+  JobManagerInfo GetJobInfosSeparately(const std::vector<sup::dto::uint32>& job_indices) const;
+  std::vector<bool> SendJobCommandsSeparately(const std::vector<sup::dto::uint32>& job_indices,
+                                              sup::oac_tree::JobCommand command);
   sup::protocol::Protocol& m_info_protocol;
   sup::protocol::Protocol& m_control_protocol;
 };
@@ -25,9 +25,13 @@
 
 #include <sup/oac-tree-server/i_anyvalue_manager_registry.h>
 #include <sup/oac-tree-server/i_job_manager.h>
+#include <sup/oac-tree-server/server_job.h>
+#include <sup/oac-tree-server/server_job_info_io.h>
+#include <sup/oac-tree-server/server_job_table.h>
 
-#include <sup/oac-tree/local_job.h>
-
+#include <atomic>
+#include <condition_variable>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -44,32 +48,149 @@ namespace oac_tree_server
  * an IAnyValueManager implementation, managed by a registry. The JobInterface object will
  * be responsible for mapping Instruction pointers and Variable names to the correct value names and
  * methods of IAnyValueManager.
+ *
+ * @note Jobs can be instantiated lazily on first use and torn down again when idle, see
+ * ServerJobConfig.
  */
 class AutomationServer : public IJobManager
 {
 public:
   AutomationServer(const std::string& server_prefix, IAnyValueManagerRegistry& av_mgr_registry);
+  AutomationServer(const std::string& server_prefix, IAnyValueManagerRegistry& av_mgr_registry,
+                   const ServerJobInfoIOConfig& job_info_io_config);
+  AutomationServer(const std::string& server_prefix, IAnyValueManagerRegistry& av_mgr_registry,
+                   const ServerJobInfoIOConfig& job_info_io_config,
+                   const ServerJobConfig& server_job_config);
   virtual ~AutomationServer();
 
-  void AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc);
+  /**
+   * @brief Add a job for the given procedure. Jobs can be added while the server is running.
+   *
+   * @param proc Procedure of the job.
+   * @return Index of the new job, which remains valid until the job is removed.
+   */
+  sup::dto::uint32 AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc);
+
+  /**
+   * @brief Add a job together with a factory that can recreate its procedure. This allows the job
+   * to be torn down when it is idle and instantiated again on next use.
+   *
+   * @param proc Procedure of the job.
+   * @param factory Function that creates a new instance of the same procedure.
+   * @return Index of the new job, which remains valid until the job is removed.
+   */
+  sup::dto::uint32 AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc,
+                          const ProcedureFactory& factory);
+
+  /**
+   * @brief Add multiple jobs at once, together with the factories that can recreate their
+   * procedures. Unless jobs are instantiated lazily, their procedures are set up concurrently,
+   * which reduces the startup time of servers with many jobs. The jobs get consecutive indices in
+   * the order of the given procedures.
+   *
+   * @param procs Procedures of the jobs.
+   * @param factories Function that creates a new instance of each procedure, in the same order.
+   * @return Indices of the new jobs, in the order of the given procedures.
+   * @throws InvalidOperationException when the number of factories does not match the number of
+   * procedures. When a job cannot be created, the exception of the first failing job is passed on
+   * and none of the jobs are added.
+   */
+  std::vector<sup::dto::uint32> AddJobs(
+    std::vector<std::unique_ptr<sup::oac_tree::Procedure>> procs,
+    const std::vector<ProcedureFactory>& factories);
+
+  /**
+   * @brief Replace the procedure of an existing job, keeping its index. The new job is created
+   * and, unless jobs are instantiated lazily, its procedure is set up while the current job keeps
+   * running. Only then is the current job halted, its published values released and the new job
+   * put in its place. The replaced job gets a new generation.
+   *
+   * When this method throws, the current job is kept unchanged. Otherwise, the replacement took
+   * effect. Errors that can only occur afterwards, when publishing the values of the new job, are
+   * reported by the next request for the job, which retries publishing.
+   *
+   * @param job_idx Index of the job to replace.
+   * @param proc New procedure of the job.
+   * @throws InvalidOperationException when the index does not refer to an existing job, when no
+   * procedure was provided or when its procedure could not be set up. Exceptions from setting up
+   * the procedure are passed on as well.
+   */
+  void ReplaceJob(sup::dto::uint32 job_idx, std::unique_ptr<sup::oac_tree::Procedure> proc);
+
+  /**
+   * @brief Replace the procedure of an existing job, together with the factory to recreate it.
+   *
+   * @param job_idx Index of the job to replace.
+   * @param proc New procedure of the job.
+   * @param factory Function that creates a new instance of the same procedure.
+   * @throws InvalidOperationException when the index does not refer to an existing job.
+   */
+  void ReplaceJob(sup::dto::uint32 job_idx, std::unique_ptr<sup::oac_tree::Procedure> proc,
+                  const ProcedureFactory& factory);
+
+  /**
+   * @brief Remove a job: it is halted and its published values are released. The indices of other
+   * jobs do not change and the index of the removed job is not reused, so the number of jobs does
+   * not decrease. Requests for a removed job will throw and its generation becomes zero.
+   *
+   * @param job_idx Index of the job to remove.
+   * @throws InvalidOperationException when the index does not refer to an existing job, or when
+   * the job was removed but not all its published values could be released.
+   */
+  void RemoveJob(sup::dto::uint32 job_idx);
+
+  /**
+   * @brief Tear down all lazily instantiated jobs that were idle for at least the configured idle
+   * timeout. When the idle timeout is non-zero, this is called periodically from a background
+   * thread.
+   *
+   * @return Number of jobs that were torn down.
+   */
+  sup::dto::uint32 TearDownIdleJobs();
 
   std::string GetServerPrefix() const override;
   sup::dto::uint32 GetNumberOfJobs() const override;
 
   sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx) const override;
 
+  sup::dto::uint32 GetNumberOfInstructions(sup::dto::uint32 job_idx) const override;
+
+  JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const override;
+
+  std::vector<sup::dto::uint64> GetJobGenerations() const override;
+
+  OutputEntries GetOutputEntries(sup::dto::uint32 job_idx,
+                                 const OutputEntryIndices& last_indices) const override;
+
   void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx, bool breakpoint_active) override;
 
+  void EditBreakpoints(sup::dto::uint32 job_idx, const std::set<sup::dto::uint32>& instr_indices,
+                       bool breakpoint_active) override;
+
   void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) override;
 
+  bool SupportsConcurrentCalls() const override;
+
 private:
-  sup::oac_tree::LocalJob& GetJob(sup::dto::uint32 job_idx);
-  const sup::oac_tree::LocalJob& GetJob(sup::dto::uint32 job_idx) const;
+  std::shared_ptr<ServerJob> GetJob(sup::dto::uint32 job_idx) const;
+  std::shared_ptr<ServerJob> CreateJob(sup::dto::uint32 job_idx,
+                                       std::unique_ptr<sup::oac_tree::Procedure> proc,
+                                       const ProcedureFactory& factory, bool lazy);
+  void RemoveJobImpl(sup::dto::uint32 job_idx);
+  void IdleCleanupLoop();
   const std::string m_server_prefix;
   IAnyValueManagerRegistry& m_av_mgr_registry;
-  std::vector<std::unique_ptr<sup::oac_tree::IJobInfoIO>> m_job_info_ios;
-  std::vector<sup::oac_tree::LocalJob> m_jobs;
-  mutable std::mutex m_mtx;
+  const ServerJobInfoIOConfig m_job_info_io_config;
+  const ServerJobConfig m_server_job_config;
+  // Removed jobs leave an empty slot, so the indices of other jobs remain valid:
+  ServerJobTable m_jobs;
+  std::atomic<sup::dto::uint64> m_next_generation;
+  // Serializes adding, replacing and removing jobs:
+  std::mutex m_edit_mtx;
+  bool m_halt_cleanup;
+  std::mutex m_cleanup_mtx;
+  std::condition_variable m_cleanup_cv;
+  std::future<void> m_cleanup_future;
 };
 
 sup::dto::uint32 GetNumberOfVariables(const sup::oac_tree::Procedure& proc);
@@ -29,20 +29,21 @@ namespace sup
 namespace oac_tree_server
 {
 
-void InitializeJobAndVariables(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
+bool InitializeJobAndVariables(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
                                sup::dto::uint32 n_vars)
 {
   auto value_set = GetInitialValueSet(job_prefix, n_vars);
-  (void)anyvalue_io.AddAnyValues(value_set);
+  bool result = anyvalue_io.AddAnyValues(value_set);
   auto input_server_name = GetInputServerName(job_prefix);
-  (void)anyvalue_io.AddInputHandler(input_server_name);
+  result = anyvalue_io.AddInputHandler(input_server_name) && result;
+  return result;
 }
 
-void InitializeInstructions(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
+bool InitializeInstructions(IAnyValueIO& anyvalue_io, const std::string& job_prefix,
                             sup::dto::uint32 n_instr)
 {
   auto instr_value_set = GetInstructionValueSet(job_prefix, n_instr);
-  (void)anyvalue_io.AddAnyValues(instr_value_set);
+  return anyvalue_io.AddAnyValues(instr_value_set);
 }
 
 }  // namespace oac_tree_server
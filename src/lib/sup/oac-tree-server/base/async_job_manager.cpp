@@ -0,0 +1,166 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/async_job_manager.h>
+
+#include <sup/oac-tree-server/exceptions.h>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+namespace
+{
+template <typename F>
+auto PostRequest(ReplyExecutor& executor, F func) -> std::future<decltype(func())>;
+}  // unnamed namespace
+
+AsyncJobManager::AsyncJobManager(IJobManager& job_manager)
+  : AsyncJobManager{job_manager, kDefaultAsyncJobManagerThreads}
+{}
+
+AsyncJobManager::AsyncJobManager(IJobManager& job_manager, std::size_t n_threads)
+  : m_job_manager{job_manager}
+  , m_executor{}
+{
+  if (n_threads > 1 && !m_job_manager.SupportsConcurrentCalls())
+  {
+    const std::string error = "AsyncJobManager::AsyncJobManager(): wrapped job manager does not "
+      "support concurrent calls from " + std::to_string(n_threads) + " threads";
+    throw InvalidOperationException(error);
+  }
+  m_executor = std::make_unique<ReplyExecutor>(n_threads);
+}
+
+AsyncJobManager::~AsyncJobManager() = default;
+
+std::future<std::string> AsyncJobManager::GetServerPrefix() const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager]() {
+    return job_manager.GetServerPrefix();
+  });
+}
+
+std::future<sup::dto::uint32> AsyncJobManager::GetNumberOfJobs() const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager]() {
+    return job_manager.GetNumberOfJobs();
+  });
+}
+
+std::future<sup::oac_tree::JobInfo> AsyncJobManager::GetJobInfo(sup::dto::uint32 job_idx) const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_idx]() {
+    return job_manager.GetJobInfo(job_idx);
+  });
+}
+
+std::future<JobManagerInfo> AsyncJobManager::GetAllJobInfos(
+  const std::vector<sup::dto::uint32>& job_indices) const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_indices]() {
+    return job_manager.GetAllJobInfos(job_indices);
+  });
+}
+
+std::future<std::vector<sup::dto::uint64>> AsyncJobManager::GetJobGenerations() const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager]() {
+    return job_manager.GetJobGenerations();
+  });
+}
+
+std::future<OutputEntries> AsyncJobManager::GetOutputEntries(
+  sup::dto::uint32 job_idx, const OutputEntryIndices& last_indices) const
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_idx, last_indices]() {
+    return job_manager.GetOutputEntries(job_idx, last_indices);
+  });
+}
+
+std::future<void> AsyncJobManager::EditBreakpoint(sup::dto::uint32 job_idx,
+                                                  sup::dto::uint32 instr_idx,
+                                                  bool breakpoint_active)
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_idx, instr_idx, breakpoint_active]() {
+    job_manager.EditBreakpoint(job_idx, instr_idx, breakpoint_active);
+  });
+}
+
+std::future<void> AsyncJobManager::EditBreakpoints(
+  sup::dto::uint32 job_idx, const std::set<sup::dto::uint32>& instr_indices,
+  bool breakpoint_active)
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor,
+                     [&job_manager, job_idx, instr_indices, breakpoint_active]() {
+                       job_manager.EditBreakpoints(job_idx, instr_indices, breakpoint_active);
+                     });
+}
+
+std::future<void> AsyncJobManager::SendJobCommand(sup::dto::uint32 job_idx,
+                                                  sup::oac_tree::JobCommand command)
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_idx, command]() {
+    job_manager.SendJobCommand(job_idx, command);
+  });
+}
+
+std::future<std::vector<bool>> AsyncJobManager::SendJobCommands(
+  const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command)
+{
+  auto& job_manager = m_job_manager;
+  return PostRequest(*m_executor, [&job_manager, job_indices, command]() {
+    return job_manager.SendJobCommands(job_indices, command);
+  });
+}
+
+std::size_t AsyncJobManager::GetNumberOfThreads() const
+{
+  return m_executor->GetNumberOfThreads();
+}
+
+namespace
+{
+template <typename F>
+auto PostRequest(ReplyExecutor& executor, F func) -> std::future<decltype(func())>
+{
+  // ReplyExecutor tasks need to be copyable, so the packaged task is shared with the closure
+  using ResultType = decltype(func());
+  auto task = std::make_shared<std::packaged_task<ResultType()>>(std::move(func));
+  auto result = task->get_future();
+  executor.Post([task]() { (*task)(); });
+  return result;
+}
+}  // unnamed namespace
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
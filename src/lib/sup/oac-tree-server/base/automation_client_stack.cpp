@@ -27,6 +27,9 @@
 
 #include <sup/protocol/protocol_rpc_client.h>
 
+#include <map>
+#include <mutex>
+
 namespace sup
 {
 namespace oac_tree_server
@@ -41,10 +44,23 @@ public:
 
   IJobManager& GetJobManager();
 
+  sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx);
+
+  JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices);
+
 private:
+  // These require the cache mutex to be locked:
+  const sup::oac_tree::JobInfo* GetCachedJobInfo(
+    sup::dto::uint32 job_idx, const std::vector<sup::dto::uint64>& generations) const;
+  void CacheJobInfo(sup::dto::uint32 job_idx, const std::vector<sup::dto::uint64>& generations,
+                    const sup::oac_tree::JobInfo& job_info);
   std::unique_ptr<sup::protocol::Protocol> m_info_protocol;
   std::unique_ptr<sup::protocol::Protocol> m_control_protocol;
   AutomationProtocolClient m_auto_protocol_client;
+  bool m_server_prefix_cached;
+  std::string m_server_prefix;
+  std::map<sup::dto::uint32, std::pair<sup::dto::uint64, sup::oac_tree::JobInfo>> m_job_info_cache;
+  std::mutex m_cache_mtx;
 };
 
 AutomationClientStack::AutomationClientStack(
@@ -76,7 +92,24 @@ sup::dto::uint32 AutomationClientStack::GetNumberOfJobs() const
 
 sup::oac_tree::JobInfo AutomationClientStack::GetJobInfo(sup::dto::uint32 job_idx) const
 {
-  return m_impl->GetJobManager().GetJobInfo(job_idx);
+  return m_impl->GetJobInfo(job_idx);
+}
+
+JobManagerInfo AutomationClientStack::GetAllJobInfos(
+  const std::vector<sup::dto::uint32>& job_indices) const
+{
+  return m_impl->GetAllJobInfos(job_indices);
+}
+
+std::vector<sup::dto::uint64> AutomationClientStack::GetJobGenerations() const
+{
+  return m_impl->GetJobManager().GetJobGenerations();
+}
+
+OutputEntries AutomationClientStack::GetOutputEntries(sup::dto::uint32 job_idx,
+                                                     const OutputEntryIndices& last_indices) const
+{
+  return m_impl->GetJobManager().GetOutputEntries(job_idx, last_indices);
 }
 
 void AutomationClientStack::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
@@ -85,18 +118,35 @@ void AutomationClientStack::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::u
   return m_impl->GetJobManager().EditBreakpoint(job_idx, instr_idx, breakpoint_active);
 }
 
+void AutomationClientStack::EditBreakpoints(sup::dto::uint32 job_idx,
+                                            const std::set<sup::dto::uint32>& instr_indices,
+                                            bool breakpoint_active)
+{
+  return m_impl->GetJobManager().EditBreakpoints(job_idx, instr_indices, breakpoint_active);
+}
+
 void AutomationClientStack::SendJobCommand(sup::dto::uint32 job_idx,
                                            sup::oac_tree::JobCommand command)
 {
   return m_impl->GetJobManager().SendJobCommand(job_idx, command);
 }
 
+std::vector<bool> AutomationClientStack::SendJobCommands(
+  const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command)
+{
+  return m_impl->GetJobManager().SendJobCommands(job_indices, command);
+}
+
 AutomationClientStack::AutomationClientStackImpl::AutomationClientStackImpl(
   std::unique_ptr<sup::protocol::Protocol> info_protocol,
   std::unique_ptr<sup::protocol::Protocol> control_protocol)
   : m_info_protocol{std::move(info_protocol)}
   , m_control_protocol{std::move(control_protocol)}
   , m_auto_protocol_client{*m_info_protocol, *m_control_protocol}
+  , m_server_prefix_cached{false}
+  , m_server_prefix{}
+  , m_job_info_cache{}
+  , m_cache_mtx{}
 {}
 
 IJobManager& AutomationClientStack::AutomationClientStackImpl::GetJobManager()
@@ -104,6 +154,104 @@ IJobManager& AutomationClientStack::AutomationClientStackImpl::GetJobManager()
   return m_auto_protocol_client;
 }
 
+sup::oac_tree::JobInfo AutomationClientStack::AutomationClientStackImpl::GetJobInfo(
+  sup::dto::uint32 job_idx)
+{
+  auto generations = m_auto_protocol_client.GetJobGenerations();
+  {
+    std::lock_guard<std::mutex> lk{m_cache_mtx};
+    auto cached_job_info = GetCachedJobInfo(job_idx, generations);
+    if (cached_job_info != nullptr)
+    {
+      return *cached_job_info;
+    }
+  }
+  auto job_info = m_auto_protocol_client.GetJobInfo(job_idx);
+  std::lock_guard<std::mutex> lk{m_cache_mtx};
+  CacheJobInfo(job_idx, generations, job_info);
+  return job_info;
+}
+
+JobManagerInfo AutomationClientStack::AutomationClientStackImpl::GetAllJobInfos(
+  const std::vector<sup::dto::uint32>& job_indices)
+{
+  auto generations = m_auto_protocol_client.GetJobGenerations();
+  auto n_jobs = static_cast<sup::dto::uint32>(generations.size());
+  auto requested_indices = job_indices;
+  if (requested_indices.empty())
+  {
+    // Removed jobs have an unknown generation and are left out when all jobs are requested. When
+    // all generations are unknown, nothing can be taken from the cache anyway:
+    for (sup::dto::uint32 job_idx = 0; job_idx < n_jobs; ++job_idx)
+    {
+      if (generations[job_idx] != 0)
+      {
+        requested_indices.push_back(job_idx);
+      }
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lk{m_cache_mtx};
+    if (m_server_prefix_cached && !requested_indices.empty())
+    {
+      JobManagerInfo result{ m_server_prefix, n_jobs, {}, requested_indices };
+      for (auto job_idx : requested_indices)
+      {
+        auto cached_job_info = GetCachedJobInfo(job_idx, generations);
+        if (cached_job_info == nullptr)
+        {
+          break;
+        }
+        result.m_job_infos.push_back(*cached_job_info);
+      }
+      if (result.m_job_infos.size() == requested_indices.size())
+      {
+        return result;
+      }
+    }
+  }
+  auto result = m_auto_protocol_client.GetAllJobInfos(job_indices);
+  std::lock_guard<std::mutex> lk{m_cache_mtx};
+  m_server_prefix = result.m_server_prefix;
+  m_server_prefix_cached = true;
+  if (result.m_n_jobs == n_jobs)
+  {
+    for (std::size_t idx = 0; idx < result.m_job_indices.size(); ++idx)
+    {
+      CacheJobInfo(result.m_job_indices[idx], generations, result.m_job_infos[idx]);
+    }
+  }
+  return result;
+}
+
+const sup::oac_tree::JobInfo* AutomationClientStack::AutomationClientStackImpl::GetCachedJobInfo(
+  sup::dto::uint32 job_idx, const std::vector<sup::dto::uint64>& generations) const
+{
+  if (job_idx >= generations.size())
+  {
+    return nullptr;
+  }
+  auto iter = m_job_info_cache.find(job_idx);
+  if (iter == m_job_info_cache.end() || iter->second.first != generations[job_idx])
+  {
+    return nullptr;
+  }
+  return &iter->second.second;
+}
+
+void AutomationClientStack::AutomationClientStackImpl::CacheJobInfo(
+  sup::dto::uint32 job_idx, const std::vector<sup::dto::uint64>& generations,
+  const sup::oac_tree::JobInfo& job_info)
+{
+  // A generation of zero is unknown and cannot be used to validate the cached value later:
+  if (job_idx >= generations.size() || generations[job_idx] == 0)
+  {
+    (void)m_job_info_cache.erase(job_idx);
+    return;
+  }
+  (void)m_job_info_cache.insert_or_assign(job_idx, std::make_pair(generations[job_idx], job_info));
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -24,6 +24,7 @@
 
 #include <sup/oac-tree-server/exceptions.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/output_entry_helper.h>
 
 #include <sup/protocol/function_protocol.h>
 #include <sup/protocol/function_protocol_extract.h>
@@ -119,6 +120,128 @@ sup::oac_tree::JobInfo AutomationProtocolClient::GetJobInfo(sup::dto::uint32 job
   }
 }
 
+JobManagerInfo AutomationProtocolClient::GetAllJobInfos(
+  const std::vector<sup::dto::uint32>& job_indices) const
+{
+  auto input = sup::protocol::FunctionProtocolInput(kGetAllJobInfosFunctionName);
+  if (!job_indices.empty())
+  {
+    sup::protocol::FunctionProtocolPack(input, kJobIndicesFieldName, EncodeJobIndices(job_indices));
+  }
+  sup::dto::AnyValue output;
+  auto protocol_result = m_info_protocol.Invoke(input, output);
+  if (protocol_result == NotSupported)
+  {
+    // Servers supporting protocol versions before 1.4 require a request per job:
+    return GetJobInfosSeparately(job_indices);
+  }
+  if (protocol_result != sup::protocol::Success)
+  {
+    const std::string error = "AutomationProtocolClient::GetAllJobInfos(): protocol did not "
+      "return success: " + AutomationServerResultToString(protocol_result);
+    throw InvalidOperationException(error);
+  }
+  JobManagerInfo result{};
+  sup::dto::AnyValue n_jobs_av;
+  sup::dto::AnyValue job_infos_av;
+  sup::dto::AnyValue job_indices_av;
+  if (!sup::protocol::FunctionProtocolExtract(result.m_server_prefix, output,
+                                              kServerPrefixFieldName)
+      || !sup::protocol::FunctionProtocolExtract(n_jobs_av, output, kNumberOfJobsFieldName)
+      || n_jobs_av.GetType() != sup::dto::UnsignedInteger64Type
+      || !sup::protocol::FunctionProtocolExtract(job_infos_av, output, kJobInfosFieldName)
+      || !sup::protocol::FunctionProtocolExtract(job_indices_av, output, kJobIndicesFieldName))
+  {
+    const std::string error = "AutomationProtocolClient::GetAllJobInfos(): could not extract "
+      "job information from server reply";
+    throw InvalidOperationException(error);
+  }
+  result.m_n_jobs = n_jobs_av.As<sup::dto::uint32>();
+  auto [decoded, job_infos] = DecodeJobInfos(job_infos_av);
+  if (!decoded)
+  {
+    const std::string error = "AutomationProtocolClient::GetAllJobInfos(): could not convert "
+      "received AnyValue to JobInfo objects";
+    throw InvalidOperationException(error);
+  }
+  auto [indices_decoded, job_indices_reply] = DecodeJobIndices(job_indices_av);
+  if (!indices_decoded || job_indices_reply.size() != job_infos.size())
+  {
+    const std::string error = "AutomationProtocolClient::GetAllJobInfos(): could not convert "
+      "received AnyValue to a job index for each JobInfo object";
+    throw InvalidOperationException(error);
+  }
+  result.m_job_infos = std::move(job_infos);
+  result.m_job_indices = std::move(job_indices_reply);
+  return result;
+}
+
+std::vector<sup::dto::uint64> AutomationProtocolClient::GetJobGenerations() const
+{
+  auto input = sup::protocol::FunctionProtocolInput(kGetJobGenerationsFunctionName);
+  sup::dto::AnyValue output;
+  auto protocol_result = m_info_protocol.Invoke(input, output);
+  if (protocol_result == NotSupported)
+  {
+    // Servers supporting protocol versions before 1.5 do not issue generations:
+    return {};
+  }
+  if (protocol_result != sup::protocol::Success)
+  {
+    const std::string error = "AutomationProtocolClient::GetJobGenerations(): protocol did not "
+      "return success: " + AutomationServerResultToString(protocol_result);
+    throw InvalidOperationException(error);
+  }
+  sup::dto::AnyValue generations_av;
+  if (!sup::protocol::FunctionProtocolExtract(generations_av, output, kJobGenerationsFieldName))
+  {
+    const std::string error = "AutomationProtocolClient::GetJobGenerations(): could not extract "
+      "job generations from server reply";
+    throw InvalidOperationException(error);
+  }
+  auto [decoded, generations] = DecodeJobGenerations(generations_av);
+  if (!decoded)
+  {
+    const std::string error = "AutomationProtocolClient::GetJobGenerations(): could not convert "
+      "received AnyValue to job generations";
+    throw InvalidOperationException(error);
+  }
+  return generations;
+}
+
+OutputEntries AutomationProtocolClient::GetOutputEntries(
+  sup::dto::uint32 job_idx, const OutputEntryIndices& last_indices) const
+{
+  auto input = sup::protocol::FunctionProtocolInput(kGetOutputEntriesFunctionName);
+  sup::dto::AnyValue job_idx_av{sup::dto::UnsignedInteger64Type, job_idx};
+  sup::protocol::FunctionProtocolPack(input, kJobIndexFieldName, job_idx_av);
+  sup::protocol::FunctionProtocolPack(input, kOutputEntryIndicesFieldName,
+                                      EncodeOutputEntryIndices(last_indices));
+  sup::dto::AnyValue output;
+  auto protocol_result = m_info_protocol.Invoke(input, output);
+  if (protocol_result != sup::protocol::Success)
+  {
+    const std::string error = "AutomationProtocolClient::GetOutputEntries(): protocol did not "
+      "return success: " + AutomationServerResultToString(protocol_result);
+    throw InvalidOperationException(error);
+  }
+  sup::dto::AnyValue output_entries_av;
+  if (!sup::protocol::FunctionProtocolExtract(output_entries_av, output, kOutputEntriesFieldName))
+  {
+    const std::string error = "AutomationProtocolClient::GetOutputEntries(): could not extract "
+      "output entries from server reply";
+    throw InvalidOperationException(error);
+  }
+  auto [decoded, output_entries] = DecodeOutputEntries(output_entries_av);
+  if (!decoded)
+  {
+    const std::string error = "AutomationProtocolClient::GetOutputEntries(): could not convert "
+      "received AnyValue to output entries";
+    throw InvalidOperationException(error);
+  }
+  return output_entries;
+}
+
 void AutomationProtocolClient::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
                                               bool breakpoint_active)
 {
@@ -138,6 +261,35 @@ void AutomationProtocolClient::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto
   }
 }
 
+void AutomationProtocolClient::EditBreakpoints(sup::dto::uint32 job_idx,
+                                               const std::set<sup::dto::uint32>& instr_indices,
+                                               bool breakpoint_active)
+{
+  auto input = sup::protocol::FunctionProtocolInput(kEditBreakpointsCommandFunctionName);
+  sup::dto::AnyValue job_idx_av{sup::dto::UnsignedInteger64Type, job_idx};
+  sup::protocol::FunctionProtocolPack(input, kJobIndexFieldName, job_idx_av);
+  sup::protocol::FunctionProtocolPack(input, kInstructionIndicesFieldName,
+                                      EncodeInstructionIndices(instr_indices));
+  sup::protocol::FunctionProtocolPack(input, kBreakpointActiveFieldName, breakpoint_active);
+  sup::dto::AnyValue output;
+  auto protocol_result = m_control_protocol.Invoke(input, output);
+  if (protocol_result == NotSupported)
+  {
+    // Servers supporting control protocol version 1.0 require a request per breakpoint:
+    for (auto instr_idx : instr_indices)
+    {
+      EditBreakpoint(job_idx, instr_idx, breakpoint_active);
+    }
+    return;
+  }
+  if (protocol_result != sup::protocol::Success)
+  {
+    const std::string error = "AutomationProtocolClient::EditBreakpoints(): protocol did not "
+      "return success: " + AutomationServerResultToString(protocol_result);
+    throw InvalidOperationException(error);
+  }
+}
+
 void AutomationProtocolClient::SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command)
 {
   auto input = sup::protocol::FunctionProtocolInput(kSendJobCommandFunctionName);
@@ -156,6 +308,96 @@ void AutomationProtocolClient::SendJobCommand(sup::dto::uint32 job_idx, sup::oac
   }
 }
 
+std::vector<bool> AutomationProtocolClient::SendJobCommands(
+  const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command)
+{
+  auto input = sup::protocol::FunctionProtocolInput(kSendJobCommandsFunctionName);
+  if (!job_indices.empty())
+  {
+    sup::protocol::FunctionProtocolPack(input, kJobIndicesFieldName, EncodeJobIndices(job_indices));
+  }
+  auto command_int = static_cast<sup::dto::uint32>(command);
+  sup::dto::AnyValue command_av{sup::dto::UnsignedInteger32Type, command_int};
+  sup::protocol::FunctionProtocolPack(input, kJobCommandFieldName, command_av);
+  sup::dto::AnyValue output;
+  auto protocol_result = m_control_protocol.Invoke(input, output);
+  if (protocol_result == NotSupported)
+  {
+    // Servers supporting control protocol versions before 1.2 require a request per job:
+    return SendJobCommandsSeparately(job_indices, command);
+  }
+  if (protocol_result != sup::protocol::Success)
+  {
+    const std::string error = "AutomationProtocolClient::SendJobCommands(): protocol did not "
+      "return success: " + AutomationServerResultToString(protocol_result);
+    throw InvalidOperationException(error);
+  }
+  sup::dto::AnyValue results_av;
+  if (!sup::protocol::FunctionProtocolExtract(results_av, output, kJobCommandResultsFieldName))
+  {
+    const std::string error = "AutomationProtocolClient::SendJobCommands(): could not extract "
+      "command results from server reply";
+    throw InvalidOperationException(error);
+  }
+  auto [decoded, results] = DecodeJobCommandResults(results_av);
+  if (!decoded)
+  {
+    const std::string error = "AutomationProtocolClient::SendJobCommands(): could not convert "
+      "received AnyValue to command results";
+    throw InvalidOperationException(error);
+  }
+  return results;
+}
+
+JobManagerInfo AutomationProtocolClient::GetJobInfosSeparately(
+  const std::vector<sup::dto::uint32>& job_indices) const
+{
+  JobManagerInfo result{ GetServerPrefix(), GetNumberOfJobs(), {}, {} };
+  if (job_indices.empty())
+  {
+    for (sup::dto::uint32 job_idx = 0; job_idx < result.m_n_jobs; ++job_idx)
+    {
+      result.m_job_infos.push_back(GetJobInfo(job_idx));
+      result.m_job_indices.push_back(job_idx);
+    }
+    return result;
+  }
+  for (auto job_idx : job_indices)
+  {
+    result.m_job_infos.push_back(GetJobInfo(job_idx));
+  }
+  result.m_job_indices = job_indices;
+  return result;
+}
+
+std::vector<bool> AutomationProtocolClient::SendJobCommandsSeparately(
+  const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command)
+{
+  auto indices = job_indices;
+  if (indices.empty())
+  {
+    auto n_jobs = GetNumberOfJobs();
+    for (sup::dto::uint32 job_idx = 0; job_idx < n_jobs; ++job_idx)
+    {
+      indices.push_back(job_idx);
+    }
+  }
+  std::vector<bool> result{};
+  for (auto job_idx : indices)
+  {
+    try
+    {
+      SendJobCommand(job_idx, command);
+      result.push_back(true);
+    }
+    catch(const InvalidOperationException&)
+    {
+      result.push_back(false);
+    }
+  }
+  return result;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -29,33 +29,199 @@
 #include <sup/oac-tree/procedure.h>
 #include <sup/oac-tree/workspace.h>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <thread>
+
+namespace
+{
+sup::dto::uint64 InitialJobGeneration();
+}  // unnamed namespace
+
 namespace sup
 {
 namespace oac_tree_server
 {
-using sup::oac_tree::LocalJob;
-
 AutomationServer::AutomationServer(const std::string& server_prefix,
                                    IAnyValueManagerRegistry& av_mgr_registry)
+  : AutomationServer{server_prefix, av_mgr_registry, ServerJobInfoIOConfig{}}
+{}
+
+AutomationServer::AutomationServer(const std::string& server_prefix,
+                                   IAnyValueManagerRegistry& av_mgr_registry,
+                                   const ServerJobInfoIOConfig& job_info_io_config)
+  : AutomationServer{server_prefix, av_mgr_registry, job_info_io_config, ServerJobConfig{}}
+{}
+
+AutomationServer::AutomationServer(const std::string& server_prefix,
+                                   IAnyValueManagerRegistry& av_mgr_registry,
+                                   const ServerJobInfoIOConfig& job_info_io_config,
+                                   const ServerJobConfig& server_job_config)
   : m_server_prefix{server_prefix}
   , m_av_mgr_registry{av_mgr_registry}
-  , m_job_info_ios{}
+  , m_job_info_io_config{job_info_io_config}
+  , m_server_job_config{server_job_config}
   , m_jobs{}
-  , m_mtx{}
-{}
+  , m_next_generation{InitialJobGeneration()}
+  , m_edit_mtx{}
+  , m_halt_cleanup{false}
+  , m_cleanup_mtx{}
+  , m_cleanup_cv{}
+  , m_cleanup_future{}
+{
+  if (m_server_job_config.m_lazy_instantiation && m_server_job_config.m_idle_timeout_ms > 0)
+  {
+    m_cleanup_future = std::async(std::launch::async, &AutomationServer::IdleCleanupLoop, this);
+  }
+}
+
+AutomationServer::~AutomationServer()
+{
+  if (m_cleanup_future.valid())
+  {
+    {
+      std::lock_guard<std::mutex> lk{m_cleanup_mtx};
+      m_halt_cleanup = true;
+    }
+    m_cleanup_cv.notify_one();
+    m_cleanup_future.get();
+  }
+}
+
+sup::dto::uint32 AutomationServer::AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc)
+{
+  return AddJob(std::move(proc), ProcedureFactory{});
+}
+
+sup::dto::uint32 AutomationServer::AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc,
+                                          const ProcedureFactory& factory)
+{
+  std::lock_guard<std::mutex> edit_lk{m_edit_mtx};
+  // Only edits append to the table of jobs, so the index remains free while creating the job:
+  auto idx = GetNumberOfJobs();
+  auto job = CreateJob(idx, std::move(proc), factory, m_server_job_config.m_lazy_instantiation);
+  return m_jobs.Append(std::move(job));
+}
+
+std::vector<sup::dto::uint32> AutomationServer::AddJobs(
+  std::vector<std::unique_ptr<sup::oac_tree::Procedure>> procs,
+  const std::vector<ProcedureFactory>& factories)
+{
+  if (factories.size() != procs.size())
+  {
+    const std::string error = "AutomationServer::AddJobs(): number of factories ["
+      + std::to_string(factories.size()) + "] does not match number of procedures ["
+      + std::to_string(procs.size()) + "]";
+    throw InvalidOperationException(error);
+  }
+  std::lock_guard<std::mutex> edit_lk{m_edit_mtx};
+  // Only edits append to the table of jobs, so the indices remain free while creating the jobs:
+  auto first_idx = GetNumberOfJobs();
+  std::vector<std::shared_ptr<ServerJob>> jobs(procs.size());
+  std::vector<std::exception_ptr> errors(procs.size());
+  std::atomic<std::size_t> next_idx{0};
+  auto create_func = [this, first_idx, &procs, &factories, &jobs, &errors, &next_idx]() {
+    for (auto idx = next_idx++; idx < procs.size(); idx = next_idx++)
+    {
+      try
+      {
+        auto job_idx = static_cast<sup::dto::uint32>(first_idx + idx);
+        jobs[idx] = CreateJob(job_idx, std::move(procs[idx]), factories[idx],
+                              m_server_job_config.m_lazy_instantiation);
+      }
+      catch(...)
+      {
+        errors[idx] = std::current_exception();
+      }
+    }
+  };
+  auto n_threads = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                         procs.size());
+  std::vector<std::future<void>> workers{};
+  for (std::size_t i = 0; i < n_threads; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, create_func));
+  }
+  for (auto& worker : workers)
+  {
+    worker.get();
+  }
+  for (const auto& error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+  std::vector<sup::dto::uint32> result;
+  for (auto& job : jobs)
+  {
+    result.push_back(m_jobs.Append(std::move(job)));
+  }
+  return result;
+}
 
-AutomationServer::~AutomationServer() = default;
+void AutomationServer::ReplaceJob(sup::dto::uint32 job_idx,
+                                  std::unique_ptr<sup::oac_tree::Procedure> proc)
+{
+  ReplaceJob(job_idx, std::move(proc), ProcedureFactory{});
+}
 
-void AutomationServer::AddJob(std::unique_ptr<sup::oac_tree::Procedure> proc)
+void AutomationServer::ReplaceJob(sup::dto::uint32 job_idx,
+                                  std::unique_ptr<sup::oac_tree::Procedure> proc,
+                                  const ProcedureFactory& factory)
 {
-  std::lock_guard<std::mutex> lk{m_mtx};
-  auto idx = static_cast<dto::uint32>(m_jobs.size());
-  auto job_prefix = CreateJobPrefix(m_server_prefix, idx);
-  auto n_vars = GetNumberOfVariables(*proc);
-  auto job_info_io = std::make_unique<ServerJobInfoIO>(job_prefix, n_vars,
-                                                       m_av_mgr_registry.GetAnyValueManager(idx));
-  (void)m_job_info_ios.emplace_back(std::move(job_info_io));
-  (void)m_jobs.emplace_back(std::move(proc), *m_job_info_ios.back());
+  std::lock_guard<std::mutex> edit_lk{m_edit_mtx};
+  auto old_job = GetJob(job_idx);
+  // The new job can only publish its values after the old job released them, so it is only set
+  // up before the old job is torn down. Failures up to here leave the old job untouched:
+  auto job = CreateJob(job_idx, std::move(proc), factory, true);
+  if (!m_server_job_config.m_lazy_instantiation)
+  {
+    job->Prepare();
+  }
+  // Values that could not be released make the instantiation of the new job fail, see below:
+  (void)old_job->TearDown();
+  (void)m_jobs.Exchange(job_idx, job);
+  if (!m_server_job_config.m_lazy_instantiation)
+  {
+    try
+    {
+      job->Instantiate();
+    }
+    catch (const InvalidOperationException&)
+    {
+      // Only publishing the names that the old job just released can fail here. The replacement
+      // took effect, so the error is left to the next request for the job, which retries it.
+    }
+  }
+}
+
+void AutomationServer::RemoveJob(sup::dto::uint32 job_idx)
+{
+  std::lock_guard<std::mutex> edit_lk{m_edit_mtx};
+  RemoveJobImpl(job_idx);
+}
+
+sup::dto::uint32 AutomationServer::TearDownIdleJobs()
+{
+  if (!m_server_job_config.m_lazy_instantiation)
+  {
+    return 0;
+  }
+  auto jobs = m_jobs.GetAll();
+  const auto idle_timeout = std::chrono::milliseconds(m_server_job_config.m_idle_timeout_ms);
+  sup::dto::uint32 n_torn_down = 0;
+  for (const auto& job : jobs)
+  {
+    if (job && job->TearDownIfIdle(idle_timeout))
+    {
+      ++n_torn_down;
+    }
+  }
+  return n_torn_down;
 }
 
 std::string AutomationServer::GetServerPrefix() const
@@ -65,77 +231,152 @@ std::string AutomationServer::GetServerPrefix() const
 
 sup::dto::uint32 AutomationServer::GetNumberOfJobs() const
 {
-  std::lock_guard<std::mutex> lk{m_mtx};
-  auto n_jobs = static_cast<dto::uint32>(m_jobs.size());
-  return n_jobs;
+  return m_jobs.GetSize();
 }
 
 sup::oac_tree::JobInfo AutomationServer::GetJobInfo(sup::dto::uint32 job_idx) const
 {
-  auto& job = GetJob(job_idx);
-  return job.GetInfo();
+  auto job = GetJob(job_idx);
+  return job->GetInfo();
 }
 
-void AutomationServer::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
-                                      bool breakpoint_active)
+sup::dto::uint32 AutomationServer::GetNumberOfInstructions(sup::dto::uint32 job_idx) const
 {
-  auto& job = GetJob(job_idx);
-  if (breakpoint_active)
+  auto job = GetJob(job_idx);
+  return job->GetNumberOfInstructions();
+}
+
+JobManagerInfo AutomationServer::GetAllJobInfos(
+  const std::vector<sup::dto::uint32>& job_indices) const
+{
+  JobManagerInfo result{ m_server_prefix, GetNumberOfJobs(), {}, {} };
+  if (job_indices.empty())
   {
-    job.SetBreakpoint(instr_idx);
+    auto jobs = m_jobs.GetAll();
+    result.m_n_jobs = static_cast<sup::dto::uint32>(jobs.size());
+    for (sup::dto::uint32 job_idx = 0; job_idx < result.m_n_jobs; ++job_idx)
+    {
+      // Removed jobs are left out:
+      if (jobs[job_idx])
+      {
+        result.m_job_infos.push_back(jobs[job_idx]->GetInfo());
+        result.m_job_indices.push_back(job_idx);
+      }
+    }
+    return result;
   }
-  else
+  for (auto job_idx : job_indices)
   {
-    job.RemoveBreakpoint(instr_idx);
+    result.m_job_infos.push_back(GetJobInfo(job_idx));
   }
-  return;
+  result.m_job_indices = job_indices;
+  return result;
 }
 
-void AutomationServer::SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command)
+std::vector<sup::dto::uint64> AutomationServer::GetJobGenerations() const
 {
-  using sup::oac_tree::JobCommand;
-  auto& job = GetJob(job_idx);
-  switch (command)
-  {
-  case JobCommand::kStart:
-    job.Start();
-    break;
-  case JobCommand::kStep:
-    job.Step();
-    break;
-  case JobCommand::kPause:
-    job.Pause();
-    break;
-  case JobCommand::kReset:
-    job.Reset();
-    break;
-  case JobCommand::kHalt:
-    job.Halt();
-    break;
-  default:
-    {
-      const std::string error = "AutomationServer::GetJobInfo(): unknown command enumerator ["
-        + std::to_string(static_cast<int>(command)) + "]";
-      throw InvalidOperationException(error);
-    }
+  std::vector<sup::dto::uint64> result;
+  for (const auto& job : m_jobs.GetAll())
+  {
+    // Removed jobs have an unknown generation:
+    result.push_back(job ? job->GetGeneration() : 0u);
   }
+  return result;
 }
 
-LocalJob& AutomationServer::GetJob(sup::dto::uint32 job_idx)
+OutputEntries AutomationServer::GetOutputEntries(sup::dto::uint32 job_idx,
+                                                const OutputEntryIndices& last_indices) const
 {
-  return const_cast<LocalJob&>(const_cast<const AutomationServer*>(this)->GetJob(job_idx));
+  auto job = GetJob(job_idx);
+  return job->GetOutputEntries(last_indices);
 }
 
-const LocalJob& AutomationServer::GetJob(sup::dto::uint32 job_idx) const
+void AutomationServer::EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
+                                      bool breakpoint_active)
 {
-  std::lock_guard<std::mutex> lk{m_mtx};
-  if (job_idx >= m_jobs.size())
+  auto job = GetJob(job_idx);
+  job->EditBreakpoints({ instr_idx }, breakpoint_active);
+}
+
+void AutomationServer::EditBreakpoints(sup::dto::uint32 job_idx,
+                                       const std::set<sup::dto::uint32>& instr_indices,
+                                       bool breakpoint_active)
+{
+  auto job = GetJob(job_idx);
+  auto n_instr = job->GetNumberOfInstructions();
+  if (!instr_indices.empty() && *instr_indices.rbegin() >= n_instr)
+  {
+    const std::string error = "AutomationServer::EditBreakpoints(): instruction index out of "
+      "bounds; requesting " + std::to_string(*instr_indices.rbegin()) + " out of "
+      + std::to_string(n_instr);
+    throw InvalidOperationException(error);
+  }
+  job->EditBreakpoints(instr_indices, breakpoint_active);
+}
+
+void AutomationServer::SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command)
+{
+  auto job = GetJob(job_idx);
+  job->SendJobCommand(command);
+}
+
+bool AutomationServer::SupportsConcurrentCalls() const
+{
+  return true;
+}
+
+std::shared_ptr<ServerJob> AutomationServer::GetJob(sup::dto::uint32 job_idx) const
+{
+  auto n_jobs = GetNumberOfJobs();
+  if (job_idx >= n_jobs)
   {
     const std::string error = "AutomationServer::GetJob(): index out of bounds; requesting"
-      + std::to_string(job_idx) + " out of " + std::to_string(m_jobs.size()) + " jobs";
+      + std::to_string(job_idx) + " out of " + std::to_string(n_jobs) + " jobs";
     throw InvalidOperationException(error);
   }
-  return m_jobs[job_idx];
+  auto job = m_jobs.Get(job_idx);
+  if (!job)
+  {
+    const std::string error = "AutomationServer::GetJob(): job with index "
+      + std::to_string(job_idx) + " was removed";
+    throw InvalidOperationException(error);
+  }
+  return job;
+}
+
+std::shared_ptr<ServerJob> AutomationServer::CreateJob(
+  sup::dto::uint32 job_idx, std::unique_ptr<sup::oac_tree::Procedure> proc,
+  const ProcedureFactory& factory, bool lazy)
+{
+  auto job_prefix = CreateJobPrefix(m_server_prefix, job_idx);
+  return std::make_shared<ServerJob>(job_prefix, m_av_mgr_registry.GetAnyValueManager(job_idx),
+                                     m_job_info_io_config, std::move(proc), factory, lazy,
+                                     m_next_generation);
+}
+
+void AutomationServer::RemoveJobImpl(sup::dto::uint32 job_idx)
+{
+  auto job = GetJob(job_idx);
+  (void)m_jobs.Exchange(job_idx, {});
+  // Release the published values, so they can be added again by a replacing job:
+  if (!job->TearDown())
+  {
+    const std::string error = "AutomationServer::RemoveJob(): job with index "
+      + std::to_string(job_idx) + " was removed, but not all its published values were released";
+    throw InvalidOperationException(error);
+  }
+}
+
+void AutomationServer::IdleCleanupLoop()
+{
+  const auto period = std::chrono::milliseconds(m_server_job_config.m_idle_timeout_ms);
+  std::unique_lock<std::mutex> lk{m_cleanup_mtx};
+  while (!m_cleanup_cv.wait_for(lk, period, [this]{ return m_halt_cleanup; }))
+  {
+    lk.unlock();
+    (void)TearDownIdleJobs();
+    lk.lock();
+  }
 }
 
 sup::dto::uint32 GetNumberOfVariables(const sup::oac_tree::Procedure& proc)
@@ -149,3 +390,15 @@ sup::dto::uint32 GetNumberOfVariables(const sup::oac_tree::Procedure& proc)
 }  // namespace oac_tree_server
 
 }  // namespace sup
+
+namespace
+{
+sup::dto::uint64 InitialJobGeneration()
+{
+  // Start from the current time, so generations are not reused when a server is restarted:
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+  return static_cast<sup::dto::uint64>(micros) + 1u;
+}
+
+}  // unnamed namespace
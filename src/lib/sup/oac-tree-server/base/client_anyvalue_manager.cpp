@@ -24,20 +24,38 @@
 
 #include <sup/oac-tree-server/output_entry_helper.h>
 #include <sup/oac-tree-server/output_entry_types.h>
+#include <sup/oac-tree-server/variable_delta_codec.h>
 
 #include <sup/oac-tree/anyvalue_utils.h>
 #include <sup/oac-tree/user_input_reply.h>
 
+#include <memory>
+#include <mutex>
+#include <utility>
+
 namespace
 {
 using namespace sup::oac_tree_server;
 using sup::oac_tree::IJobInfoIO;
 
+// Decoder shared between the channel of a variable and its keyframe channel, whose updates may
+// arrive on different threads:
+struct SharedVariableDecoder
+{
+  std::mutex m_mtx;
+  VariableDeltaDecoder m_decoder;
+};
+
+std::pair<ClientAnyValueManager::AnyValueCallback, ClientAnyValueManager::AnyValueCallback>
+CreateVariableCallbacks(sup::dto::uint32 var_idx);
+
 void UpdateJobState(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue);
 void UpdateInstructionState(IJobInfoIO& job_info_io, sup::dto::uint32 instr_idx,
                             const sup::dto::AnyValue& anyvalue);
 void UpdateVariableState(IJobInfoIO& job_info_io, sup::dto::uint32 var_idx,
-                        const sup::dto::AnyValue& anyvalue);
+                         SharedVariableDecoder& decoder, const sup::dto::AnyValue& anyvalue);
+void UpdateVariableKeyframe(IJobInfoIO& job_info_io, sup::dto::uint32 var_idx,
+                            SharedVariableDecoder& decoder, const sup::dto::AnyValue& anyvalue);
 void UpdateLogEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue);
 void UpdateMessageEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue);
 void UpdateOutputValueEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue);
@@ -72,6 +90,15 @@ bool ClientAnyValueManager::AddAnyValues(const NameAnyValueSet& name_value_set)
     {
       ++n_instr;
     }
+    if (value_name_info.val_type == ValueNameType::kVariable)
+    {
+      // Keyframes of delta encoded variable updates are published on a separate channel:
+      auto [var_cb, keyframe_cb] = CreateVariableCallbacks(value_name_info.idx);
+      var_cb(m_job_info_io, value);
+      m_cb_map[name] = var_cb;
+      m_cb_map[GetVariableKeyframePVName(name)] = keyframe_cb;
+      continue;
+    }
     auto cb = CreateCallback(value_name_info);
     cb(m_job_info_io, value);
     m_cb_map[name] = cb;
@@ -155,12 +182,7 @@ ClientAnyValueManager::AnyValueCallback CreateCallback(const ValueNameInfo& valu
       return callback;
     }
   case ValueNameType::kVariable:
-    {
-      auto callback = [idx](IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue) {
-        return UpdateVariableState(job_info_io, idx, anyvalue);
-      };
-      return callback;
-    }
+    return CreateVariableCallbacks(idx).first;
   case ValueNameType::kLogEntry:
     return UpdateLogEntry;
   case ValueNameType::kMessageEntry:
@@ -188,6 +210,22 @@ ClientAnyValueManager::AnyValueCallback CreateCallback(const ValueNameInfo& valu
 
 namespace
 {
+std::pair<ClientAnyValueManager::AnyValueCallback, ClientAnyValueManager::AnyValueCallback>
+CreateVariableCallbacks(sup::dto::uint32 var_idx)
+{
+  // Decoding delta encoded updates requires the last received keyframe:
+  auto decoder = std::make_shared<SharedVariableDecoder>();
+  auto var_callback = [var_idx, decoder](IJobInfoIO& job_info_io,
+                                         const sup::dto::AnyValue& anyvalue) {
+    return UpdateVariableState(job_info_io, var_idx, *decoder, anyvalue);
+  };
+  auto keyframe_callback = [var_idx, decoder](IJobInfoIO& job_info_io,
+                                              const sup::dto::AnyValue& anyvalue) {
+    return UpdateVariableKeyframe(job_info_io, var_idx, *decoder, anyvalue);
+  };
+  return { var_callback, keyframe_callback };
+}
+
 void UpdateJobState(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue)
 {
   if (!sup::oac_tree::utils::ValidateMemberType(anyvalue, kJobStateField,
@@ -216,9 +254,22 @@ void UpdateInstructionState(IJobInfoIO& job_info_io, sup::dto::uint32 instr_idx,
 }
 
 void UpdateVariableState(IJobInfoIO& job_info_io, sup::dto::uint32 var_idx,
-                        const sup::dto::AnyValue& anyvalue)
+                         SharedVariableDecoder& decoder, const sup::dto::AnyValue& anyvalue)
+{
+  std::lock_guard<std::mutex> lk{decoder.m_mtx};
+  auto [value, state] = decoder.m_decoder.Decode(anyvalue);
+  if (sup::dto::IsEmptyValue(value))
+  {
+    return;
+  }
+  job_info_io.VariableUpdated(var_idx, value, state);
+}
+
+void UpdateVariableKeyframe(IJobInfoIO& job_info_io, sup::dto::uint32 var_idx,
+                            SharedVariableDecoder& decoder, const sup::dto::AnyValue& anyvalue)
 {
-  auto [value, state] = DecodeVariableState(anyvalue);
+  std::lock_guard<std::mutex> lk{decoder.m_mtx};
+  auto [value, state] = decoder.m_decoder.DecodeKeyframe(anyvalue);
   if (sup::dto::IsEmptyValue(value))
   {
     return;
@@ -228,6 +279,15 @@ void UpdateVariableState(IJobInfoIO& job_info_io, sup::dto::uint32 var_idx,
 
 void UpdateLogEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue)
 {
+  if (IsEntryBatch(anyvalue))
+  {
+    auto [valid, log_entries] = DecodeLogEntryBatch(anyvalue);
+    for (const auto& log_entry : log_entries)
+    {
+      job_info_io.Log(log_entry.m_severity, log_entry.m_message);
+    }
+    return;
+  }
   auto [valid, log_entry] = DecodeLogEntry(anyvalue);
   if (valid)
   {
@@ -237,6 +297,15 @@ void UpdateLogEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue)
 
 void UpdateMessageEntry(IJobInfoIO& job_info_io, const sup::dto::AnyValue& anyvalue)
 {
+  if (IsEntryBatch(anyvalue))
+  {
+    auto [valid, msg_entries] = DecodeMessageEntryBatch(anyvalue);
+    for (const auto& msg_entry : msg_entries)
+    {
+      job_info_io.Message(msg_entry.m_message);
+    }
+    return;
+  }
   auto [valid, msg_entry] = DecodeMessageEntry(anyvalue);
   if (valid)
   {
@@ -132,6 +132,20 @@ void ClientJob::Halt()
   job_manager.SendJobCommand(job_idx, JobCommand::kHalt);
 }
 
+void ClientJob::SetBreakpoints(const std::set<sup::dto::uint32>& instr_indices)
+{
+  auto& job_manager = m_impl->GetJobManager();
+  auto job_idx = m_impl->GetJobIndex();
+  job_manager.EditBreakpoints(job_idx, instr_indices, true);
+}
+
+void ClientJob::RemoveBreakpoints(const std::set<sup::dto::uint32>& instr_indices)
+{
+  auto& job_manager = m_impl->GetJobManager();
+  auto job_idx = m_impl->GetJobIndex();
+  job_manager.EditBreakpoints(job_idx, instr_indices, false);
+}
+
 std::unique_ptr<sup::oac_tree::IJob> CreateClientJob(
     IJobManager &job_manager, sup::dto::uint32 job_idx,
     const AnyValueIOFactoryFunction &factory_func, sup::oac_tree::IJobInfoIO &job_info_io)
@@ -157,18 +171,19 @@ ClientJobImpl::ClientJobImpl(IJobManager& job_manager, sup::dto::uint32 job_idx,
   , m_anyvalue_io{factory_func(m_av_mgr)}
   , m_job_info{}
 {
-  auto n_jobs = m_job_manager.GetNumberOfJobs();
-  if (job_idx >= n_jobs)
+  // Retrieve all static information in a single request:
+  auto job_manager_info = m_job_manager.GetAllJobInfos({ job_idx });
+  auto n_jobs = job_manager_info.m_n_jobs;
+  if (job_idx >= n_jobs || job_manager_info.m_job_infos.size() != 1)
   {
     const std::string error = "ClientJob ctor: trying to create job with index ["
       + std::to_string(job_idx) + "] out of [" + std::to_string(n_jobs) + "] jobs";
     throw InvalidOperationException(error);
   }
-  auto server_prefix = m_job_manager.GetServerPrefix();
-  auto job_prefix = CreateJobPrefix(server_prefix, job_idx);
-  m_job_info = std::make_unique<sup::oac_tree::JobInfo>(m_job_manager.GetJobInfo(job_idx));
-  InitializeJobAndVariables(*m_anyvalue_io, job_prefix, m_job_info->GetNumberOfVariables());
-  InitializeInstructions(*m_anyvalue_io, job_prefix, m_job_info->GetNumberOfInstructions());
+  auto job_prefix = CreateJobPrefix(job_manager_info.m_server_prefix, job_idx);
+  m_job_info = std::make_unique<sup::oac_tree::JobInfo>(job_manager_info.m_job_infos.front());
+  (void)InitializeJobAndVariables(*m_anyvalue_io, job_prefix, m_job_info->GetNumberOfVariables());
+  (void)InitializeInstructions(*m_anyvalue_io, job_prefix, m_job_info->GetNumberOfInstructions());
 }
 
 ClientJobImpl::~ClientJobImpl() = default;
@@ -30,20 +30,29 @@ namespace oac_tree_server
 {
 
 ClientReplyDelegator::ClientReplyDelegator(ReplyFunction reply_func, InterruptFunction interrupt_func)
+  : ClientReplyDelegator{reply_func, interrupt_func, GetSharedReplyExecutor()}
+{}
+
+ClientReplyDelegator::ClientReplyDelegator(ReplyFunction reply_func,
+                                           InterruptFunction interrupt_func,
+                                           ReplyExecutor& executor)
   : m_reply_func{reply_func}
   , m_interrupt_func{interrupt_func}
+  , m_executor{executor}
   , m_active_id{0}
   , m_cv{}
   , m_mtx{}
   , m_halt{false}
+  , m_scheduled{false}
   , m_reply_queue{}
-  , m_delegatee{&ClientReplyDelegator::HandleClientReply, this}
 {}
 
 ClientReplyDelegator::~ClientReplyDelegator()
 {
-  Halt();
-  m_delegatee.join();
+  // Wait until a scheduled task finished, since it refers to this object:
+  std::unique_lock<std::mutex> lk{m_mtx};
+  m_halt = true;
+  m_cv.wait(lk, [this]() { return !m_scheduled; });
 }
 
 void ClientReplyDelegator::QueueReply(sup::dto::uint64 id, const UserInputReply& reply)
@@ -51,8 +60,14 @@ void ClientReplyDelegator::QueueReply(sup::dto::uint64 id, const UserInputReply&
   {
     std::lock_guard<std::mutex> lk{m_mtx};
     m_reply_queue.push_back({id, reply});
+    // At most one task per delegator is scheduled, which preserves the order of replies:
+    if (m_scheduled || m_halt)
+    {
+      return;
+    }
+    m_scheduled = true;
   }
-  m_cv.notify_one();
+  m_executor.Post([this]() { HandleClientReply(); });
 }
 
 void ClientReplyDelegator::InterruptAll()
@@ -71,37 +86,28 @@ void ClientReplyDelegator::InterruptAll()
 
 void ClientReplyDelegator::HandleClientReply()
 {
-  auto pred = [this]() {
-    return !m_reply_queue.empty() || m_halt;
-  };
-  while (true)
+  std::unique_lock<std::mutex> lk{m_mtx};
+  if (!m_reply_queue.empty() && !m_halt)
   {
-    std::unique_lock<std::mutex> lk{m_mtx};
-    m_cv.wait(lk, pred);
-    if (!m_reply_queue.empty())
-    {
-      auto reply_info = m_reply_queue.front();
-      m_reply_queue.pop_front();
-      m_active_id = reply_info.id;
-      lk.unlock();
-      m_reply_func(reply_info.id, reply_info.reply);
-      lk.lock();
-      m_active_id = 0;
-    }
-    if (m_halt)
-    {
-      break;
-    }
+    auto reply_info = m_reply_queue.front();
+    m_reply_queue.pop_front();
+    m_active_id = reply_info.id;
+    lk.unlock();
+    m_reply_func(reply_info.id, reply_info.reply);
+    lk.lock();
+    m_active_id = 0;
   }
-}
-
-void ClientReplyDelegator::Halt()
-{
+  // Deliver only one reply per task and post a new task for the next one, so that delegators
+  // with many queued replies do not starve others that share the executor:
+  if (!m_reply_queue.empty() && !m_halt)
   {
-    std::lock_guard<std::mutex> lk{m_mtx};
-    m_halt = true;
+    lk.unlock();
+    m_executor.Post([this]() { HandleClientReply(); });
+    return;
   }
-  m_cv.notify_one();
+  // Notify while holding the lock, since the destructor may run as soon as it is released:
+  m_scheduled = false;
+  m_cv.notify_all();
 }
 
 }  // namespace oac_tree_server
@@ -24,7 +24,9 @@
 
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
+#include <sup/dto/anyvalue_helper.h>
 #include <sup/protocol/function_protocol_extract.h>
+#include <sup/protocol/function_protocol_pack.h>
 #include <sup/protocol/protocol_rpc.h>
 
 namespace
@@ -67,7 +69,9 @@ ControlProtocolServer::FunctionMap()
 {
   static sup::protocol::ProtocolMemberFunctionMap<ControlProtocolServer> f_map = {
     { kEditBreakpointCommandFunctionName, &ControlProtocolServer::EditBreakpoint },
-    { kSendJobCommandFunctionName, &ControlProtocolServer::SendJobCommand }
+    { kEditBreakpointsCommandFunctionName, &ControlProtocolServer::EditBreakpoints },
+    { kSendJobCommandFunctionName, &ControlProtocolServer::SendJobCommand },
+    { kSendJobCommandsFunctionName, &ControlProtocolServer::SendJobCommands }
   };
   return f_map;
 }
@@ -83,7 +87,7 @@ sup::protocol::ProtocolResult ControlProtocolServer::EditBreakpoint(
     return result;
   }
   sup::dto::uint32 instr_idx{};
-  auto number_of_instructions = m_job_manager.GetJobInfo(job_idx).GetNumberOfInstructions();
+  auto number_of_instructions = m_job_manager.GetNumberOfInstructions(job_idx);
   result = ExtractInstructionIndex(input, number_of_instructions, instr_idx);
   if (result != sup::protocol::Success)
   {
@@ -98,6 +102,32 @@ sup::protocol::ProtocolResult ControlProtocolServer::EditBreakpoint(
   return sup::protocol::Success;
 }
 
+sup::protocol::ProtocolResult ControlProtocolServer::EditBreakpoints(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  (void)output;
+  sup::dto::uint32 job_idx{};
+  auto result = ExtractJobIndex(input, m_job_manager.GetNumberOfJobs(), job_idx);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  std::set<sup::dto::uint32> instr_indices{};
+  auto number_of_instructions = m_job_manager.GetNumberOfInstructions(job_idx);
+  result = ExtractInstructionIndices(input, number_of_instructions, instr_indices);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  bool breakpoint_active;
+  if (!sup::protocol::FunctionProtocolExtract(breakpoint_active, input, kBreakpointActiveFieldName))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  m_job_manager.EditBreakpoints(job_idx, instr_indices, breakpoint_active);
+  return sup::protocol::Success;
+}
+
 sup::protocol::ProtocolResult ControlProtocolServer::SendJobCommand(
   const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
 {
@@ -118,6 +148,32 @@ sup::protocol::ProtocolResult ControlProtocolServer::SendJobCommand(
   return sup::protocol::Success;
 }
 
+sup::protocol::ProtocolResult ControlProtocolServer::SendJobCommands(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  std::vector<sup::dto::uint32> job_indices{};
+  auto result = ExtractJobIndices(input, m_job_manager.GetNumberOfJobs(), job_indices);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  sup::oac_tree::JobCommand command{sup::oac_tree::JobCommand::kStart};
+  result = ExtractJobCommand(input, command);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  auto command_results = m_job_manager.SendJobCommands(job_indices, command);
+  sup::dto::AnyValue temp_out;
+  sup::protocol::FunctionProtocolPack(temp_out, kJobCommandResultsFieldName,
+                                      EncodeJobCommandResults(command_results));
+  if (!sup::dto::TryAssignIfEmptyOrConvert(output, temp_out))
+  {
+    return sup::protocol::ServerProtocolEncodingError;
+  }
+  return sup::protocol::Success;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
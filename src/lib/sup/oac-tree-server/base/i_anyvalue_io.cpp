@@ -82,6 +82,18 @@ IAnyValueIO::NameAnyValueSet GetInstructionValueSet(const std::string& job_prefi
   return result;
 }
 
+IAnyValueIO::NameAnyValueSet GetVariableKeyframeValueSet(const std::string& job_prefix,
+                                                         sup::dto::uint32 n_vars)
+{
+  IAnyValueIO::NameAnyValueSet result;
+  for (sup::dto::uint32 var_idx = 0; var_idx < n_vars; ++var_idx)
+  {
+    const auto name = GetVariableKeyframePVName(GetVariablePVName(job_prefix, var_idx));
+    (void)result.emplace_back(name, kVariableAnyValue);
+  }
+  return result;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -29,6 +29,31 @@ namespace oac_tree_server
 
 IAnyValueManager::~IAnyValueManager() = default;
 
+std::pair<UserInputStatus, UserInputReply> IAnyValueManager::GetUserInputUntil(
+  const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+  std::chrono::steady_clock::time_point deadline)
+{
+  (void)deadline;
+  auto reply = GetUserInput(input_server_name, id, request);
+  if (reply.m_request_type == sup::oac_tree::InputRequestType::kInvalid)
+  {
+    return { UserInputStatus::kInterrupted, reply };
+  }
+  return { UserInputStatus::kReplied, reply };
+}
+
+bool IAnyValueManager::RemoveAnyValues(const std::set<std::string>& names)
+{
+  (void)names;
+  return false;
+}
+
+bool IAnyValueManager::RemoveInputHandler(const std::string& input_server_name)
+{
+  (void)input_server_name;
+  return false;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
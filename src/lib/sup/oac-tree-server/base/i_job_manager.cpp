@@ -22,6 +22,21 @@
 
 #include <sup/oac-tree-server/i_job_manager.h>
 
+#include <sup/oac-tree-server/exceptions.h>
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
+
+namespace
+{
+std::vector<bool> SendJobCommandToRange(sup::oac_tree_server::IJobManager& job_manager,
+                                        const std::vector<sup::dto::uint32>& job_indices,
+                                        std::size_t begin, std::size_t end,
+                                        sup::oac_tree::JobCommand command);
+}  // unnamed namespace
+
 namespace sup
 {
 namespace oac_tree_server
@@ -29,6 +44,139 @@ namespace oac_tree_server
 
 IJobManager::~IJobManager() = default;
 
+sup::dto::uint32 IJobManager::GetNumberOfInstructions(sup::dto::uint32 job_idx) const
+{
+  return GetJobInfo(job_idx).GetNumberOfInstructions();
+}
+
+JobManagerInfo IJobManager::GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const
+{
+  JobManagerInfo result{ GetServerPrefix(), GetNumberOfJobs(), {}, {} };
+  if (!job_indices.empty())
+  {
+    for (auto job_idx : job_indices)
+    {
+      result.m_job_infos.push_back(GetJobInfo(job_idx));
+    }
+    result.m_job_indices = job_indices;
+    return result;
+  }
+  for (sup::dto::uint32 job_idx = 0; job_idx < result.m_n_jobs; ++job_idx)
+  {
+    try
+    {
+      result.m_job_infos.push_back(GetJobInfo(job_idx));
+      result.m_job_indices.push_back(job_idx);
+    }
+    catch(const InvalidOperationException&)
+    {
+      // Removed jobs are skipped
+    }
+  }
+  return result;
+}
+
+std::vector<sup::dto::uint64> IJobManager::GetJobGenerations() const
+{
+  return std::vector<sup::dto::uint64>(GetNumberOfJobs(), 0u);
+}
+
+OutputEntries IJobManager::GetOutputEntries(sup::dto::uint32 job_idx,
+                                            const OutputEntryIndices& last_indices) const
+{
+  (void)job_idx;
+  (void)last_indices;
+  return {};
+}
+
+void IJobManager::EditBreakpoints(sup::dto::uint32 job_idx,
+                                  const std::set<sup::dto::uint32>& instr_indices,
+                                  bool breakpoint_active)
+{
+  auto n_instr = GetNumberOfInstructions(job_idx);
+  if (!instr_indices.empty() && *instr_indices.rbegin() >= n_instr)
+  {
+    const std::string error = "IJobManager::EditBreakpoints(): instruction index out of bounds; "
+      "requesting " + std::to_string(*instr_indices.rbegin()) + " out of "
+      + std::to_string(n_instr);
+    throw InvalidOperationException(error);
+  }
+  for (auto instr_idx : instr_indices)
+  {
+    EditBreakpoint(job_idx, instr_idx, breakpoint_active);
+  }
+}
+
+std::vector<bool> IJobManager::SendJobCommands(const std::vector<sup::dto::uint32>& job_indices,
+                                               sup::oac_tree::JobCommand command)
+{
+  auto indices = job_indices;
+  if (indices.empty())
+  {
+    auto n_jobs = GetNumberOfJobs();
+    for (sup::dto::uint32 job_idx = 0; job_idx < n_jobs; ++job_idx)
+    {
+      indices.push_back(job_idx);
+    }
+  }
+  // Split the jobs in contiguous ranges, one per available hardware thread, when this object can
+  // handle concurrent calls. The first range is handled by the calling thread:
+  std::size_t n_ranges = 1;
+  if (SupportsConcurrentCalls())
+  {
+    n_ranges = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    n_ranges = std::min(n_ranges, indices.size());
+  }
+  if (n_ranges <= 1)
+  {
+    return SendJobCommandToRange(*this, indices, 0, indices.size(), command);
+  }
+  const auto range_size = (indices.size() + n_ranges - 1) / n_ranges;
+  std::vector<std::future<std::vector<bool>>> futures;
+  for (auto begin = range_size; begin < indices.size(); begin += range_size)
+  {
+    auto end = std::min(begin + range_size, indices.size());
+    futures.push_back(std::async(std::launch::async, SendJobCommandToRange, std::ref(*this),
+                                 std::cref(indices), begin, end, command));
+  }
+  auto result = SendJobCommandToRange(*this, indices, 0, range_size, command);
+  for (auto& future : futures)
+  {
+    auto range_result = future.get();
+    result.insert(result.end(), range_result.begin(), range_result.end());
+  }
+  return result;
+}
+
+bool IJobManager::SupportsConcurrentCalls() const
+{
+  return false;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
+
+namespace
+{
+std::vector<bool> SendJobCommandToRange(sup::oac_tree_server::IJobManager& job_manager,
+                                        const std::vector<sup::dto::uint32>& job_indices,
+                                        std::size_t begin, std::size_t end,
+                                        sup::oac_tree::JobCommand command)
+{
+  std::vector<bool> result{};
+  for (auto idx = begin; idx < end; ++idx)
+  {
+    try
+    {
+      job_manager.SendJobCommand(job_indices[idx], command);
+      result.push_back(true);
+    }
+    catch(const std::exception&)
+    {
+      result.push_back(false);
+    }
+  }
+  return result;
+}
+}  // unnamed namespace
@@ -23,6 +23,7 @@
 #include <sup/oac-tree-server/info_protocol_server.h>
 
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/output_entry_helper.h>
 
 #include <sup/dto/anyvalue_helper.h>
 #include <sup/protocol/function_protocol_extract.h>
@@ -64,7 +65,10 @@ InfoProtocolServer::FunctionMap()
   static sup::protocol::ProtocolMemberFunctionMap<InfoProtocolServer> f_map = {
     { kGetServerPrefixFunctionName, &InfoProtocolServer::GetServerPrefix },
     { kGetNumberOfJobsFunctionName, &InfoProtocolServer::GetNumberOfJobs },
-    { kGetJobInfoFunctionName, &InfoProtocolServer::GetJobInfo }
+    { kGetJobInfoFunctionName, &InfoProtocolServer::GetJobInfo },
+    { kGetAllJobInfosFunctionName, &InfoProtocolServer::GetAllJobInfos },
+    { kGetJobGenerationsFunctionName, &InfoProtocolServer::GetJobGenerations },
+    { kGetOutputEntriesFunctionName, &InfoProtocolServer::GetOutputEntries }
   };
   return f_map;
 }
@@ -117,6 +121,77 @@ sup::protocol::ProtocolResult InfoProtocolServer::GetJobInfo(
   return sup::protocol::Success;
 }
 
+sup::protocol::ProtocolResult InfoProtocolServer::GetAllJobInfos(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  std::vector<sup::dto::uint32> job_indices{};
+  auto result = ExtractJobIndices(input, m_job_manager.GetNumberOfJobs(), job_indices);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  auto job_manager_info = m_job_manager.GetAllJobInfos(job_indices);
+  sup::dto::AnyValue number_jobs{sup::dto::UnsignedInteger64Type, job_manager_info.m_n_jobs};
+  sup::dto::AnyValue temp_out;
+  sup::protocol::FunctionProtocolPack(temp_out, kServerPrefixFieldName,
+                                      job_manager_info.m_server_prefix);
+  sup::protocol::FunctionProtocolPack(temp_out, kNumberOfJobsFieldName, number_jobs);
+  sup::protocol::FunctionProtocolPack(temp_out, kJobInfosFieldName,
+                                      EncodeJobInfos(job_manager_info.m_job_infos));
+  sup::protocol::FunctionProtocolPack(temp_out, kJobIndicesFieldName,
+                                      EncodeJobIndices(job_manager_info.m_job_indices));
+  if (!sup::dto::TryAssignIfEmptyOrConvert(output, temp_out))
+  {
+    return sup::protocol::ServerProtocolEncodingError;
+  }
+  return sup::protocol::Success;
+}
+
+sup::protocol::ProtocolResult InfoProtocolServer::GetJobGenerations(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  (void)input;
+  auto generations = m_job_manager.GetJobGenerations();
+  sup::dto::AnyValue temp_out;
+  sup::protocol::FunctionProtocolPack(temp_out, kJobGenerationsFieldName,
+                                      EncodeJobGenerations(generations));
+  if (!sup::dto::TryAssignIfEmptyOrConvert(output, temp_out))
+  {
+    return sup::protocol::ServerProtocolEncodingError;
+  }
+  return sup::protocol::Success;
+}
+
+sup::protocol::ProtocolResult InfoProtocolServer::GetOutputEntries(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  sup::dto::uint32 idx{};
+  auto result = ExtractJobIndex(input, m_job_manager.GetNumberOfJobs(), idx);
+  if (result != sup::protocol::Success)
+  {
+    return result;
+  }
+  sup::dto::AnyValue indices_av;
+  if (!sup::protocol::FunctionProtocolExtract(indices_av, input, kOutputEntryIndicesFieldName))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  auto [decoded, last_indices] = DecodeOutputEntryIndices(indices_av);
+  if (!decoded)
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  auto output_entries = m_job_manager.GetOutputEntries(idx, last_indices);
+  sup::dto::AnyValue temp_out;
+  sup::protocol::FunctionProtocolPack(temp_out, kOutputEntriesFieldName,
+                                      EncodeOutputEntries(output_entries));
+  if (!sup::dto::TryAssignIfEmptyOrConvert(output, temp_out))
+  {
+    return sup::protocol::ServerProtocolEncodingError;
+  }
+  return sup::protocol::Success;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -23,9 +23,11 @@
 #include <sup/oac-tree-server/input_protocol_client.h>
 
 #include <sup/oac-tree-server/input_reply_helper.h>
+#include <sup/oac-tree-server/input_request_helper.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
 #include <sup/protocol/function_protocol.h>
+#include <sup/protocol/function_protocol_extract.h>
 #include <sup/protocol/function_protocol_pack.h>
 
 namespace sup
@@ -53,6 +55,41 @@ bool InputProtocolClient::SetClientReply(sup::dto::uint64 id, const UserInputRep
   return true;
 }
 
+std::tuple<bool, sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+InputProtocolClient::GetPendingRequests(sup::dto::uint64 update_count,
+                                        sup::dto::uint32 timeout_ms)
+{
+  const std::tuple<bool, sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+    failure{ false, 0, {} };
+  auto input = sup::protocol::FunctionProtocolInput(kGetPendingRequestsFunctionName);
+  sup::protocol::FunctionProtocolPack(
+    input, kUpdateCountFieldName, sup::dto::AnyValue{ sup::dto::UnsignedInteger64Type,
+                                                      update_count });
+  sup::protocol::FunctionProtocolPack(
+    input, kTimeoutFieldName, sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, timeout_ms });
+  sup::dto::AnyValue output;
+  auto result = m_protocol.Invoke(input, output);
+  if (result != sup::protocol::Success)
+  {
+    return failure;
+  }
+  sup::dto::AnyValue update_count_av;
+  sup::dto::AnyValue requests_av;
+  sup::dto::uint64 current_count{};
+  if (!sup::protocol::FunctionProtocolExtract(update_count_av, output, kUpdateCountFieldName)
+      || !update_count_av.As(current_count)
+      || !sup::protocol::FunctionProtocolExtract(requests_av, output, kPendingRequestsFieldName))
+  {
+    return failure;
+  }
+  auto [decoded, pending_requests] = DecodeInputRequestList(requests_av);
+  if (!decoded)
+  {
+    return failure;
+  }
+  return { true, current_count, pending_requests };
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -23,12 +23,16 @@
 #include <sup/oac-tree-server/input_protocol_server.h>
 
 #include <sup/oac-tree-server/input_reply_helper.h>
+#include <sup/oac-tree-server/input_request_helper.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
 #include <sup/dto/anyvalue_helper.h>
 #include <sup/protocol/function_protocol_extract.h>
+#include <sup/protocol/function_protocol_pack.h>
 #include <sup/protocol/protocol_rpc.h>
 
+#include <algorithm>
+
 namespace sup
 {
 namespace oac_tree_server
@@ -61,7 +65,8 @@ const sup::protocol::ProtocolMemberFunctionMap<InputProtocolServer>&
 InputProtocolServer::FunctionMap()
 {
   static sup::protocol::ProtocolMemberFunctionMap<InputProtocolServer> f_map = {
-    { KSetReplyFunctionName, &InputProtocolServer::SetClientReply }
+    { KSetReplyFunctionName, &InputProtocolServer::SetClientReply },
+    { kGetPendingRequestsFunctionName, &InputProtocolServer::GetPendingRequests }
   };
   return f_map;
 }
@@ -90,6 +95,38 @@ sup::protocol::ProtocolResult InputProtocolServer::SetClientReply(
   return sup::protocol::Success;
 }
 
+sup::protocol::ProtocolResult InputProtocolServer::GetPendingRequests(
+  const sup::dto::AnyValue& input, sup::dto::AnyValue& output)
+{
+  sup::dto::AnyValue update_count_av;
+  sup::dto::uint64 update_count{};
+  if (!sup::protocol::FunctionProtocolExtract(update_count_av, input, kUpdateCountFieldName)
+      || !update_count_av.As(update_count))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  sup::dto::AnyValue timeout_av;
+  sup::dto::uint32 timeout_ms{};
+  if (!sup::protocol::FunctionProtocolExtract(timeout_av, input, kTimeoutFieldName)
+      || !timeout_av.As(timeout_ms))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  timeout_ms = std::min(timeout_ms, kMaxPendingRequestsTimeoutMs);
+  auto [current_count, pending_requests] = m_request_server.WaitForPendingRequests(
+    update_count, std::chrono::milliseconds(timeout_ms));
+  sup::dto::AnyValue current_count_av{ sup::dto::UnsignedInteger64Type, current_count };
+  sup::dto::AnyValue temp_out;
+  sup::protocol::FunctionProtocolPack(temp_out, kUpdateCountFieldName, current_count_av);
+  sup::protocol::FunctionProtocolPack(temp_out, kPendingRequestsFieldName,
+                                      EncodeInputRequestList(pending_requests));
+  if (!sup::dto::TryAssignIfEmptyOrConvert(output, temp_out))
+  {
+    return sup::protocol::ServerProtocolEncodingError;
+  }
+  return sup::protocol::Success;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
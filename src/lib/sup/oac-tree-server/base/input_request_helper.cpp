@@ -70,6 +70,39 @@ std::tuple<bool, sup::dto::uint64, UserInputRequest> DecodeInputRequest(
   return { true, req_idx, input_request };
 }
 
+sup::dto::AnyValue EncodeInputRequestList(
+  const std::map<sup::dto::uint64, UserInputRequest>& input_requests)
+{
+  auto result = sup::dto::EmptyStruct();
+  std::size_t idx = 0;
+  for (const auto& [id, input_request] : input_requests)
+  {
+    (void)result.AddMember("q" + std::to_string(idx), EncodeInputRequest(id, input_request));
+    ++idx;
+  }
+  return result;
+}
+
+std::pair<bool, std::map<sup::dto::uint64, UserInputRequest>> DecodeInputRequestList(
+  const sup::dto::AnyValue& encoded)
+{
+  if (!sup::dto::IsStructValue(encoded))
+  {
+    return { false, {} };
+  }
+  std::map<sup::dto::uint64, UserInputRequest> result{};
+  for (const auto& member_name : encoded.MemberNames())
+  {
+    auto [valid, id, input_request] = DecodeInputRequest(encoded[member_name]);
+    if (!valid)
+    {
+      return { false, {} };
+    }
+    (void)result.emplace(id, input_request);
+  }
+  return { true, result };
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
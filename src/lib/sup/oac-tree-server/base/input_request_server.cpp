@@ -25,6 +25,7 @@
 namespace
 {
 bool IsValid(const sup::oac_tree::UserInputReply& reply);
+bool IsValid(const sup::oac_tree::UserInputRequest& request);
 }  // unnamed namespace
 
 namespace sup
@@ -33,11 +34,11 @@ namespace oac_tree_server
 {
 
 using sup::oac_tree::kInvalidUserInputReply;
+using sup::oac_tree::kInvalidUserInputRequest;
 
 InputRequestServer::InputRequestServer()
-  : m_request_id{0}
-  , m_reply{kInvalidUserInputReply}
-  , m_interrupt{false}
+  : m_slots{}
+  , m_update_count{0}
   , m_mtx{}
   , m_cv{}
 {}
@@ -46,10 +47,24 @@ InputRequestServer::~InputRequestServer() = default;
 
 void InputRequestServer::InitNewRequest(sup::dto::uint64 id)
 {
-  std::lock_guard<std::mutex> lk{m_mtx};
-  m_request_id = id;
-  m_interrupt = false;
-  m_reply = kInvalidUserInputReply;
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_slots.clear();
+    m_slots[id] = ReplySlot{ kInvalidUserInputRequest, kInvalidUserInputReply, false };
+    ++m_update_count;
+  }
+  // Waiters for discarded requests need to wake up:
+  m_cv.notify_all();
+}
+
+void InputRequestServer::AddRequest(sup::dto::uint64 id, const UserInputRequest& request)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_slots[id] = ReplySlot{ request, kInvalidUserInputReply, false };
+    ++m_update_count;
+  }
+  m_cv.notify_all();
 }
 
 bool InputRequestServer::SetClientReply(sup::dto::uint64 id, const UserInputReply& reply)
@@ -61,47 +76,115 @@ bool InputRequestServer::SetClientReply(sup::dto::uint64 id, const UserInputRepl
   }
   {
     std::lock_guard<std::mutex> lk{m_mtx};
-    // Refuse to set reply if index doesn't match or reply was already set:
-    if (id != m_request_id || IsValid(m_reply))
+    // Refuse to set reply if there is no such request or reply was already set:
+    auto iter = m_slots.find(id);
+    if (iter == m_slots.end() || IsValid(iter->second.m_reply))
     {
       return false;
     }
-    m_reply = reply;
+    iter->second.m_reply = reply;
+    ++m_update_count;
   }
-  m_cv.notify_one();
+  m_cv.notify_all();
   return true;
 }
 
 std::pair<bool, UserInputReply> InputRequestServer::WaitForReply(sup::dto::uint64 id)
+{
+  auto [status, reply] = WaitForReplyImpl(id, std::nullopt);
+  return { status == UserInputStatus::kReplied, reply };
+}
+
+std::pair<UserInputStatus, UserInputReply> InputRequestServer::WaitForReplyUntil(
+  sup::dto::uint64 id, std::chrono::steady_clock::time_point deadline)
+{
+  return WaitForReplyImpl(id, deadline);
+}
+
+void InputRequestServer::Interrupt(sup::dto::uint64 id)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    auto iter = m_slots.find(id);
+    if (iter == m_slots.end())
+    {
+      return;
+    }
+    iter->second.m_interrupt = true;
+    ++m_update_count;
+  }
+  m_cv.notify_all();
+}
+
+std::map<sup::dto::uint64, UserInputRequest> InputRequestServer::GetPendingRequests() const
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  return GetPendingRequestsImpl();
+}
+
+std::pair<sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+InputRequestServer::WaitForPendingRequests(sup::dto::uint64 update_count,
+                                           std::chrono::milliseconds timeout)
+{
+  auto pred = [this, update_count]() {
+    return m_update_count != update_count;
+  };
+  std::unique_lock<std::mutex> lk{m_mtx};
+  (void)m_cv.wait_for(lk, timeout, pred);
+  return { m_update_count, GetPendingRequestsImpl() };
+}
+
+std::pair<UserInputStatus, UserInputReply> InputRequestServer::WaitForReplyImpl(
+  sup::dto::uint64 id, const std::optional<std::chrono::steady_clock::time_point>& deadline)
 {
   if (id == 0)
   {
-    return { false, kInvalidUserInputReply };
+    return { UserInputStatus::kInterrupted, kInvalidUserInputReply };
   }
   auto pred = [this, id]() {
-    auto reply_received = (IsValid(m_reply) && id == m_request_id);
-    return reply_received || m_interrupt;
+    auto iter = m_slots.find(id);
+    return iter == m_slots.end() || IsValid(iter->second.m_reply) || iter->second.m_interrupt;
   };
   std::unique_lock<std::mutex> lk{m_mtx};
-  m_cv.wait(lk, pred);
-  if (m_interrupt)
+  if (!deadline.has_value())
   {
-    return { false, kInvalidUserInputReply };
+    m_cv.wait(lk, pred);
   }
-  return { true, m_reply };
+  else if (!m_cv.wait_until(lk, deadline.value(), pred))
+  {
+    // Abandon the request, so that late replies are refused:
+    (void)m_slots.erase(id);
+    ++m_update_count;
+    lk.unlock();
+    m_cv.notify_all();
+    return { UserInputStatus::kTimedOut, kInvalidUserInputReply };
+  }
+  auto iter = m_slots.find(id);
+  if (iter == m_slots.end())
+  {
+    return { UserInputStatus::kInterrupted, kInvalidUserInputReply };
+  }
+  auto slot = iter->second;
+  // The request was already no longer pending, so the update count is left untouched:
+  (void)m_slots.erase(iter);
+  if (slot.m_interrupt)
+  {
+    return { UserInputStatus::kInterrupted, kInvalidUserInputReply };
+  }
+  return { UserInputStatus::kReplied, slot.m_reply };
 }
 
-void InputRequestServer::Interrupt(sup::dto::uint64 id)
+std::map<sup::dto::uint64, UserInputRequest> InputRequestServer::GetPendingRequestsImpl() const
 {
+  std::map<sup::dto::uint64, UserInputRequest> result;
+  for (const auto& [id, slot] : m_slots)
   {
-    std::lock_guard<std::mutex> lk{m_mtx};
-    if (m_request_id != id)
+    if (IsValid(slot.m_request) && !IsValid(slot.m_reply) && !slot.m_interrupt)
     {
-      return;
+      (void)result.emplace(id, slot.m_request);
     }
-    m_interrupt = true;
   }
-  m_cv.notify_one();
+  return result;
 }
 
 }  // namespace oac_tree_server
@@ -114,4 +197,9 @@ bool IsValid(const sup::oac_tree::UserInputReply& reply)
 {
   return reply.m_request_type != sup::oac_tree::InputRequestType::kInvalid;
 }
+
+bool IsValid(const sup::oac_tree::UserInputRequest& request)
+{
+  return request.m_request_type != sup::oac_tree::InputRequestType::kInvalid;
+}
 }  // unnamed namespace
@@ -31,8 +31,10 @@
 #include <sup/oac-tree/constants.h>
 #include <sup/oac-tree/execution_status.h>
 #include <sup/oac-tree/i_job_info_io.h>
+#include <sup/oac-tree/job_info_utils.h>
 #include <sup/oac-tree/job_states.h>
 
+#include <exception>
 #include <limits>
 #include <map>
 
@@ -43,6 +45,8 @@ bool ValidateVariableAnyValue(const sup::dto::AnyValue& payload);
 bool EndsWith(const std::string& str, const std::string& sub_str);
 
 bool ParseIndex(const std::string& idx_str, sup::dto::uint32& idx);
+
+bool HasEmptyLeaf(const sup::dto::AnyValue& value);
 }
 
 namespace sup
@@ -62,6 +66,8 @@ const sup::dto::AnyValue kInputRequestAnyValue = {{
   { kInputRequestInputValueField, {} }
 }, kInputRequestType };
 
+const sup::dto::AnyValue kInputRequestListAnyValue = sup::dto::EmptyStruct();
+
 const sup::dto::AnyValue kLogEntryAnyValue = {{
   { sup::oac_tree::Constants::kIndexField, { sup::dto::UnsignedInteger64Type, 0 } },
   { kSeverityField, { sup::dto::SignedInteger32Type, 0 } },
@@ -147,6 +153,18 @@ std::string GetVariablePVName(const std::string& prefix, sup::dto::uint32 index)
   return prefix + kVariableId + std::to_string(index);
 }
 
+std::string GetVariableKeyframePVName(const std::string& var_pv_name)
+{
+  auto value_name_info = ParseValueName(var_pv_name);
+  if (value_name_info.val_type != ValueNameType::kVariable)
+  {
+    return {};
+  }
+  auto postfix = kVariableId + std::to_string(value_name_info.idx);
+  auto prefix = var_pv_name.substr(0, var_pv_name.size() - postfix.size());
+  return prefix + kVariableKeyframeId + std::to_string(value_name_info.idx);
+}
+
 std::string GetInputServerName(const std::string& prefix)
 {
   return prefix + kInputServerName;
@@ -157,6 +175,11 @@ std::string GetInputRequestPVName(const std::string& server_name)
   return server_name + kInputRequestName;
 }
 
+std::string GetInputRequestListPVName(const std::string& server_name)
+{
+  return server_name + kInputRequestListName;
+}
+
 std::string GetLogEntryName(const std::string& prefix)
 {
   return prefix + kLogEntryId;
@@ -266,6 +289,10 @@ ValueNameInfo ParseValueName(const std::string& val_name)
   {
     return { ValueNameType::kVariable, idx };
   }
+  if (EndsWith(remainder, kVariableKeyframeId) && remainder.size() != kVariableKeyframeId.size())
+  {
+    return { ValueNameType::kVariableKeyframe, idx };
+  }
   return unknown;
 }
 
@@ -288,6 +315,163 @@ sup::protocol::ProtocolResult ExtractJobIndex(
   return sup::protocol::Success;
 }
 
+sup::dto::AnyValue EncodeJobIndices(const std::vector<sup::dto::uint32>& job_indices)
+{
+  auto result = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < job_indices.size(); ++idx)
+  {
+    (void)result.AddMember("j" + std::to_string(idx),
+                           sup::dto::AnyValue{sup::dto::UnsignedInteger64Type, job_indices[idx]});
+  }
+  return result;
+}
+
+std::pair<bool, std::vector<sup::dto::uint32>> DecodeJobIndices(
+  const sup::dto::AnyValue& anyvalue)
+{
+  if (!sup::dto::IsStructValue(anyvalue))
+  {
+    return { false, {} };
+  }
+  std::vector<sup::dto::uint32> result{};
+  for (const auto& member_name : anyvalue.MemberNames())
+  {
+    sup::dto::uint32 idx{};
+    if (!anyvalue[member_name].As(idx))
+    {
+      return { false, {} };
+    }
+    result.push_back(idx);
+  }
+  return { true, result };
+}
+
+sup::protocol::ProtocolResult ExtractJobIndices(
+  const sup::dto::AnyValue& input, sup::dto::uint32 n_jobs,
+  std::vector<sup::dto::uint32>& job_indices)
+{
+  std::vector<sup::dto::uint32> result{};
+  sup::dto::AnyValue indices_av{};
+  if (!sup::protocol::FunctionProtocolExtract(indices_av, input, kJobIndicesFieldName))
+  {
+    job_indices = result;
+    return sup::protocol::Success;
+  }
+  if (!sup::dto::IsStructValue(indices_av))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  for (const auto& member_name : indices_av.MemberNames())
+  {
+    sup::dto::uint32 idx{};
+    if (!indices_av[member_name].As(idx))
+    {
+      return sup::protocol::ServerProtocolDecodingError;
+    }
+    if (idx >= n_jobs)
+    {
+      return UnknownJob;
+    }
+    result.push_back(idx);
+  }
+  job_indices = result;
+  return sup::protocol::Success;
+}
+
+sup::dto::AnyValue EncodeJobInfos(const std::vector<sup::oac_tree::JobInfo>& job_infos)
+{
+  auto result = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < job_infos.size(); ++idx)
+  {
+    (void)result.AddMember("j" + std::to_string(idx),
+                           sup::oac_tree::utils::ToAnyValue(job_infos[idx]));
+  }
+  return result;
+}
+
+std::pair<bool, std::vector<sup::oac_tree::JobInfo>> DecodeJobInfos(
+  const sup::dto::AnyValue& anyvalue)
+{
+  if (!sup::dto::IsStructValue(anyvalue))
+  {
+    return { false, {} };
+  }
+  std::vector<sup::oac_tree::JobInfo> result{};
+  try
+  {
+    for (const auto& member_name : anyvalue.MemberNames())
+    {
+      result.push_back(sup::oac_tree::utils::ToJobInfo(anyvalue[member_name]));
+    }
+  }
+  catch(const std::exception&)
+  {
+    return { false, {} };
+  }
+  return { true, result };
+}
+
+sup::dto::AnyValue EncodeJobGenerations(const std::vector<sup::dto::uint64>& generations)
+{
+  auto result = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < generations.size(); ++idx)
+  {
+    (void)result.AddMember("g" + std::to_string(idx),
+                           sup::dto::AnyValue{sup::dto::UnsignedInteger64Type, generations[idx]});
+  }
+  return result;
+}
+
+std::pair<bool, std::vector<sup::dto::uint64>> DecodeJobGenerations(
+  const sup::dto::AnyValue& anyvalue)
+{
+  if (!sup::dto::IsStructValue(anyvalue))
+  {
+    return { false, {} };
+  }
+  std::vector<sup::dto::uint64> result{};
+  for (const auto& member_name : anyvalue.MemberNames())
+  {
+    sup::dto::uint64 generation{};
+    if (!anyvalue[member_name].As(generation))
+    {
+      return { false, {} };
+    }
+    result.push_back(generation);
+  }
+  return { true, result };
+}
+
+sup::dto::AnyValue EncodeJobCommandResults(const std::vector<bool>& results)
+{
+  auto result = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < results.size(); ++idx)
+  {
+    (void)result.AddMember("r" + std::to_string(idx),
+                           sup::dto::AnyValue{sup::dto::BooleanType, results[idx]});
+  }
+  return result;
+}
+
+std::pair<bool, std::vector<bool>> DecodeJobCommandResults(const sup::dto::AnyValue& anyvalue)
+{
+  if (!sup::dto::IsStructValue(anyvalue))
+  {
+    return { false, {} };
+  }
+  std::vector<bool> result{};
+  for (const auto& member_name : anyvalue.MemberNames())
+  {
+    bool success{};
+    if (!anyvalue[member_name].As(success))
+    {
+      return { false, {} };
+    }
+    result.push_back(success);
+  }
+  return { true, result };
+}
+
 sup::protocol::ProtocolResult ExtractInstructionIndex(
   const sup::dto::AnyValue& input, sup::dto::uint32 n_instr, sup::dto::uint32& idx)
 {
@@ -307,6 +491,50 @@ sup::protocol::ProtocolResult ExtractInstructionIndex(
   return sup::protocol::Success;
 }
 
+sup::dto::AnyValue EncodeInstructionIndices(const std::set<sup::dto::uint32>& instr_indices)
+{
+  auto result = sup::dto::EmptyStruct();
+  std::size_t idx = 0;
+  for (auto instr_idx : instr_indices)
+  {
+    (void)result.AddMember("i" + std::to_string(idx),
+                           sup::dto::AnyValue{sup::dto::UnsignedInteger64Type, instr_idx});
+    ++idx;
+  }
+  return result;
+}
+
+sup::protocol::ProtocolResult ExtractInstructionIndices(
+  const sup::dto::AnyValue& input, sup::dto::uint32 n_instr,
+  std::set<sup::dto::uint32>& instr_indices)
+{
+  sup::dto::AnyValue indices_av{};
+  if (!sup::protocol::FunctionProtocolExtract(indices_av, input, kInstructionIndicesFieldName))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  if (!sup::dto::IsStructValue(indices_av))
+  {
+    return sup::protocol::ServerProtocolDecodingError;
+  }
+  std::set<sup::dto::uint32> result{};
+  for (const auto& member_name : indices_av.MemberNames())
+  {
+    sup::dto::uint32 idx{};
+    if (!indices_av[member_name].As(idx))
+    {
+      return sup::protocol::ServerProtocolDecodingError;
+    }
+    if (idx >= n_instr)
+    {
+      return UnknownInstruction;
+    }
+    (void)result.insert(idx);
+  }
+  instr_indices = result;
+  return sup::protocol::Success;
+}
+
 sup::dto::AnyValue Base64EncodeAnyValue(const sup::dto::AnyValue& value)
 {
   auto [encoded, base64value] = sup::protocol::Base64VariableCodec::Encode(value);
@@ -328,6 +556,25 @@ std::pair<bool, sup::dto::AnyValue> Base64DecodeAnyValue(const sup::dto::AnyValu
   return { false, {} };
 }
 
+bool IsNativeChannelValue(const sup::dto::AnyValue& value)
+{
+  return sup::dto::IsStructValue(value) && !HasEmptyLeaf(value);
+}
+
+std::pair<bool, sup::dto::AnyValue> DecodeChannelValue(const sup::dto::AnyValue& value)
+{
+  auto result = Base64DecodeAnyValue(value);
+  if (result.first)
+  {
+    return result;
+  }
+  if (IsNativeChannelValue(value))
+  {
+    return { true, value };
+  }
+  return { false, {} };
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -378,5 +625,34 @@ bool ParseIndex(const std::string& idx_str, sup::dto::uint32& idx)
   return true;
 }
 
+bool HasEmptyLeaf(const sup::dto::AnyValue& value)
+{
+  if (sup::dto::IsEmptyValue(value))
+  {
+    return true;
+  }
+  if (sup::dto::IsStructValue(value))
+  {
+    for (const auto& member_name : value.MemberNames())
+    {
+      if (HasEmptyLeaf(value[member_name]))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (sup::dto::IsArrayValue(value))
+  {
+    for (std::size_t idx = 0; idx < value.NumberOfElements(); ++idx)
+    {
+      if (HasEmptyLeaf(value[idx]))
+      {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/output_entry_batcher.h>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+OutputEntryBatcher::OutputEntryBatcher(std::chrono::milliseconds flush_interval,
+                                       std::size_t max_batch_size,
+                                       const LogBatchFunction& log_batch_func,
+                                       const MessageBatchFunction& msg_batch_func)
+  : m_flush_interval{flush_interval}
+  , m_max_batch_size{max_batch_size}
+  , m_log_batch_func{log_batch_func}
+  , m_msg_batch_func{msg_batch_func}
+  , m_log_entries{}
+  , m_msg_entries{}
+  , m_exit{false}
+  , m_mtx{}
+  , m_cv{}
+  , m_flush_future{}
+{
+  m_flush_future = std::async(std::launch::async, &OutputEntryBatcher::FlushLoop, this);
+}
+
+OutputEntryBatcher::~OutputEntryBatcher()
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_exit = true;
+  }
+  m_cv.notify_one();
+  m_flush_future.get();
+}
+
+void OutputEntryBatcher::AddLogEntry(const LogEntry& log_entry)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_log_entries.push_back(log_entry);
+  }
+  m_cv.notify_one();
+}
+
+void OutputEntryBatcher::AddMessageEntry(const MessageEntry& msg_entry)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_msg_entries.push_back(msg_entry);
+  }
+  m_cv.notify_one();
+}
+
+void OutputEntryBatcher::FlushLoop()
+{
+  bool exit = false;
+  while (!exit)
+  {
+    std::vector<LogEntry> log_entries;
+    std::vector<MessageEntry> msg_entries;
+    {
+      std::unique_lock<std::mutex> lk{m_mtx};
+      m_cv.wait(lk, [this]() {
+        return m_exit || !m_log_entries.empty() || !m_msg_entries.empty();
+      });
+      // The first pending entry starts the flush interval:
+      (void)m_cv.wait_for(lk, m_flush_interval, [this]() {
+        return m_exit || BatchFull();
+      });
+      exit = m_exit;
+      std::swap(log_entries, m_log_entries);
+      std::swap(msg_entries, m_msg_entries);
+    }
+    // Publish outside the lock, so producers are never blocked by publishing:
+    if (!log_entries.empty())
+    {
+      m_log_batch_func(log_entries);
+    }
+    if (!msg_entries.empty())
+    {
+      m_msg_batch_func(msg_entries);
+    }
+  }
+}
+
+bool OutputEntryBatcher::BatchFull() const
+{
+  return m_log_entries.size() >= m_max_batch_size || m_msg_entries.size() >= m_max_batch_size;
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
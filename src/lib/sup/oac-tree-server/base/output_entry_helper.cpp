@@ -27,6 +27,20 @@
 #include <sup/oac-tree/anyvalue_utils.h>
 #include <sup/oac-tree/constants.h>
 
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename Entry>
+sup::dto::AnyValue EncodeEntries(const std::vector<Entry>& entries,
+                                 sup::dto::AnyValue (*encode_func)(const Entry&));
+template <typename Entry>
+bool DecodeEntries(const sup::dto::AnyValue& anyvalue,
+                   std::pair<bool, Entry> (*decode_func)(const sup::dto::AnyValue&),
+                   std::vector<Entry>& entries);
+}  // unnamed namespace
+
 namespace sup
 {
 namespace oac_tree_server
@@ -147,6 +161,144 @@ std::pair<bool, OutputValueEntry> DecodeOutputValueEntry(const sup::dto::AnyValu
   return failure;
 }
 
+sup::dto::AnyValue EncodeLogEntryBatch(const std::vector<LogEntry>& log_entries)
+{
+  sup::dto::AnyValue result = {{
+    { kEntryBatchField, EncodeEntries(log_entries, EncodeLogEntry) }
+  }, kLogEntryBatchType };
+  return result;
+}
+
+std::pair<bool, std::vector<LogEntry>> DecodeLogEntryBatch(const sup::dto::AnyValue& anyvalue)
+{
+  std::vector<LogEntry> result{};
+  if (!IsEntryBatch(anyvalue)
+      || !DecodeEntries(anyvalue[kEntryBatchField], DecodeLogEntry, result))
+  {
+    return { false, {} };
+  }
+  return { true, result };
+}
+
+sup::dto::AnyValue EncodeMessageEntryBatch(const std::vector<MessageEntry>& msg_entries)
+{
+  sup::dto::AnyValue result = {{
+    { kEntryBatchField, EncodeEntries(msg_entries, EncodeMessageEntry) }
+  }, kMessageEntryBatchType };
+  return result;
+}
+
+std::pair<bool, std::vector<MessageEntry>> DecodeMessageEntryBatch(
+  const sup::dto::AnyValue& anyvalue)
+{
+  std::vector<MessageEntry> result{};
+  if (!IsEntryBatch(anyvalue)
+      || !DecodeEntries(anyvalue[kEntryBatchField], DecodeMessageEntry, result))
+  {
+    return { false, {} };
+  }
+  return { true, result };
+}
+
+bool IsEntryBatch(const sup::dto::AnyValue& anyvalue)
+{
+  return anyvalue.HasField(kEntryBatchField);
+}
+
+sup::dto::AnyValue EncodeOutputEntries(const OutputEntries& output_entries)
+{
+  sup::dto::AnyValue result = {{
+    { kLogEntriesField, EncodeEntries(output_entries.m_log_entries, EncodeLogEntry) },
+    { kMessageEntriesField, EncodeEntries(output_entries.m_message_entries, EncodeMessageEntry) },
+    { kOutputValueEntriesField, EncodeEntries(output_entries.m_output_value_entries,
+                                              EncodeOutputValueEntry) }
+  }, kOutputEntriesType };
+  return result;
+}
+
+std::pair<bool, OutputEntries> DecodeOutputEntries(const sup::dto::AnyValue& anyvalue)
+{
+  if (!anyvalue.HasField(kLogEntriesField) || !anyvalue.HasField(kMessageEntriesField)
+      || !anyvalue.HasField(kOutputValueEntriesField))
+  {
+    return { false, {} };
+  }
+  OutputEntries result{};
+  if (!DecodeEntries(anyvalue[kLogEntriesField], DecodeLogEntry, result.m_log_entries)
+      || !DecodeEntries(anyvalue[kMessageEntriesField], DecodeMessageEntry,
+                        result.m_message_entries)
+      || !DecodeEntries(anyvalue[kOutputValueEntriesField], DecodeOutputValueEntry,
+                        result.m_output_value_entries))
+  {
+    return { false, {} };
+  }
+  return { true, result };
+}
+
+sup::dto::AnyValue EncodeOutputEntryIndices(const OutputEntryIndices& indices)
+{
+  sup::dto::AnyValue result = {{
+    { kLogIndexField, { sup::dto::UnsignedInteger64Type, indices.m_log_idx }},
+    { kMessageIndexField, { sup::dto::UnsignedInteger64Type, indices.m_message_idx }},
+    { kOutputValueIndexField, { sup::dto::UnsignedInteger64Type, indices.m_output_value_idx }}
+  }, kOutputEntryIndicesType };
+  return result;
+}
+
+std::pair<bool, OutputEntryIndices> DecodeOutputEntryIndices(const sup::dto::AnyValue& anyvalue)
+{
+  if (!ValidateMemberType(anyvalue, kLogIndexField, sup::dto::UnsignedInteger64Type)
+      || !ValidateMemberType(anyvalue, kMessageIndexField, sup::dto::UnsignedInteger64Type)
+      || !ValidateMemberType(anyvalue, kOutputValueIndexField, sup::dto::UnsignedInteger64Type))
+  {
+    return { false, {} };
+  }
+  OutputEntryIndices result{};
+  result.m_log_idx = anyvalue[kLogIndexField].As<sup::dto::uint64>();
+  result.m_message_idx = anyvalue[kMessageIndexField].As<sup::dto::uint64>();
+  result.m_output_value_idx = anyvalue[kOutputValueIndexField].As<sup::dto::uint64>();
+  return { true, result };
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
+
+namespace
+{
+// Entries are encoded as members of a structure, since the type of output value entries differs
+// between entries and cannot be used as an array element type:
+template <typename Entry>
+sup::dto::AnyValue EncodeEntries(const std::vector<Entry>& entries,
+                                 sup::dto::AnyValue (*encode_func)(const Entry&))
+{
+  auto result = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < entries.size(); ++idx)
+  {
+    (void)result.AddMember("e" + std::to_string(idx), encode_func(entries[idx]));
+  }
+  return result;
+}
+
+template <typename Entry>
+bool DecodeEntries(const sup::dto::AnyValue& anyvalue,
+                   std::pair<bool, Entry> (*decode_func)(const sup::dto::AnyValue&),
+                   std::vector<Entry>& entries)
+{
+  if (!sup::dto::IsStructValue(anyvalue))
+  {
+    return false;
+  }
+  for (const auto& member_name : anyvalue.MemberNames())
+  {
+    auto [decoded, entry] = decode_func(anyvalue[member_name]);
+    if (!decoded)
+    {
+      return false;
+    }
+    entries.push_back(entry);
+  }
+  return true;
+}
+
+}  // unnamed namespace
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/output_entry_history.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+template <typename Entry>
+void AddBoundedEntry(std::deque<Entry>& entries, const Entry& entry, sup::dto::uint32 capacity);
+template <typename Entry>
+std::vector<Entry> GetEntriesAfterIndex(const std::deque<Entry>& entries,
+                                        sup::dto::uint64 last_idx);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+OutputEntryHistory::OutputEntryHistory(sup::dto::uint32 capacity)
+  : m_capacity{capacity}
+  , m_log_entries{}
+  , m_message_entries{}
+  , m_output_value_entries{}
+  , m_mtx{}
+{}
+
+OutputEntryHistory::~OutputEntryHistory() = default;
+
+void OutputEntryHistory::AddLogEntry(const LogEntry& log_entry)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  AddBoundedEntry(m_log_entries, log_entry, m_capacity);
+}
+
+void OutputEntryHistory::AddMessageEntry(const MessageEntry& msg_entry)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  AddBoundedEntry(m_message_entries, msg_entry, m_capacity);
+}
+
+void OutputEntryHistory::AddOutputValueEntry(const OutputValueEntry& output_entry)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  AddBoundedEntry(m_output_value_entries, output_entry, m_capacity);
+}
+
+OutputEntries OutputEntryHistory::GetEntriesAfter(const OutputEntryIndices& last_indices) const
+{
+  OutputEntries result{};
+  std::lock_guard<std::mutex> lk{m_mtx};
+  result.m_log_entries = GetEntriesAfterIndex(m_log_entries, last_indices.m_log_idx);
+  result.m_message_entries = GetEntriesAfterIndex(m_message_entries, last_indices.m_message_idx);
+  result.m_output_value_entries =
+    GetEntriesAfterIndex(m_output_value_entries, last_indices.m_output_value_idx);
+  return result;
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+namespace
+{
+template <typename Entry>
+void AddBoundedEntry(std::deque<Entry>& entries, const Entry& entry, sup::dto::uint32 capacity)
+{
+  if (capacity == 0)
+  {
+    return;
+  }
+  if (entries.size() >= capacity)
+  {
+    entries.pop_front();
+  }
+  entries.push_back(entry);
+}
+
+// Entries are generated with increasing indices, but concurrent producers may add them slightly out
+// of order, so the result is sorted explicitly:
+template <typename Entry>
+std::vector<Entry> GetEntriesAfterIndex(const std::deque<Entry>& entries,
+                                        sup::dto::uint64 last_idx)
+{
+  std::vector<Entry> result{};
+  std::copy_if(entries.begin(), entries.end(), std::back_inserter(result),
+               [last_idx](const Entry& entry) { return entry.m_index > last_idx; });
+  std::sort(result.begin(), result.end(), [](const Entry& left, const Entry& right) {
+    return left.m_index < right.m_index;
+  });
+  return result;
+}
+
+}  // unnamed namespace
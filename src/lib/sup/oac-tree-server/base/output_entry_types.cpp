@@ -89,6 +89,50 @@ bool operator!=(const OutputValueEntry& left, const OutputValueEntry& right)
   return !(left == right);
 }
 
+bool operator==(const OutputEntries& left, const OutputEntries& right)
+{
+  if (left.m_log_entries != right.m_log_entries)
+  {
+    return false;
+  }
+  if (left.m_message_entries != right.m_message_entries)
+  {
+    return false;
+  }
+  if (left.m_output_value_entries != right.m_output_value_entries)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool operator!=(const OutputEntries& left, const OutputEntries& right)
+{
+  return !(left == right);
+}
+
+bool operator==(const OutputEntryIndices& left, const OutputEntryIndices& right)
+{
+  if (left.m_log_idx != right.m_log_idx)
+  {
+    return false;
+  }
+  if (left.m_message_idx != right.m_message_idx)
+  {
+    return false;
+  }
+  if (left.m_output_value_idx != right.m_output_value_idx)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool operator!=(const OutputEntryIndices& left, const OutputEntryIndices& right)
+{
+  return !(left == right);
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/reply_executor.h>
+
+#include <sup/oac-tree-server/exceptions.h>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+ReplyExecutor::ReplyExecutor(std::size_t n_threads)
+  : m_tasks{}
+  , m_halt{false}
+  , m_mtx{}
+  , m_cv{}
+  , m_workers{}
+{
+  if (n_threads == 0)
+  {
+    const std::string error = "ReplyExecutor::ReplyExecutor(): number of threads must be positive";
+    throw InvalidOperationException(error);
+  }
+  m_workers.reserve(n_threads);
+  for (std::size_t idx = 0; idx < n_threads; ++idx)
+  {
+    (void)m_workers.emplace_back(&ReplyExecutor::WorkerLoop, this);
+  }
+}
+
+ReplyExecutor::~ReplyExecutor()
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_halt = true;
+  }
+  m_cv.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+void ReplyExecutor::Post(const Task& task)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_tasks.push_back(task);
+  }
+  m_cv.notify_one();
+}
+
+std::size_t ReplyExecutor::GetNumberOfThreads() const
+{
+  return m_workers.size();
+}
+
+void ReplyExecutor::WorkerLoop()
+{
+  auto pred = [this]() {
+    return !m_tasks.empty() || m_halt;
+  };
+  std::unique_lock<std::mutex> lk{m_mtx};
+  while (true)
+  {
+    m_cv.wait(lk, pred);
+    if (m_tasks.empty())
+    {
+      // Only exit when halted and all queued tasks were run:
+      break;
+    }
+    auto task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    lk.unlock();
+    task();
+    lk.lock();
+  }
+}
+
+ReplyExecutor& GetSharedReplyExecutor()
+{
+  static ReplyExecutor shared_executor{kDefaultReplyExecutorThreads};
+  return shared_executor;
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
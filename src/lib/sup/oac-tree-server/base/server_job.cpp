@@ -0,0 +1,394 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/server_job.h>
+
+#include <sup/oac-tree-server/automation_server.h>
+#include <sup/oac-tree-server/exceptions.h>
+
+#include <sup/oac-tree/job_states.h>
+#include <sup/oac-tree/local_job.h>
+
+#include <utility>
+
+namespace
+{
+bool IsIdleJobState(sup::oac_tree::JobState state);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree_server
+{
+using sup::oac_tree::LocalJob;
+
+struct ServerJob::Instance
+{
+  // The job needs to be destroyed before its ServerJobInfoIO:
+  std::unique_ptr<ServerJobInfoIO> m_job_info_io;
+  std::unique_ptr<LocalJob> m_job;
+  std::unique_ptr<const sup::oac_tree::JobInfo> m_job_info;
+  // Procedures recreated from the factory get a new generation when they are published:
+  bool m_new_generation;
+};
+
+ServerJob::ServerJob(const std::string& job_prefix, IAnyValueManager& av_manager,
+                     const ServerJobInfoIOConfig& job_info_io_config,
+                     std::unique_ptr<sup::oac_tree::Procedure> proc,
+                     const ProcedureFactory& factory, bool lazy,
+                     std::atomic<sup::dto::uint64>& next_generation)
+  : m_job_prefix{job_prefix}
+  , m_av_manager{av_manager}
+  , m_job_info_io_config{job_info_io_config}
+  , m_proc{std::move(proc)}
+  , m_factory{factory}
+  , m_next_generation{next_generation}
+  , m_generation{m_next_generation++}
+  , m_instance{}
+  , m_unpublished_instance{}
+  , m_prepared{}
+  , m_last_used{std::chrono::steady_clock::now().time_since_epoch().count()}
+  , m_torn_down{false}
+  , m_mtx{}
+  , m_breakpoint_mtx{}
+  , m_breakpoints{}
+{
+  if (!m_proc)
+  {
+    const std::string error = "ServerJob::ServerJob(): no procedure provided for job with prefix ["
+      + m_job_prefix + "]";
+    throw InvalidOperationException(error);
+  }
+  if (!lazy)
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    (void)InstantiateImpl();
+  }
+}
+
+ServerJob::~ServerJob() = default;
+
+bool ServerJob::IsInstantiated() const
+{
+  return static_cast<bool>(LoadInstance());
+}
+
+void ServerJob::Instantiate()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  (void)InstantiateImpl();
+}
+
+void ServerJob::Prepare()
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  if (m_torn_down)
+  {
+    const std::string error = "ServerJob::Prepare(): job with prefix [" + m_job_prefix
+      + "] was torn down";
+    throw InvalidOperationException(error);
+  }
+  if (m_prepared || LoadInstance())
+  {
+    return;
+  }
+  m_prepared = PrepareImpl();
+}
+
+sup::dto::uint64 ServerJob::GetGeneration() const
+{
+  return m_generation.load();
+}
+
+sup::oac_tree::JobInfo ServerJob::GetInfo()
+{
+  auto instance = Acquire();
+  return *instance->m_job_info;
+}
+
+sup::dto::uint32 ServerJob::GetNumberOfInstructions()
+{
+  auto instance = Acquire();
+  return instance->m_job_info->GetNumberOfInstructions();
+}
+
+OutputEntries ServerJob::GetOutputEntries(const OutputEntryIndices& last_indices) const
+{
+  auto instance = LoadInstance();
+  if (!instance)
+  {
+    return {};
+  }
+  return instance->m_job_info_io->GetOutputEntries(last_indices);
+}
+
+void ServerJob::EditBreakpoints(const std::set<sup::dto::uint32>& instr_indices,
+                                bool breakpoint_active)
+{
+  (void)Acquire();
+  std::lock_guard<std::mutex> lk{m_breakpoint_mtx};
+  for (auto instr_idx : instr_indices)
+  {
+    if (breakpoint_active)
+    {
+      (void)m_breakpoints.insert(instr_idx);
+    }
+    else
+    {
+      (void)m_breakpoints.erase(instr_idx);
+    }
+  }
+  // Instantiation publishes the job while holding the breakpoint lock, so the current instance
+  // either already has the previous breakpoints or will pick up the updated ones:
+  auto instance = LoadInstance();
+  if (!instance)
+  {
+    return true;
+  }
+  for (auto instr_idx : instr_indices)
+  {
+    if (breakpoint_active)
+    {
+      instance->m_job->SetBreakpoint(instr_idx);
+    }
+    else
+    {
+      instance->m_job->RemoveBreakpoint(instr_idx);
+    }
+  }
+}
+
+void ServerJob::SendJobCommand(sup::oac_tree::JobCommand command)
+{
+  using sup::oac_tree::JobCommand;
+  auto instance = Acquire();
+  auto& job = *instance->m_job;
+  switch (command)
+  {
+  case JobCommand::kStart:
+    job.Start();
+    break;
+  case JobCommand::kStep:
+    job.Step();
+    break;
+  case JobCommand::kPause:
+    job.Pause();
+    break;
+  case JobCommand::kReset:
+    job.Reset();
+    break;
+  case JobCommand::kHalt:
+    job.Halt();
+    break;
+  default:
+    {
+      const std::string error = "ServerJob::SendJobCommand(): unknown command enumerator ["
+        + std::to_string(static_cast<int>(command)) + "]";
+      throw InvalidOperationException(error);
+    }
+  }
+}
+
+bool ServerJob::TearDownIfIdle(std::chrono::steady_clock::duration idle_timeout)
+{
+  // The lock is held during teardown, so the job cannot be instantiated again before its values
+  // were released:
+  std::lock_guard<std::mutex> lk{m_mtx};
+  if (!m_factory)
+  {
+    return false;
+  }
+  auto instance = std::atomic_exchange(&m_instance, std::shared_ptr<Instance>{});
+  if (!instance)
+  {
+    return false;
+  }
+  // Once unpublished, a use count larger than one means that a request still uses the instance.
+  // Requests record their use before loading the instance, so checking the last use and job state
+  // afterwards cannot miss a request that loaded it before:
+  auto last_used = std::chrono::steady_clock::time_point(
+    std::chrono::steady_clock::duration(m_last_used.load()));
+  if (instance.use_count() > 1 || std::chrono::steady_clock::now() - last_used < idle_timeout
+      || !IsIdleJobState(instance->m_job_info_io->GetJobState()))
+  {
+    std::atomic_store(&m_instance, std::move(instance));
+    return false;
+  }
+  // No request uses the instance, so releasing it hands back its owner immediately:
+  instance.reset();
+  auto owner = m_unpublished_instance.get();
+  // Values that could not be released make the next instantiation fail, which reports the error:
+  (void)ReleaseInstance(*owner);
+  return true;
+}
+
+bool ServerJob::TearDown()
+{
+  std::shared_ptr<Instance> instance;
+  std::future<std::shared_ptr<Instance>> unpublished_instance;
+  std::shared_ptr<Instance> prepared;
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_torn_down = true;
+    instance = std::atomic_exchange(&m_instance, std::shared_ptr<Instance>{});
+    unpublished_instance = std::move(m_unpublished_instance);
+    prepared = std::move(m_prepared);
+  }
+  // A prepared instance never published its values:
+  if (prepared)
+  {
+    prepared->m_job.reset();
+  }
+  if (!instance)
+  {
+    return;
+  }
+  // Requests that loaded the instance before, only use it briefly. The owner is handed back when
+  // the last of them released it:
+  instance.reset();
+  auto owner = unpublished_instance.get();
+  return ReleaseInstance(*owner);
+}
+
+std::shared_ptr<ServerJob::Instance> ServerJob::LoadInstance() const
+{
+  return std::atomic_load(&m_instance);
+}
+
+std::shared_ptr<ServerJob::Instance> ServerJob::Acquire()
+{
+  m_last_used.store(std::chrono::steady_clock::now().time_since_epoch().count());
+  auto instance = LoadInstance();
+  if (instance)
+  {
+    return instance;
+  }
+  std::lock_guard<std::mutex> lk{m_mtx};
+  return InstantiateImpl();
+}
+
+std::shared_ptr<ServerJob::Instance> ServerJob::InstantiateImpl()
+{
+  if (m_torn_down)
+  {
+    const std::string error = "ServerJob::InstantiateImpl(): job with prefix [" + m_job_prefix
+      + "] was torn down";
+    throw InvalidOperationException(error);
+  }
+  // Another request may have instantiated the job while waiting for the lock:
+  auto current = LoadInstance();
+  if (current)
+  {
+    return current;
+  }
+  if (!m_prepared)
+  {
+    m_prepared = PrepareImpl();
+  }
+  // A prepared instance is kept when publishing fails, so publishing is retried on next use:
+  m_prepared->m_job_info_io->PublishAnyValues();
+  auto instance = std::move(m_prepared);
+  std::lock_guard<std::mutex> breakpoint_lk{m_breakpoint_mtx};
+  // A procedure recreated from the factory may have fewer instructions:
+  auto n_instr = instance->m_job_info->GetNumberOfInstructions();
+  (void)m_breakpoints.erase(m_breakpoints.lower_bound(n_instr), m_breakpoints.end());
+  for (auto instr_idx : m_breakpoints)
+  {
+    instance->m_job->SetBreakpoint(instr_idx);
+  }
+  if (instance->m_new_generation)
+  {
+    m_generation.store(m_next_generation++);
+  }
+  // The published instance only shares the owner with its deleter, which hands the owner back
+  // when the last request released it. This allows teardown to wait for requests without polling:
+  auto handback = std::make_shared<std::promise<std::shared_ptr<Instance>>>();
+  m_unpublished_instance = handback->get_future();
+  std::shared_ptr<Instance> published{instance.get(), [instance, handback](Instance*) {
+    handback->set_value(instance);
+  }};
+  std::atomic_store(&m_instance, published);
+  return published;
+}
+
+std::shared_ptr<ServerJob::Instance> ServerJob::PrepareImpl()
+{
+  bool new_generation = false;
+  auto proc = std::move(m_proc);
+  if (!proc)
+  {
+    if (!m_factory)
+    {
+      const std::string error = "ServerJob::PrepareImpl(): no procedure left to instantiate job "
+        "with prefix [" + m_job_prefix + "]";
+      throw InvalidOperationException(error);
+    }
+    proc = m_factory();
+    if (!proc)
+    {
+      const std::string error = "ServerJob::PrepareImpl(): procedure factory did not return a "
+        "procedure for job with prefix [" + m_job_prefix + "]";
+      throw InvalidOperationException(error);
+    }
+    new_generation = true;
+  }
+  auto n_vars = GetNumberOfVariables(*proc);
+  auto instance = std::make_shared<Instance>();
+  // Nothing is published until the instance is published, so the values of the job do not need
+  // to be released when setting up the procedure fails:
+  instance->m_job_info_io = std::make_unique<ServerJobInfoIO>(m_job_prefix, n_vars, m_av_manager,
+                                                              m_job_info_io_config, false);
+  instance->m_job = std::make_unique<LocalJob>(std::move(proc), *instance->m_job_info_io);
+  instance->m_job_info = std::make_unique<sup::oac_tree::JobInfo>(instance->m_job->GetInfo());
+  instance->m_new_generation = new_generation;
+  return instance;
+}
+
+bool ServerJob::ReleaseInstance(Instance& instance) const
+{
+  instance.m_job.reset();
+  return instance.m_job_info_io->ReleaseAnyValues();
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+namespace
+{
+bool IsIdleJobState(sup::oac_tree::JobState state)
+{
+  using sup::oac_tree::JobState;
+  switch (state)
+  {
+  case JobState::kInitial:
+  case JobState::kSucceeded:
+  case JobState::kFailed:
+  case JobState::kHalted:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+}  // unnamed namespace
@@ -23,12 +23,15 @@
 #include <sup/oac-tree-server/server_job_info_io.h>
 
 #include <sup/oac-tree-server/anyvalue_io_helper.h>
+#include <sup/oac-tree-server/exceptions.h>
 #include <sup/oac-tree-server/input_request_helper.h>
 #include <sup/oac-tree-server/output_entry_helper.h>
 #include <sup/oac-tree-server/output_entry_types.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/variable_delta_helper.h>
 
 #include <sup/dto/anyvalue_helper.h>
+#include <sup/oac-tree/log_severity.h>
 #include <sup/oac-tree/user_input_reply.h>
 
 namespace sup
@@ -39,25 +42,116 @@ using sup::oac_tree::InstructionState;
 
 ServerJobInfoIO::ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
                                  IAnyValueManager& av_manager)
+  : ServerJobInfoIO{job_prefix, n_vars, av_manager, ServerJobInfoIOConfig{}}
+{}
+
+ServerJobInfoIO::ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
+                                 IAnyValueManager& av_manager,
+                                 const ServerJobInfoIOConfig& config)
+  : ServerJobInfoIO{job_prefix, n_vars, av_manager, config, true}
+{}
+
+ServerJobInfoIO::ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
+                                 IAnyValueManager& av_manager,
+                                 const ServerJobInfoIOConfig& config, bool publish)
   : m_job_prefix{job_prefix}
   , m_n_vars{n_vars}
+  , m_n_instr{0}
+  , m_job_state{sup::oac_tree::JobState::kInitial}
   , m_av_manager{av_manager}
   , m_log_idx_gen{}
   , m_msg_idx_gen{}
   , m_out_val_idx_gen{}
+  , m_output_entry_history{config.m_output_entry_history_size}
+  , m_delta_encoders{}
+  , m_delta_mtx{}
+  , m_entry_batcher{}
+  , m_user_input_timeout{config.m_user_input_timeout_ms}
+  , m_published{false}
+  , m_publish_mtx{}
+  , m_unpublished_variables{}
 {
-  InitializeJobAndVariables(m_av_manager, m_job_prefix, m_n_vars);
+  if (config.m_variable_keyframe_interval > 0)
+  {
+    m_delta_encoders.reserve(m_n_vars);
+    for (sup::dto::uint32 idx = 0; idx < m_n_vars; ++idx)
+    {
+      (void)m_delta_encoders.emplace_back(config.m_variable_keyframe_interval);
+    }
+  }
+  if (publish)
+  {
+    if (!PublishInitialValues())
+    {
+      const std::string error = "ServerJobInfoIO::ServerJobInfoIO(): could not publish the values "
+        "of job with prefix [" + m_job_prefix + "]";
+      throw InvalidOperationException(error);
+    }
+    m_published = true;
+  }
+  if (config.m_entry_batch_interval_ms > 0)
+  {
+    auto log_batch_func = [this](const std::vector<LogEntry>& log_entries) {
+      auto log_val_name = GetLogEntryName(m_job_prefix);
+      (void)m_av_manager.UpdateAnyValue(log_val_name, EncodeLogEntryBatch(log_entries));
+    };
+    auto msg_batch_func = [this](const std::vector<MessageEntry>& msg_entries) {
+      auto msg_val_name = GetMessageEntryName(m_job_prefix);
+      (void)m_av_manager.UpdateAnyValue(msg_val_name, EncodeMessageEntryBatch(msg_entries));
+    };
+    m_entry_batcher = std::make_unique<OutputEntryBatcher>(
+      std::chrono::milliseconds(config.m_entry_batch_interval_ms), config.m_entry_batch_size,
+      log_batch_func, msg_batch_func);
+  }
 }
 
 ServerJobInfoIO::~ServerJobInfoIO() = default;
 
+void ServerJobInfoIO::PublishAnyValues()
+{
+  std::lock_guard<std::mutex> lk{m_publish_mtx};
+  if (m_published)
+  {
+    return;
+  }
+  if (!PublishInitialValues())
+  {
+    const std::string error = "ServerJobInfoIO::PublishAnyValues(): could not publish the values "
+      "of job with prefix [" + m_job_prefix + "]";
+    throw InvalidOperationException(error);
+  }
+  auto job_state_name = GetJobStatePVName(m_job_prefix);
+  (void)m_av_manager.UpdateAnyValue(job_state_name, GetJobStateValue(m_job_state.load()));
+  for (const auto& [var_idx, var_value] : m_unpublished_variables)
+  {
+    PublishVariable(var_idx, var_value.first, var_value.second);
+  }
+  m_unpublished_variables.clear();
+  m_published = true;
+}
+
 void ServerJobInfoIO::InitNumberOfInstructions(sup::dto::uint32 n_instr)
 {
-  InitializeInstructions(m_av_manager, m_job_prefix, n_instr);
+  std::lock_guard<std::mutex> lk{m_publish_mtx};
+  m_n_instr.store(n_instr);
+  if (!m_published)
+  {
+    // The instruction values are added together with the other values:
+    return;
+  }
+  if (!InitializeInstructions(m_av_manager, m_job_prefix, n_instr))
+  {
+    Log(sup::oac_tree::log::SUP_SEQ_LOG_ERR,
+        "Could not publish the instruction states of job with prefix [" + m_job_prefix + "]");
+  }
 }
 
 void ServerJobInfoIO::InstructionStateUpdated(sup::dto::uint32 instr_idx, InstructionState state)
 {
+  if (!m_published)
+  {
+    return;
+  }
   auto instr_val_name = GetInstructionPVName(m_job_prefix, instr_idx);
   auto instr_state_av = ToAnyValue(state);
   (void)m_av_manager.UpdateAnyValue(instr_val_name, instr_state_av);
@@ -65,6 +159,10 @@ void ServerJobInfoIO::InstructionStateUpdated(sup::dto::uint32 instr_idx, Instru
 
 void ServerJobInfoIO::BreakpointInstructionUpdated(sup::dto::uint32 instr_idx)
 {
+  if (!m_published)
+  {
+    return;
+  }
   auto breakpoint_instr_name = GetBreakpointInstructionPVName(m_job_prefix);
   auto breakpoint_instr_av = GetBreakpointInstructionValue(instr_idx);
   (void)m_av_manager.UpdateAnyValue(breakpoint_instr_name, breakpoint_instr_av);
@@ -72,14 +170,50 @@ void ServerJobInfoIO::BreakpointInstructionUpdated(sup::dto::uint32 instr_idx)
 
 void ServerJobInfoIO::VariableUpdated(sup::dto::uint32 var_idx, const sup::dto::AnyValue& value,
                                       bool connected)
+{
+  if (!m_published)
+  {
+    std::lock_guard<std::mutex> lk{m_publish_mtx};
+    if (!m_published)
+    {
+      m_unpublished_variables[var_idx] = { value, connected };
+      return;
+    }
+  }
+  PublishVariable(var_idx, value, connected);
+}
+
+void ServerJobInfoIO::PublishVariable(sup::dto::uint32 var_idx, const sup::dto::AnyValue& value,
+                                      bool connected)
 {
   auto var_val_name = GetVariablePVName(m_job_prefix, var_idx);
-  auto var_info = EncodeVariableState(value, connected);
+  if (var_idx >= m_delta_encoders.size())
+  {
+    auto var_info = EncodeVariableState(value, connected);
+    (void)m_av_manager.UpdateAnyValue(var_val_name, var_info);
+    return;
+  }
+  // The lock ensures that the order of encoded updates is the order of publishing:
+  std::lock_guard<std::mutex> lk{m_delta_mtx};
+  auto var_info = m_delta_encoders[var_idx].Encode(value, connected);
+  if (!IsVariableDelta(var_info))
+  {
+    // Keyframes are also published on a separate channel, which is never coalesced, so that late
+    // joining clients and clients that missed a keyframe can still decode the deltas:
+    auto keyframe_name = GetVariableKeyframePVName(var_val_name);
+    (void)m_av_manager.UpdateAnyValue(keyframe_name, var_info);
+  }
   (void)m_av_manager.UpdateAnyValue(var_val_name, var_info);
 }
 
 void ServerJobInfoIO::JobStateUpdated(sup::oac_tree::JobState state)
 {
+  std::lock_guard<std::mutex> lk{m_publish_mtx};
+  m_job_state.store(state);
+  if (!m_published)
+  {
+    return;
+  }
   auto job_state_name = GetJobStatePVName(m_job_prefix);
   auto job_state_value = GetJobStateValue(state);
   (void)m_av_manager.UpdateAnyValue(job_state_name, job_state_value);
@@ -90,6 +224,11 @@ void ServerJobInfoIO::PutValue(const sup::dto::AnyValue& value, const std::strin
   auto idx = m_out_val_idx_gen.NewIndex();
   auto out_val_name = GetOutputValueEntryName(m_job_prefix);
   OutputValueEntry out_val{ idx, description, value };
+  m_output_entry_history.AddOutputValueEntry(out_val);
+  if (!m_published)
+  {
+    return;
+  }
   (void)m_av_manager.UpdateAnyValue(out_val_name, EncodeOutputValueEntry(out_val));
 }
 
@@ -97,8 +236,7 @@ bool ServerJobInfoIO::GetUserValue(sup::dto::uint64 id, sup::dto::AnyValue& valu
                                    const std::string& description)
 {
   auto input_request = sup::oac_tree::CreateUserValueRequest(value, description);
-  auto input_server_name = GetInputServerName(m_job_prefix);
-  auto response = m_av_manager.GetUserInput(input_server_name, id, input_request);
+  auto response = GetUserInput(id, input_request);
   auto [parsed, reply] = sup::oac_tree::ParseUserValueReply(response);
   if (!parsed)
   {
@@ -116,8 +254,7 @@ int ServerJobInfoIO::GetUserChoice(sup::dto::uint64 id, const std::vector<std::s
                                    const sup::dto::AnyValue& metadata)
 {
   auto input_request = sup::oac_tree::CreateUserChoiceRequest(options, metadata);
-  auto input_server_name = GetInputServerName(m_job_prefix);
-  auto response = m_av_manager.GetUserInput(input_server_name, id, input_request);
+  auto response = GetUserInput(id, input_request);
   auto [parsed, reply] = ParseUserChoiceReply(response);
   if (!parsed)
   {
@@ -137,6 +274,16 @@ void ServerJobInfoIO::Message(const std::string& message)
   auto idx = m_msg_idx_gen.NewIndex();
   auto msg_val_name = GetMessageEntryName(m_job_prefix);
   MessageEntry msg_val{ idx, message };
+  m_output_entry_history.AddMessageEntry(msg_val);
+  if (!m_published)
+  {
+    return;
+  }
+  if (m_entry_batcher)
+  {
+    m_entry_batcher->AddMessageEntry(msg_val);
+    return;
+  }
   (void)m_av_manager.UpdateAnyValue(msg_val_name, EncodeMessageEntry(msg_val));
 }
 
@@ -145,6 +292,16 @@ void ServerJobInfoIO::Log(int severity, const std::string& message)
   auto idx = m_log_idx_gen.NewIndex();
   auto log_val_name = GetLogEntryName(m_job_prefix);
   LogEntry log_val{ idx, severity, message };
+  m_output_entry_history.AddLogEntry(log_val);
+  if (!m_published)
+  {
+    return;
+  }
+  if (m_entry_batcher)
+  {
+    m_entry_batcher->AddLogEntry(log_val);
+    return;
+  }
   (void)m_av_manager.UpdateAnyValue(log_val_name, EncodeLogEntry(log_val));
 }
 
@@ -152,6 +309,100 @@ void ServerJobInfoIO::Log(int severity, const std::string& message)
 void ServerJobInfoIO::ProcedureTicked()
 {}
 
+OutputEntries ServerJobInfoIO::GetOutputEntries(const OutputEntryIndices& last_indices) const
+{
+  return m_output_entry_history.GetEntriesAfter(last_indices);
+}
+
+sup::oac_tree::JobState ServerJobInfoIO::GetJobState() const
+{
+  return m_job_state.load();
+}
+
+bool ServerJobInfoIO::ReleaseAnyValues()
+{
+  if (!m_published)
+  {
+    // The names may still be in use by another job:
+    return true;
+  }
+  // Pending batches need to be published before their values are removed:
+  m_entry_batcher.reset();
+  auto job_value_names = GetNames(GetInitialValueSet(m_job_prefix, m_n_vars));
+  bool result = m_av_manager.RemoveAnyValues(job_value_names);
+  if (!m_delta_encoders.empty())
+  {
+    auto keyframe_names = GetNames(GetVariableKeyframeValueSet(m_job_prefix, m_n_vars));
+    result = m_av_manager.RemoveAnyValues(keyframe_names) && result;
+  }
+  auto n_instr = m_n_instr.load();
+  if (n_instr > 0)
+  {
+    auto instr_value_names = GetNames(GetInstructionValueSet(m_job_prefix, n_instr));
+    result = m_av_manager.RemoveAnyValues(instr_value_names) && result;
+  }
+  auto input_server_name = GetInputServerName(m_job_prefix);
+  result = m_av_manager.RemoveInputHandler(input_server_name) && result;
+  return result;
+}
+
+bool ServerJobInfoIO::PublishInitialValues()
+{
+  // Values that were already added are removed again when a later step fails, so the values of
+  // this job can be published again later:
+  auto job_value_set = GetInitialValueSet(m_job_prefix, m_n_vars);
+  if (!m_av_manager.AddAnyValues(job_value_set))
+  {
+    return false;
+  }
+  auto input_server_name = GetInputServerName(m_job_prefix);
+  if (!m_av_manager.AddInputHandler(input_server_name))
+  {
+    (void)m_av_manager.RemoveAnyValues(GetNames(job_value_set));
+    return false;
+  }
+  if (!m_delta_encoders.empty() &&
+      !m_av_manager.AddAnyValues(GetVariableKeyframeValueSet(m_job_prefix, m_n_vars)))
+  {
+    (void)m_av_manager.RemoveInputHandler(input_server_name);
+    (void)m_av_manager.RemoveAnyValues(GetNames(job_value_set));
+    return false;
+  }
+  // Only a job that was set up before publishing knows its instructions already:
+  auto n_instr = m_n_instr.load();
+  if (n_instr > 0 && !InitializeInstructions(m_av_manager, m_job_prefix, n_instr))
+  {
+    if (!m_delta_encoders.empty())
+    {
+      (void)m_av_manager.RemoveAnyValues(
+        GetNames(GetVariableKeyframeValueSet(m_job_prefix, m_n_vars)));
+    }
+    (void)m_av_manager.RemoveInputHandler(input_server_name);
+    (void)m_av_manager.RemoveAnyValues(GetNames(job_value_set));
+    return false;
+  }
+  return true;
+}
+
+UserInputReply ServerJobInfoIO::GetUserInput(sup::dto::uint64 id,
+                                             const UserInputRequest& request)
+{
+  auto input_server_name = GetInputServerName(m_job_prefix);
+  if (m_user_input_timeout.count() == 0)
+  {
+    return m_av_manager.GetUserInput(input_server_name, id, request);
+  }
+  auto deadline = std::chrono::steady_clock::now() + m_user_input_timeout;
+  auto [status, reply] = m_av_manager.GetUserInputUntil(input_server_name, id, request, deadline);
+  if (status == UserInputStatus::kTimedOut)
+  {
+    Log(sup::oac_tree::log::SUP_SEQ_LOG_WARNING,
+        "User input request " + std::to_string(id) + " timed out after " +
+        std::to_string(m_user_input_timeout.count()) + " ms");
+  }
+  return reply;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/server_job_table.h>
+
+#include <sup/oac-tree-server/exceptions.h>
+
+#include <string>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+ServerJobTable::ServerJobTable()
+  : m_chunks{}
+  , m_size{0}
+  , m_write_mtx{}
+{
+  for (auto& chunk : m_chunks)
+  {
+    chunk.store(nullptr);
+  }
+}
+
+ServerJobTable::~ServerJobTable()
+{
+  for (auto& chunk : m_chunks)
+  {
+    delete chunk.load();
+  }
+}
+
+sup::dto::uint32 ServerJobTable::GetSize() const
+{
+  return m_size.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<ServerJob> ServerJobTable::Get(sup::dto::uint32 idx) const
+{
+  if (idx >= GetSize())
+  {
+    return {};
+  }
+  return std::atomic_load(GetSlot(idx));
+}
+
+std::vector<std::shared_ptr<ServerJob>> ServerJobTable::GetAll() const
+{
+  auto size = GetSize();
+  std::vector<std::shared_ptr<ServerJob>> result;
+  result.reserve(size);
+  for (sup::dto::uint32 idx = 0; idx < size; ++idx)
+  {
+    result.push_back(std::atomic_load(GetSlot(idx)));
+  }
+  return result;
+}
+
+sup::dto::uint32 ServerJobTable::Append(std::shared_ptr<ServerJob> job)
+{
+  std::lock_guard<std::mutex> lk{m_write_mtx};
+  auto idx = m_size.load();
+  auto chunk_idx = idx / kChunkSize;
+  if (chunk_idx >= kMaxChunks)
+  {
+    const std::string error = "ServerJobTable::Append(): maximum number of jobs ("
+      + std::to_string(kChunkSize * kMaxChunks) + ") reached";
+    throw InvalidOperationException(error);
+  }
+  if (m_chunks[chunk_idx].load() == nullptr)
+  {
+    m_chunks[chunk_idx].store(new Chunk{}, std::memory_order_release);
+  }
+  std::atomic_store(GetSlot(idx), std::move(job));
+  // Publishing the new size makes the job visible to readers:
+  m_size.store(idx + 1, std::memory_order_release);
+  return idx;
+}
+
+std::shared_ptr<ServerJob> ServerJobTable::Exchange(sup::dto::uint32 idx,
+                                                    std::shared_ptr<ServerJob> job)
+{
+  std::lock_guard<std::mutex> lk{m_write_mtx};
+  if (idx >= GetSize())
+  {
+    const std::string error = "ServerJobTable::Exchange(): index out of bounds; requesting "
+      + std::to_string(idx) + " out of " + std::to_string(GetSize()) + " jobs";
+    throw InvalidOperationException(error);
+  }
+  return std::atomic_exchange(GetSlot(idx), std::move(job));
+}
+
+std::shared_ptr<ServerJob>* ServerJobTable::GetSlot(sup::dto::uint32 idx) const
+{
+  // Chunks are published before the size that covers them and are never relocated:
+  auto chunk = m_chunks[idx / kChunkSize].load(std::memory_order_acquire);
+  return &(*chunk)[idx % kChunkSize];
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/variable_delta_codec.h>
+
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+
+#include <sup/oac-tree/anyvalue_utils.h>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+VariableDeltaEncoder::VariableDeltaEncoder(sup::dto::uint32 keyframe_interval)
+  : m_keyframe_interval{keyframe_interval}
+  , m_keyframe{}
+  , m_keyframe_seq{0}
+  , m_seq{0}
+{}
+
+VariableDeltaEncoder::~VariableDeltaEncoder() = default;
+
+sup::dto::AnyValue VariableDeltaEncoder::Encode(const sup::dto::AnyValue& value, bool connected)
+{
+  ++m_seq;
+  if (m_keyframe_seq > 0 && m_seq - m_keyframe_seq < m_keyframe_interval)
+  {
+    auto [compatible, changes] = GetLeafChanges(m_keyframe, value);
+    if (compatible)
+    {
+      VariableDelta delta{ connected, m_seq, m_keyframe_seq, changes };
+      return EncodeVariableDelta(delta);
+    }
+  }
+  m_keyframe = value;
+  m_keyframe_seq = m_seq;
+  return EncodeVariableKeyframe(value, connected, m_seq);
+}
+
+VariableDeltaDecoder::VariableDeltaDecoder()
+  : m_has_keyframe{false}
+  , m_keyframe{}
+  , m_keyframe_seq{0}
+  , m_has_pending_delta{false}
+  , m_pending_delta{}
+{}
+
+VariableDeltaDecoder::~VariableDeltaDecoder() = default;
+
+std::pair<sup::dto::AnyValue, bool> VariableDeltaDecoder::Decode(const sup::dto::AnyValue& encoded)
+{
+  if (IsVariableDelta(encoded))
+  {
+    auto [decoded, delta] = DecodeVariableDelta(encoded);
+    if (!decoded)
+    {
+      return { {}, false };
+    }
+    if (m_has_keyframe && delta.m_base == m_keyframe_seq)
+    {
+      return ApplyDelta(delta);
+    }
+    if (!m_has_keyframe || delta.m_base > m_keyframe_seq)
+    {
+      // Its keyframe may still arrive through DecodeKeyframe:
+      m_has_pending_delta = true;
+      m_pending_delta = delta;
+    }
+    return { {}, false };
+  }
+  auto result = DecodeVariableState(encoded);
+  if (!sup::dto::IsEmptyValue(result.first) &&
+      sup::oac_tree::utils::ValidateMemberType(encoded, kVariableSequenceField,
+                                               sup::dto::UnsignedInteger64Type))
+  {
+    StoreKeyframe(result.first, encoded[kVariableSequenceField].As<sup::dto::uint64>());
+  }
+  return result;
+}
+
+std::pair<sup::dto::AnyValue, bool> VariableDeltaDecoder::DecodeKeyframe(
+  const sup::dto::AnyValue& encoded)
+{
+  auto keyframe = DecodeVariableState(encoded);
+  if (sup::dto::IsEmptyValue(keyframe.first) ||
+      !sup::oac_tree::utils::ValidateMemberType(encoded, kVariableSequenceField,
+                                                sup::dto::UnsignedInteger64Type))
+  {
+    return { {}, false };
+  }
+  auto seq = encoded[kVariableSequenceField].As<sup::dto::uint64>();
+  if (m_has_keyframe && seq <= m_keyframe_seq)
+  {
+    return { {}, false };
+  }
+  StoreKeyframe(keyframe.first, seq);
+  if (!m_has_pending_delta || m_pending_delta.m_base != seq)
+  {
+    return { {}, false };
+  }
+  m_has_pending_delta = false;
+  return ApplyDelta(m_pending_delta);
+}
+
+void VariableDeltaDecoder::StoreKeyframe(const sup::dto::AnyValue& value, sup::dto::uint64 seq)
+{
+  if (m_has_keyframe && seq < m_keyframe_seq)
+  {
+    return;
+  }
+  m_has_keyframe = true;
+  m_keyframe = value;
+  m_keyframe_seq = seq;
+  // A pending delta of an older keyframe was superseded by this keyframe:
+  if (m_has_pending_delta && m_pending_delta.m_base < seq)
+  {
+    m_has_pending_delta = false;
+  }
+}
+
+std::pair<sup::dto::AnyValue, bool> VariableDeltaDecoder::ApplyDelta(
+  const VariableDelta& delta) const
+{
+  auto value = m_keyframe;
+  if (!ApplyLeafChanges(value, delta.m_changes))
+  {
+    return { {}, false };
+  }
+  return { value, delta.m_connected };
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
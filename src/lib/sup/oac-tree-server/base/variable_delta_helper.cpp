@@ -0,0 +1,234 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/variable_delta_helper.h>
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+
+#include <sup/oac-tree/anyvalue_utils.h>
+
+#include <exception>
+#include <string>
+
+namespace
+{
+using sup::oac_tree_server::LeafChanges;
+
+bool CollectLeafChanges(const sup::dto::AnyValue& from, const sup::dto::AnyValue& to,
+                        const std::string& path, LeafChanges& changes);
+
+sup::dto::AnyValue* GetLeaf(sup::dto::AnyValue& value, const std::string& path);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree_server
+{
+using sup::oac_tree::utils::ValidateMemberType;
+
+std::pair<bool, LeafChanges> GetLeafChanges(const sup::dto::AnyValue& from,
+                                            const sup::dto::AnyValue& to)
+{
+  LeafChanges changes;
+  if (!CollectLeafChanges(from, to, "", changes))
+  {
+    return { false, {} };
+  }
+  return { true, changes };
+}
+
+bool ApplyLeafChanges(sup::dto::AnyValue& value, const LeafChanges& changes)
+{
+  try
+  {
+    for (const auto& [path, leaf_value] : changes)
+    {
+      auto leaf = GetLeaf(value, path);
+      if (leaf == nullptr)
+      {
+        return false;
+      }
+      *leaf = leaf_value;
+    }
+  }
+  catch(const std::exception&)
+  {
+    return false;
+  }
+  return true;
+}
+
+sup::dto::AnyValue EncodeVariableKeyframe(const sup::dto::AnyValue& value, bool connected,
+                                          sup::dto::uint64 seq)
+{
+  auto result = EncodeVariableState(value, connected);
+  (void)result.AddMember(kVariableSequenceField,
+                         sup::dto::AnyValue{sup::dto::UnsignedInteger64Type, seq});
+  return result;
+}
+
+sup::dto::AnyValue EncodeVariableDelta(const VariableDelta& delta)
+{
+  auto changes = sup::dto::EmptyStruct();
+  for (std::size_t idx = 0; idx < delta.m_changes.size(); ++idx)
+  {
+    const auto& [path, leaf_value] = delta.m_changes[idx];
+    sup::dto::AnyValue change = {{
+      { kVariableChangePathField, path },
+      { kVariableChangeValueField, leaf_value }
+    }};
+    (void)changes.AddMember("c" + std::to_string(idx), change);
+  }
+  sup::dto::AnyValue result = {{
+    { kVariableConnectedField, delta.m_connected },
+    { kVariableSequenceField, { sup::dto::UnsignedInteger64Type, delta.m_seq }},
+    { kVariableDeltaBaseField, { sup::dto::UnsignedInteger64Type, delta.m_base }},
+    { kVariableDeltaChangesField, changes }
+  }, kVariableDeltaType };
+  return result;
+}
+
+bool IsVariableDelta(const sup::dto::AnyValue& encoded)
+{
+  return ValidateMemberType(encoded, kVariableDeltaBaseField, sup::dto::UnsignedInteger64Type);
+}
+
+bool IsSequencedVariableState(const sup::dto::AnyValue& encoded)
+{
+  return ValidateMemberType(encoded, kVariableSequenceField, sup::dto::UnsignedInteger64Type);
+}
+
+std::pair<bool, VariableDelta> DecodeVariableDelta(const sup::dto::AnyValue& encoded)
+{
+  if (!ValidateMemberType(encoded, kVariableConnectedField, sup::dto::BooleanType) ||
+      !ValidateMemberType(encoded, kVariableSequenceField, sup::dto::UnsignedInteger64Type) ||
+      !ValidateMemberType(encoded, kVariableDeltaBaseField, sup::dto::UnsignedInteger64Type) ||
+      !encoded.HasField(kVariableDeltaChangesField))
+  {
+    return { false, {} };
+  }
+  VariableDelta result{};
+  result.m_connected = encoded[kVariableConnectedField].As<sup::dto::boolean>();
+  result.m_seq = encoded[kVariableSequenceField].As<sup::dto::uint64>();
+  result.m_base = encoded[kVariableDeltaBaseField].As<sup::dto::uint64>();
+  const auto& changes = encoded[kVariableDeltaChangesField];
+  if (!sup::dto::IsStructValue(changes))
+  {
+    return { false, {} };
+  }
+  for (const auto& member_name : changes.MemberNames())
+  {
+    const auto& change = changes[member_name];
+    if (!ValidateMemberType(change, kVariableChangePathField, sup::dto::StringType) ||
+        !change.HasField(kVariableChangeValueField))
+    {
+      return { false, {} };
+    }
+    (void)result.m_changes.emplace_back(change[kVariableChangePathField].As<std::string>(),
+                                        change[kVariableChangeValueField]);
+  }
+  return { true, result };
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+namespace
+{
+bool CollectLeafChanges(const sup::dto::AnyValue& from, const sup::dto::AnyValue& to,
+                        const std::string& path, LeafChanges& changes)
+{
+  if (from.GetType() != to.GetType())
+  {
+    return false;
+  }
+  if (sup::dto::IsStructValue(to))
+  {
+    for (const auto& member_name : to.MemberNames())
+    {
+      auto member_path = path.empty() ? member_name : path + "." + member_name;
+      if (!CollectLeafChanges(from[member_name], to[member_name], member_path, changes))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (sup::dto::IsArrayValue(to))
+  {
+    for (std::size_t idx = 0; idx < to.NumberOfElements(); ++idx)
+    {
+      auto element_path = path + "[" + std::to_string(idx) + "]";
+      if (!CollectLeafChanges(from[idx], to[idx], element_path, changes))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (from != to)
+  {
+    (void)changes.emplace_back(path, to);
+  }
+  return true;
+}
+
+sup::dto::AnyValue* GetLeaf(sup::dto::AnyValue& value, const std::string& path)
+{
+  auto result = &value;
+  std::size_t pos = 0;
+  while (pos < path.size())
+  {
+    if (path[pos] == '.')
+    {
+      ++pos;
+      continue;
+    }
+    if (path[pos] == '[')
+    {
+      auto end_pos = path.find(']', pos);
+      if (end_pos == std::string::npos || !sup::dto::IsArrayValue(*result))
+      {
+        return nullptr;
+      }
+      auto idx = std::stoul(path.substr(pos + 1, end_pos - pos - 1));
+      if (idx >= result->NumberOfElements())
+      {
+        return nullptr;
+      }
+      result = &(*result)[idx];
+      pos = end_pos + 1;
+      continue;
+    }
+    auto end_pos = path.find_first_of(".[", pos);
+    auto member_name = path.substr(pos, end_pos - pos);
+    if (!sup::dto::IsStructValue(*result) || !result->HasField(member_name))
+    {
+      return nullptr;
+    }
+    result = &(*result)[member_name];
+    pos = end_pos == std::string::npos ? path.size() : end_pos;
+  }
+  return result;
+}
+
+}  // unnamed namespace
@@ -62,6 +62,20 @@ public:
   void Reset() override;
   void Halt() override;
 
+  /**
+   * @brief Set breakpoints for multiple instructions in a single request to the job manager.
+   *
+   * @param instr_indices Indices of the instructions.
+   */
+  void SetBreakpoints(const std::set<sup::dto::uint32>& instr_indices);
+
+  /**
+   * @brief Remove breakpoints for multiple instructions in a single request to the job manager.
+   *
+   * @param instr_indices Indices of the instructions.
+   */
+  void RemoveBreakpoints(const std::set<sup::dto::uint32>& instr_indices);
+
 private:
   std::unique_ptr<ClientJobImpl> m_impl;
 };
@@ -23,14 +23,14 @@
 #ifndef SUP_OAC_TREE_SERVER_CLIENT_REPLY_DELEGATOR_H_
 #define SUP_OAC_TREE_SERVER_CLIENT_REPLY_DELEGATOR_H_
 
+#include <sup/oac-tree-server/reply_executor.h>
+
 #include <sup/oac-tree/user_input_reply.h>
 
-#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <mutex>
-#include <thread>
 
 namespace sup
 {
@@ -42,6 +42,11 @@ using sup::oac_tree::UserInputReply;
  * @brief ClientReplyDelegator delegates a call to reply to user input to a separate thread. This
  * is required to avoid deadlocks in case of network implementations that are not lock-free, e.g.
  * EPICS.
+ *
+ * @details Replies are delivered on the threads of a ReplyExecutor, which can be shared between
+ * many delegators. Replies queued to the same delegator are delivered one at a time and in order,
+ * while replies of different delegators can be delivered concurrently. The executor needs to
+ * outlive the delegator.
  */
 class ClientReplyDelegator
 {
@@ -49,6 +54,8 @@ public:
   using ReplyFunction = std::function<void(sup::dto::uint64, const UserInputReply&)>;
   using InterruptFunction = std::function<void(sup::dto::uint64)>;
   explicit ClientReplyDelegator(ReplyFunction reply_func, InterruptFunction interrupt_func);
+  ClientReplyDelegator(ReplyFunction reply_func, InterruptFunction interrupt_func,
+                       ReplyExecutor& executor);
   ~ClientReplyDelegator();
 
   // No copy or move
@@ -63,7 +70,6 @@ public:
 
 private:
   void HandleClientReply();
-  void Halt();
   struct ReplyInfo
   {
     sup::dto::uint64 id;
@@ -71,12 +77,13 @@ private:
   };
   ReplyFunction m_reply_func;
   InterruptFunction m_interrupt_func;
+  ReplyExecutor& m_executor;
   sup::dto::uint64 m_active_id;
   std::condition_variable m_cv;
   std::mutex m_mtx;
   bool m_halt;
+  bool m_scheduled;
   std::deque<ReplyInfo> m_reply_queue;
-  std::thread m_delegatee;
 };
 
 }  // namespace oac_tree_server
@@ -52,8 +52,12 @@ private:
   IJobManager& m_job_manager;
   sup::protocol::ProtocolResult EditBreakpoint(const sup::dto::AnyValue& input,
                                                sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult EditBreakpoints(const sup::dto::AnyValue& input,
+                                                sup::dto::AnyValue& output);
   sup::protocol::ProtocolResult SendJobCommand(const sup::dto::AnyValue& input,
                                                sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult SendJobCommands(const sup::dto::AnyValue& input,
+                                                sup::dto::AnyValue& output);
 };
 
 }  // namespace oac_tree_server
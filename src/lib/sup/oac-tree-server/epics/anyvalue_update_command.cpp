@@ -33,11 +33,29 @@ AnyValueUpdateCommand AnyValueUpdateCommand::CreateValueUpdate(const std::string
   return AnyValueUpdateCommand(kUpdate, channel, value);
 }
 
+AnyValueUpdateCommand AnyValueUpdateCommand::CreateKeyframeUpdate(const std::string& channel,
+                                                                 const sup::dto::AnyValue& value)
+{
+  return AnyValueUpdateCommand(kKeyframeUpdate, channel, value);
+}
+
 AnyValueUpdateCommand AnyValueUpdateCommand::CreateExitCommand()
 {
   return AnyValueUpdateCommand(kExit, {}, {});
 }
 
+AnyValueUpdateCommand AnyValueUpdateCommand::CreateAddVariableCommand(
+  const std::string& channel, const sup::dto::AnyValue& value)
+{
+  return AnyValueUpdateCommand(kAddVariable, channel, value);
+}
+
+AnyValueUpdateCommand AnyValueUpdateCommand::CreateRemoveVariableCommand(
+  const std::string& channel)
+{
+  return AnyValueUpdateCommand(kRemoveVariable, channel, {});
+}
+
 AnyValueUpdateCommand::~AnyValueUpdateCommand() noexcept = default;
 
 AnyValueUpdateCommand::AnyValueUpdateCommand(AnyValueUpdateCommand&&) noexcept = default;
@@ -36,7 +36,8 @@ namespace oac_tree_server
 
 /**
  * @brief Class representing an update to a AnyValue. It can also contain an exit command to be able
- * to terminate loops that are waiting for new commands.
+ * to terminate loops that are waiting for new commands or a command to add or remove an AnyValue.
+ * Keyframe updates are value updates that queues may never coalesce or drop.
  *
  * @note The class is move-only.
  */
@@ -46,11 +47,19 @@ public:
   enum CommandType : dto::uint32
   {
     kUpdate = 0,
-    kExit
+    kExit,
+    kAddVariable,
+    kRemoveVariable,
+    kKeyframeUpdate
   };
   static AnyValueUpdateCommand CreateValueUpdate(const std::string& channel,
                                                  const sup::dto::AnyValue& value);
+  static AnyValueUpdateCommand CreateKeyframeUpdate(const std::string& channel,
+                                                    const sup::dto::AnyValue& value);
   static AnyValueUpdateCommand CreateExitCommand();
+  static AnyValueUpdateCommand CreateAddVariableCommand(const std::string& channel,
+                                                        const sup::dto::AnyValue& value);
+  static AnyValueUpdateCommand CreateRemoveVariableCommand(const std::string& channel);
 
   AnyValueUpdateCommand(const AnyValueUpdateCommand&) = delete;
   AnyValueUpdateCommand& operator=(const AnyValueUpdateCommand&) = delete;
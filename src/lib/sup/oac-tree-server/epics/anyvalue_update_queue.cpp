@@ -28,7 +28,13 @@ namespace oac_tree_server
 {
 
 AnyValueUpdateQueue::AnyValueUpdateQueue()
-  : m_value_updates{}
+  : AnyValueUpdateQueue{kSequential}
+{}
+
+AnyValueUpdateQueue::AnyValueUpdateQueue(QueueMode mode)
+  : m_mode{mode}
+  , m_value_updates{}
+  , m_pending_positions{}
   , m_mtx{}
   , m_cv{}
 {}
@@ -37,18 +43,74 @@ AnyValueUpdateQueue::~AnyValueUpdateQueue() = default;
 
 void AnyValueUpdateQueue::Push(const std::string& channel, const sup::dto::AnyValue& value)
 {
+  if (m_mode != kCoalescing)
+  {
+    PushEntry(channel, value);
+    return;
+  }
   {
     std::lock_guard<std::mutex> lk{m_mtx};
+    auto iter = m_pending_positions.find(channel);
+    if (iter != m_pending_positions.end())
+    {
+      // The consumer was already notified about the pending update, so no need to notify again:
+      m_value_updates[iter->second] = AnyValueUpdateCommand::CreateValueUpdate(channel, value);
+      return;
+    }
+    m_pending_positions[channel] = m_value_updates.size();
     m_value_updates.push_back(AnyValueUpdateCommand::CreateValueUpdate(channel, value));
   }
   m_cv.notify_one();
 }
 
+void AnyValueUpdateQueue::PushEntry(const std::string& channel, const sup::dto::AnyValue& value)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_value_updates.push_back(AnyValueUpdateCommand::CreateValueUpdate(channel, value));
+  }
+  m_cv.notify_one();
+}
+
+void AnyValueUpdateQueue::PushKeyframe(const std::string& channel, const sup::dto::AnyValue& value)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_value_updates.push_back(AnyValueUpdateCommand::CreateKeyframeUpdate(channel, value));
+    (void)m_pending_positions.erase(channel);
+  }
+  m_cv.notify_one();
+}
+
+void AnyValueUpdateQueue::PushAddVariable(const std::string& channel,
+                                          const sup::dto::AnyValue& value)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_value_updates.push_back(AnyValueUpdateCommand::CreateAddVariableCommand(channel, value));
+    (void)m_pending_positions.erase(channel);
+  }
+  m_cv.notify_one();
+}
+
+void AnyValueUpdateQueue::PushRemoveVariable(const std::string& channel)
+{
+  {
+    std::lock_guard<std::mutex> lk{m_mtx};
+    m_value_updates.push_back(AnyValueUpdateCommand::CreateRemoveVariableCommand(channel));
+    // Updates pushed afterwards are meant for the channel after it was added again:
+    (void)m_pending_positions.erase(channel);
+  }
+  m_cv.notify_one();
+}
+
 void AnyValueUpdateQueue::PushExit()
 {
   {
     std::lock_guard<std::mutex> lk{m_mtx};
     m_value_updates.push_back(AnyValueUpdateCommand::CreateExitCommand());
+    // Updates pushed after the exit command may not be coalesced into updates before it:
+    m_pending_positions.clear();
   }
   m_cv.notify_one();
 }
@@ -68,11 +130,15 @@ std::deque<AnyValueUpdateCommand> AnyValueUpdateQueue::PopCommands()
   {
     std::lock_guard<std::mutex> lk{m_mtx};
     m_value_updates.swap(result);
+    m_pending_positions.clear();
   }
   return result;
 }
 
-bool ProcessCommandQueue(std::deque<AnyValueUpdateCommand>& queue, const ValueUpdateFunction& func)
+bool ProcessCommandQueue(std::deque<AnyValueUpdateCommand>& queue,
+                         const ValueUpdateFunction& update_func,
+                         const ValueUpdateFunction& add_func,
+                         const ValueRemoveFunction& remove_func)
 {
   while (!queue.empty())
   {
@@ -82,7 +148,18 @@ bool ProcessCommandQueue(std::deque<AnyValueUpdateCommand>& queue, const ValueUp
       queue.pop_front();
       return true;  // stop processing
     }
-    func(command.Name(), command.Value());
+    if (command.GetCommandType() == AnyValueUpdateCommand::kAddVariable)
+    {
+      add_func(command.Name(), command.Value());
+    }
+    else if (command.GetCommandType() == AnyValueUpdateCommand::kRemoveVariable)
+    {
+      remove_func(command.Name());
+    }
+    else
+    {
+      update_func(command.Name(), command.Value());
+    }
     queue.pop_front();
   }
   return false;
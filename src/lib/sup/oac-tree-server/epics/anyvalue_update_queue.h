@@ -23,13 +23,14 @@
 #ifndef SUP_OAC_TREE_SERVER_ANYVALUE_UPDATE_QUEUE_H_
 #define SUP_OAC_TREE_SERVER_ANYVALUE_UPDATE_QUEUE_H_
 
-#include "anyvalue_update_command.h"
+#include "i_anyvalue_update_queue.h"
 
 #include <sup/dto/anyvalue.h>
 
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <string>
 
@@ -41,30 +42,77 @@ namespace oac_tree_server
 
 /**
  * @brief Threadsafe queue for AnyValue update commands.
+ *
+ * @details In coalescing mode, the queue keeps at most one pending update per channel: pushing a
+ * new value for a channel that still has a pending update replaces that update's value, while
+ * keeping its position in the queue. This bounds the size of the queue by the number of channels
+ * instead of the update rate. Updates pushed with PushEntry or PushKeyframe, the exit command and
+ * the commands to add or remove AnyValues are never coalesced.
 */
-class AnyValueUpdateQueue
+class AnyValueUpdateQueue : public IAnyValueUpdateQueue
 {
 public:
+  enum QueueMode : dto::uint32
+  {
+    kSequential = 0,
+    kCoalescing
+  };
   AnyValueUpdateQueue();
-  ~AnyValueUpdateQueue();
+  explicit AnyValueUpdateQueue(QueueMode mode);
+  ~AnyValueUpdateQueue() override;
 
   /**
-   * @brief Push new PV update to queue.
+   * @brief Push new PV update to queue. In coalescing mode, this replaces a pending update for the
+   * same channel.
    *
    * @param name Name of AnyValue to update.
    * @param value Value for update.
    */
-  void Push(const std::string& channel, const sup::dto::AnyValue& value);
+  void Push(const std::string& channel, const sup::dto::AnyValue& value) override;
+
+  /**
+   * @brief Push new PV update to queue that is part of a stream of entries (e.g. log entries), where
+   * every single update needs to be published. Such updates are never coalesced.
+   *
+   * @param name Name of AnyValue to update.
+   * @param value Value for update.
+   */
+  void PushEntry(const std::string& channel, const sup::dto::AnyValue& value) override;
+
+  /**
+   * @brief Push new PV update that later updates of other channels depend on, e.g. a variable
+   * keyframe. Such updates are never coalesced or dropped.
+   *
+   * @param name Name of AnyValue to update.
+   * @param value Value for update.
+   */
+  void PushKeyframe(const std::string& channel, const sup::dto::AnyValue& value) override;
+
+  /**
+   * @brief Push a command to add a new AnyValue with the given initial value.
+   *
+   * @param name Name of AnyValue to add.
+   * @param value Initial value.
+   */
+  void PushAddVariable(const std::string& channel, const sup::dto::AnyValue& value) override;
+
+  /**
+   * @brief Push a command to remove an AnyValue. Updates of the same channel that were pushed
+   * before are never coalesced with updates pushed afterwards.
+   *
+   * @param name Name of AnyValue to remove.
+   */
+  void PushRemoveVariable(const std::string& channel) override;
 
   /**
    * @brief Push a command that will terminate any processing loops.
    */
-  void PushExit();
+  void PushExit() override;
 
   /**
    * @brief Blocks until the queue becomes non-empty.
    */
-  void WaitForNonEmpty();
+  void WaitForNonEmpty() override;
 
   /**
    * @brief Pops out the whole queue.
@@ -72,16 +120,22 @@ public:
    * @note This allows the consumer of the queue to process all commands without needing to hold
    * any locks.
    */
-  std::deque<AnyValueUpdateCommand> PopCommands();
+  std::deque<AnyValueUpdateCommand> PopCommands() override;
 
 private:
+  const QueueMode m_mode;
   std::deque<AnyValueUpdateCommand> m_value_updates;
+  std::map<std::string, std::size_t> m_pending_positions;
   mutable std::mutex m_mtx;
   std::condition_variable m_cv;
 };
 
 using ValueUpdateFunction = std::function<void(const std::string&, const sup::dto::AnyValue&)>;
-bool ProcessCommandQueue(std::deque<AnyValueUpdateCommand>& queue, const ValueUpdateFunction& func);
+using ValueRemoveFunction = std::function<void(const std::string&)>;
+bool ProcessCommandQueue(std::deque<AnyValueUpdateCommand>& queue,
+                         const ValueUpdateFunction& update_func,
+                         const ValueUpdateFunction& add_func,
+                         const ValueRemoveFunction& remove_func);
 
 }  // namespace oac_tree_server
 
@@ -0,0 +1,369 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "anyvalue_update_ring.h"
+
+#include <cstdint>
+
+namespace
+{
+std::size_t GetValidCapacity(std::size_t capacity);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+AnyValueUpdateRing::AnyValueUpdateRing(std::size_t capacity,
+                                       EPICSServerConfig::OverflowPolicy policy)
+  : m_policy{policy}
+  , m_mask{GetValidCapacity(capacity) - 1}
+  , m_cells{std::make_unique<Cell[]>(m_mask + 1)}
+  , m_enqueue_pos{0}
+  , m_dequeue_pos{0}
+  , m_consumer_waiting{false}
+  , m_has_overflow{false}
+  , m_overflow_mtx{}
+  , m_overflow_commands{}
+  , m_overflow_positions{}
+  , m_wait_mtx{}
+  , m_cv{}
+  , m_producers_waiting{0}
+  , m_space_mtx{}
+  , m_space_cv{}
+{
+  for (std::size_t idx = 0; idx <= m_mask; ++idx)
+  {
+    m_cells[idx].m_sequence.store(idx, std::memory_order_relaxed);
+  }
+}
+
+AnyValueUpdateRing::~AnyValueUpdateRing() = default;
+
+void AnyValueUpdateRing::Push(const std::string& channel, const sup::dto::AnyValue& value)
+{
+  if (m_policy == EPICSServerConfig::kCoalesce)
+  {
+    EnqueueCoalescing(channel, value);
+    return;
+  }
+  PushEntry(channel, value);
+}
+
+void AnyValueUpdateRing::PushEntry(const std::string& channel, const sup::dto::AnyValue& value)
+{
+  auto command = AnyValueUpdateCommand::CreateValueUpdate(channel, value);
+  if (m_policy == EPICSServerConfig::kDropOldest)
+  {
+    EnqueueDropOldest(std::move(command));
+    return;
+  }
+  EnqueueBlocking(std::move(command));
+}
+
+void AnyValueUpdateRing::PushKeyframe(const std::string& channel, const sup::dto::AnyValue& value)
+{
+  EnqueueOrdered(AnyValueUpdateCommand::CreateKeyframeUpdate(channel, value));
+}
+
+void AnyValueUpdateRing::PushAddVariable(const std::string& channel,
+                                         const sup::dto::AnyValue& value)
+{
+  EnqueueOrdered(AnyValueUpdateCommand::CreateAddVariableCommand(channel, value));
+}
+
+void AnyValueUpdateRing::PushRemoveVariable(const std::string& channel)
+{
+  EnqueueOrdered(AnyValueUpdateCommand::CreateRemoveVariableCommand(channel));
+}
+
+void AnyValueUpdateRing::PushExit()
+{
+  EnqueueBlocking(AnyValueUpdateCommand::CreateExitCommand());
+}
+
+void AnyValueUpdateRing::WaitForNonEmpty()
+{
+  if (HasPendingCommands())
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lk{m_wait_mtx};
+  m_consumer_waiting.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in NotifyConsumer: either the producer sees the waiting flag, or this
+  // thread sees the producer's command when evaluating the predicate.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto pred = [this]{
+    return HasPendingCommands();
+  };
+  m_cv.wait(lk, pred);
+  m_consumer_waiting.store(false, std::memory_order_relaxed);
+}
+
+std::deque<AnyValueUpdateCommand> AnyValueUpdateRing::PopCommands()
+{
+  std::deque<AnyValueUpdateCommand> result;
+  {
+    std::lock_guard<std::mutex> lk{m_overflow_mtx};
+    // Commands that were retained when dropping the oldest commands precede all commands in the
+    // ring buffer, while coalesced updates follow them:
+    if (m_policy == EPICSServerConfig::kDropOldest)
+    {
+      result.swap(m_overflow_commands);
+    }
+    auto command = TryDequeue();
+    while (command.has_value())
+    {
+      result.push_back(std::move(*command));
+      command = TryDequeue();
+    }
+    for (auto& overflow_command : m_overflow_commands)
+    {
+      result.push_back(std::move(overflow_command));
+    }
+    m_overflow_commands.clear();
+    m_overflow_positions.clear();
+    m_has_overflow.store(false, std::memory_order_release);
+  }
+  NotifyProducers();
+  return result;
+}
+
+std::size_t AnyValueUpdateRing::GetCapacity() const
+{
+  return m_mask + 1;
+}
+
+bool AnyValueUpdateRing::TryEnqueue(AnyValueUpdateCommand& command)
+{
+  auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+  while (true)
+  {
+    auto& cell = m_cells[pos & m_mask];
+    auto seq = cell.m_sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+    if (diff == 0)
+    {
+      if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        cell.m_command = std::move(command);
+        cell.m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    }
+    else if (diff < 0)
+    {
+      return false;  // full
+    }
+    else
+    {
+      pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+std::optional<AnyValueUpdateCommand> AnyValueUpdateRing::TryDequeue()
+{
+  // Only called while holding the overflow mutex, so there is only one consumer at a time.
+  auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+  while (true)
+  {
+    auto& cell = m_cells[pos & m_mask];
+    auto seq = cell.m_sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+    if (diff == 0)
+    {
+      if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        auto result = std::move(cell.m_command);
+        cell.m_command.reset();
+        cell.m_sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return result;
+      }
+    }
+    else if (diff < 0)
+    {
+      return std::nullopt;  // empty
+    }
+    else
+    {
+      pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AnyValueUpdateRing::EnqueueBlocking(AnyValueUpdateCommand command)
+{
+  while (!TryEnqueue(command))
+  {
+    // Make sure the consumer drains the ring buffer before waiting for it to make room:
+    NotifyConsumer();
+    WaitForFreeCell();
+  }
+  NotifyConsumer();
+}
+
+void AnyValueUpdateRing::EnqueueDropOldest(AnyValueUpdateCommand command)
+{
+  while (!TryEnqueue(command))
+  {
+    std::lock_guard<std::mutex> lk{m_overflow_mtx};
+    auto oldest = TryDequeue();
+    if (oldest.has_value() && oldest->GetCommandType() != AnyValueUpdateCommand::kUpdate)
+    {
+      // Only value updates may be dropped, not keyframe updates or other commands:
+      m_overflow_commands.push_back(std::move(*oldest));
+      m_has_overflow.store(true, std::memory_order_release);
+    }
+  }
+  NotifyConsumer();
+}
+
+void AnyValueUpdateRing::EnqueueCoalescing(const std::string& channel,
+                                           const sup::dto::AnyValue& value)
+{
+  // As long as there are coalesced updates, new updates need to be coalesced too, as they would
+  // otherwise be published before older updates of the same channel.
+  if (!m_has_overflow.load(std::memory_order_acquire))
+  {
+    auto command = AnyValueUpdateCommand::CreateValueUpdate(channel, value);
+    if (TryEnqueue(command))
+    {
+      NotifyConsumer();
+      return;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lk{m_overflow_mtx};
+    auto iter = m_overflow_positions.find(channel);
+    if (iter != m_overflow_positions.end())
+    {
+      m_overflow_commands[iter->second] = AnyValueUpdateCommand::CreateValueUpdate(channel, value);
+    }
+    else
+    {
+      m_overflow_positions[channel] = m_overflow_commands.size();
+      m_overflow_commands.push_back(AnyValueUpdateCommand::CreateValueUpdate(channel, value));
+    }
+    m_has_overflow.store(true, std::memory_order_release);
+  }
+  NotifyConsumer();
+}
+
+void AnyValueUpdateRing::EnqueueOrdered(AnyValueUpdateCommand command)
+{
+  if (m_policy == EPICSServerConfig::kCoalesce)
+  {
+    std::unique_lock<std::mutex> lk{m_overflow_mtx};
+    if (m_has_overflow.load(std::memory_order_acquire))
+    {
+      // Coalesced updates are popped after the ring buffer, so this command needs to follow them
+      // and later updates of the same channel may no longer be coalesced with them:
+      (void)m_overflow_positions.erase(command.Name());
+      m_overflow_commands.push_back(std::move(command));
+      lk.unlock();
+      NotifyConsumer();
+      return;
+    }
+  }
+  EnqueueBlocking(std::move(command));
+}
+
+bool AnyValueUpdateRing::HasPendingCommands() const
+{
+  if (m_has_overflow.load(std::memory_order_acquire))
+  {
+    return true;
+  }
+  auto pos = m_dequeue_pos.load(std::memory_order_acquire);
+  return m_cells[pos & m_mask].m_sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+bool AnyValueUpdateRing::HasFreeCell() const
+{
+  // A cell sequence ahead of the enqueue position means that another producer claimed that cell
+  // in the meantime, so the ring buffer is not known to be full either:
+  auto pos = m_enqueue_pos.load(std::memory_order_acquire);
+  auto seq = m_cells[pos & m_mask].m_sequence.load(std::memory_order_acquire);
+  return static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos) >= 0;
+}
+
+void AnyValueUpdateRing::NotifyConsumer()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!m_consumer_waiting.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+  {
+    // Taking the lock ensures the consumer is either waiting or will see the new command:
+    std::lock_guard<std::mutex> lk{m_wait_mtx};
+  }
+  m_cv.notify_one();
+}
+
+void AnyValueUpdateRing::WaitForFreeCell()
+{
+  std::unique_lock<std::mutex> lk{m_space_mtx};
+  m_producers_waiting.fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in NotifyProducers: either the consumer sees the waiting producer, or
+  // this thread sees the cell that the consumer freed when evaluating the predicate.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto pred = [this]{
+    return HasFreeCell();
+  };
+  m_space_cv.wait(lk, pred);
+  m_producers_waiting.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AnyValueUpdateRing::NotifyProducers()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_producers_waiting.load(std::memory_order_relaxed) == 0)
+  {
+    return;
+  }
+  {
+    // Taking the lock ensures a producer is either waiting or will see the freed cells:
+    std::lock_guard<std::mutex> lk{m_space_mtx};
+  }
+  m_space_cv.notify_all();
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+namespace
+{
+std::size_t GetValidCapacity(std::size_t capacity)
+{
+  std::size_t result = 2;
+  while (result < capacity)
+  {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // unnamed namespace
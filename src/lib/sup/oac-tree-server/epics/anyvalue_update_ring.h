@@ -0,0 +1,128 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_ANYVALUE_UPDATE_RING_H_
+#define SUP_OAC_TREE_SERVER_ANYVALUE_UPDATE_RING_H_
+
+#include "i_anyvalue_update_queue.h"
+
+#include <sup/oac-tree-server/epics_server_config.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Bounded lock-free multi-producer/single-consumer queue for AnyValue update commands.
+ *
+ * @details Producers push commands into a ring buffer without taking any lock. They only signal
+ * the consumer when it is waiting for new commands, so a burst of updates results in a single
+ * wake-up of the consumer, which then pops the whole batch.
+ *
+ * When the ring buffer is full, the overflow policy determines what happens:
+ * - kBlock: the producer waits until the consumer made room. The consumer only signals producers
+ *   when one of them is waiting;
+ * - kDropOldest: the oldest value update or entry is dropped to make room;
+ * - kCoalesce: state updates (see Push) are kept in an overflow list with at most one update per
+ *   channel until the consumer pops the commands. Entries are not coalesced and block instead.
+ *
+ * Keyframe updates and commands that add or remove AnyValues or terminate processing are never
+ * dropped or coalesced. While coalesced updates are pending, keyframe updates and commands that add
+ * or remove AnyValues are appended to the overflow list, so they keep their order with respect to
+ * those updates. Only the overflow
+ * handling, popping the commands and waiting for the consumer or for room take a lock.
+*/
+class AnyValueUpdateRing : public IAnyValueUpdateQueue
+{
+public:
+  /**
+   * @brief Construct a new ring buffer.
+   *
+   * @param capacity Capacity of the ring buffer, rounded up to a power of two (at least two).
+   * @param policy Policy to apply when the ring buffer is full.
+   */
+  AnyValueUpdateRing(std::size_t capacity, EPICSServerConfig::OverflowPolicy policy);
+  ~AnyValueUpdateRing() override;
+
+  void Push(const std::string& channel, const sup::dto::AnyValue& value) override;
+  void PushEntry(const std::string& channel, const sup::dto::AnyValue& value) override;
+  void PushKeyframe(const std::string& channel, const sup::dto::AnyValue& value) override;
+  void PushAddVariable(const std::string& channel, const sup::dto::AnyValue& value) override;
+  void PushRemoveVariable(const std::string& channel) override;
+  void PushExit() override;
+  void WaitForNonEmpty() override;
+  std::deque<AnyValueUpdateCommand> PopCommands() override;
+
+  /**
+   * @brief Get the capacity of the ring buffer.
+   */
+  std::size_t GetCapacity() const;
+
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> m_sequence;
+    std::optional<AnyValueUpdateCommand> m_command;
+  };
+  bool TryEnqueue(AnyValueUpdateCommand& command);
+  std::optional<AnyValueUpdateCommand> TryDequeue();
+  void EnqueueBlocking(AnyValueUpdateCommand command);
+  void EnqueueDropOldest(AnyValueUpdateCommand command);
+  void EnqueueCoalescing(const std::string& channel, const sup::dto::AnyValue& value);
+  void EnqueueOrdered(AnyValueUpdateCommand command);
+  bool HasPendingCommands() const;
+  bool HasFreeCell() const;
+  void NotifyConsumer();
+  void WaitForFreeCell();
+  void NotifyProducers();
+
+  const EPICSServerConfig::OverflowPolicy m_policy;
+  const std::size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+  alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+  alignas(64) std::atomic<std::size_t> m_dequeue_pos;
+  alignas(64) std::atomic<bool> m_consumer_waiting;
+  std::atomic<bool> m_has_overflow;
+  std::mutex m_overflow_mtx;
+  std::deque<AnyValueUpdateCommand> m_overflow_commands;
+  std::map<std::string, std::size_t> m_overflow_positions;
+  std::mutex m_wait_mtx;
+  std::condition_variable m_cv;
+  alignas(64) std::atomic<std::size_t> m_producers_waiting;
+  std::mutex m_space_mtx;
+  std::condition_variable m_space_cv;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_ANYVALUE_UPDATE_RING_H_
@@ -28,14 +28,24 @@
 #include <sup/oac-tree-server/input_request_helper.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+
 namespace sup
 {
 namespace oac_tree_server
 {
 
 EPICSAnyValueManager::EPICSAnyValueManager()
-  : m_map_mtx{}
+  : EPICSAnyValueManager{EPICSServerConfig{}}
+{}
+
+EPICSAnyValueManager::EPICSAnyValueManager(const EPICSServerConfig& config)
+  : m_config{config}
+  , m_map_mtx{}
   , m_user_input_mtx{}
+  , m_published_request_ids{}
   , m_name_server_map{}
   , m_servers{}
   , m_name_input_server_map{}
@@ -65,8 +75,10 @@ bool EPICSAnyValueManager::AddInputHandler(const std::string& input_server_name)
     (void)m_input_servers.emplace_back(std::move(input_server));
   }
   auto input_request_name = GetInputRequestPVName(input_server_name);
+  auto input_request_list_name = GetInputRequestListPVName(input_server_name);
   NameAnyValueSet value_set;
   (void)value_set.emplace_back(input_request_name, kInputRequestAnyValue);
+  (void)value_set.emplace_back(input_request_list_name, kInputRequestListAnyValue);
   {
     std::lock_guard<std::mutex> lk{m_map_mtx};
     if (!AddAnyValuesImpl(value_set))
@@ -93,35 +105,108 @@ UserInputReply EPICSAnyValueManager::GetUserInput(const std::string& input_serve
                                                   sup::dto::uint64 id,
                                                   const UserInputRequest& request)
 {
-  std::lock_guard<std::mutex> lk{m_user_input_mtx};
-  // The map mutex lock is only needed during the find operation:
-  auto input_request_name = GetInputRequestPVName(input_server_name);
+  return GetUserInputImpl(input_server_name, id, request, std::nullopt).second;
+}
+
+std::pair<UserInputStatus, UserInputReply> EPICSAnyValueManager::GetUserInputUntil(
+  const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+  std::chrono::steady_clock::time_point deadline)
+{
+  return GetUserInputImpl(input_server_name, id, request, deadline);
+}
+
+void EPICSAnyValueManager::Interrupt(const std::string& input_server_name, sup::dto::uint64 id)
+{
   auto input_server = FindInputServer(input_server_name);
-  auto input_pv_server = FindServer(input_request_name);
-  if (input_server == nullptr || input_pv_server == nullptr)
+  if (input_server != nullptr)
   {
-    return sup::oac_tree::kInvalidUserInputReply;
+    input_server->Interrupt(id);
   }
-  input_server->InitNewRequest(id);
-  auto input_request = EncodeInputRequest(id, request);
-  input_pv_server->UpdateAnyValue(input_request_name, input_request);
-  // This will block until a reply is received or the request is interrupted:
-  auto [retrieved, value] = input_server->WaitForReply(id);
-  input_pv_server->UpdateAnyValue(input_request_name, kInputRequestAnyValue);
-  if (!retrieved)
+}
+
+bool EPICSAnyValueManager::RemoveAnyValues(const std::set<std::string>& names)
+{
+  // Removed servers are destroyed after releasing the lock, since this waits for their threads:
+  std::vector<std::unique_ptr<EPICSServer>> removed_servers;
   {
-    return sup::oac_tree::kInvalidUserInputReply;
+    std::lock_guard<std::mutex> lk{m_map_mtx};
+    std::set<EPICSServer*> servers;
+    for (const auto& name : names)
+    {
+      auto iter = m_name_server_map.find(name);
+      if (iter == m_name_server_map.end())
+      {
+        return false;
+      }
+      (void)servers.insert(iter->second);
+    }
+    if (m_config.m_single_server && !servers.empty())
+    {
+      // The shared server remains and removes the values one by one:
+      for (const auto& name : names)
+      {
+        (void)m_name_server_map.erase(name);
+      }
+      (*servers.begin())->RemoveAnyValues(names);
+      return true;
+    }
+    // Servers can only be removed as a whole:
+    for (const auto& [name, server] : m_name_server_map)
+    {
+      if (servers.find(server) != servers.end() && names.find(name) == names.end())
+      {
+        return false;
+      }
+    }
+    for (const auto& name : names)
+    {
+      (void)m_name_server_map.erase(name);
+    }
+    auto removed_begin = std::stable_partition(m_servers.begin(), m_servers.end(),
+      [&servers](const std::unique_ptr<EPICSServer>& server) {
+        return servers.find(server.get()) == servers.end();
+      });
+    std::move(removed_begin, m_servers.end(), std::back_inserter(removed_servers));
+    (void)m_servers.erase(removed_begin, m_servers.end());
   }
-  return value;
+  return true;
 }
 
-void EPICSAnyValueManager::Interrupt(const std::string& input_server_name, sup::dto::uint64 id)
+bool EPICSAnyValueManager::RemoveInputHandler(const std::string& input_server_name)
 {
-  auto input_server = FindInputServer(input_server_name);
-  if (input_server != nullptr)
+  std::unique_ptr<EPICSInputServer> removed_input_server;
   {
-    input_server->Interrupt(id);
+    std::lock_guard<std::mutex> lk{m_map_mtx};
+    auto iter = m_name_input_server_map.find(input_server_name);
+    if (iter == m_name_input_server_map.end())
+    {
+      return false;
+    }
+    auto input_server = iter->second;
+    (void)m_name_input_server_map.erase(iter);
+    auto server_iter = std::find_if(m_input_servers.begin(), m_input_servers.end(),
+      [input_server](const std::unique_ptr<EPICSInputServer>& server) {
+        return server.get() == input_server;
+      });
+    if (server_iter != m_input_servers.end())
+    {
+      removed_input_server = std::move(*server_iter);
+      (void)m_input_servers.erase(server_iter);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lk{m_user_input_mtx};
+    (void)m_published_request_ids.erase(input_server_name);
   }
+  auto input_request_name = GetInputRequestPVName(input_server_name);
+  auto input_request_list_name = GetInputRequestListPVName(input_server_name);
+  return RemoveAnyValues({ input_request_name, input_request_list_name });
+}
+
+sup::dto::uint32 EPICSAnyValueManager::GetNumberOfAnyValues() const
+{
+  std::lock_guard<std::mutex> lk{m_map_mtx};
+  return static_cast<sup::dto::uint32>(m_name_server_map.size());
 }
 
 bool EPICSAnyValueManager::AddAnyValuesImpl(const NameAnyValueSet &name_value_set)
@@ -133,7 +218,17 @@ bool EPICSAnyValueManager::AddAnyValuesImpl(const NameAnyValueSet &name_value_se
     return false;
   }
   auto names = GetNames(name_value_set);
-  auto server = std::make_unique<EPICSServer>(name_value_set);
+  if (m_config.m_single_server && !m_servers.empty())
+  {
+    auto& shared_server = m_servers.front();
+    shared_server->AddAnyValues(name_value_set);
+    for (const auto &name : names)
+    {
+      m_name_server_map[name] = shared_server.get();
+    }
+    return true;
+  }
+  auto server = std::make_unique<EPICSServer>(name_value_set, m_config);
   for (const auto &name : names)
   {
     m_name_server_map[name] = server.get();
@@ -182,6 +277,69 @@ EPICSInputServer* EPICSAnyValueManager::FindInputServer(const std::string& serve
   return iter->second;
 }
 
+std::pair<UserInputStatus, UserInputReply> EPICSAnyValueManager::GetUserInputImpl(
+  const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+  const std::optional<std::chrono::steady_clock::time_point>& deadline)
+{
+  // The map mutex lock is only needed during the find operation:
+  auto input_request_name = GetInputRequestPVName(input_server_name);
+  auto input_server = FindInputServer(input_server_name);
+  auto input_pv_server = FindServer(input_request_name);
+  if (input_server == nullptr || input_pv_server == nullptr)
+  {
+    return { UserInputStatus::kInterrupted, sup::oac_tree::kInvalidUserInputReply };
+  }
+  input_server->AddRequest(id, request);
+  PublishInputRequests(input_server_name, *input_server);
+  // This will block until a reply is received, the request is interrupted or the deadline passed:
+  std::pair<UserInputStatus, UserInputReply> result{ UserInputStatus::kInterrupted,
+                                                     sup::oac_tree::kInvalidUserInputReply };
+  if (deadline.has_value())
+  {
+    result = input_server->WaitForReplyUntil(id, deadline.value());
+  }
+  else
+  {
+    auto [retrieved, value] = input_server->WaitForReply(id);
+    if (retrieved)
+    {
+      result = { UserInputStatus::kReplied, value };
+    }
+  }
+  PublishInputRequests(input_server_name, *input_server);
+  return result;
+}
+
+void EPICSAnyValueManager::PublishInputRequests(const std::string& input_server_name,
+                                                const EPICSInputServer& input_server)
+{
+  // Taking the snapshot and publishing it under the same lock ensures the last published values
+  // always reflect the latest set of outstanding requests:
+  std::lock_guard<std::mutex> lk{m_user_input_mtx};
+  auto pending_requests = input_server.GetPendingRequests();
+  (void)UpdateAnyValue(GetInputRequestListPVName(input_server_name),
+                       EncodeInputRequestList(pending_requests));
+  // The request PV is only updated when the oldest outstanding request changes:
+  sup::dto::uint64 oldest_id = pending_requests.empty() ? 0 : pending_requests.begin()->first;
+  auto& published_id = m_published_request_ids[input_server_name];
+  if (oldest_id == published_id)
+  {
+    return;
+  }
+  auto input_request_name = GetInputRequestPVName(input_server_name);
+  if (published_id != 0)
+  {
+    // Clients expect the request PV to be cleared before the next request is published:
+    (void)UpdateAnyValue(input_request_name, kInputRequestAnyValue);
+  }
+  if (oldest_id != 0)
+  {
+    (void)UpdateAnyValue(input_request_name,
+                         EncodeInputRequest(oldest_id, pending_requests.begin()->second));
+  }
+  published_id = oldest_id;
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -23,11 +23,13 @@
 #ifndef SUP_OAC_TREE_SERVEREPICS_ANYVALUE_MANAGER_H_
 #define SUP_OAC_TREE_SERVEREPICS_ANYVALUE_MANAGER_H_
 
+#include <sup/oac-tree-server/epics_server_config.h>
 #include <sup/oac-tree-server/i_anyvalue_manager.h>
 
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace sup
 {
@@ -39,11 +41,23 @@ class EPICSInputServer;
 /**
  * @brief EPICSAnyValueManager implements IAnyValueManager using EPICS PvAccess and publishes
  * the managed AnyValues over this protocol.
+ *
+ * @details By default, a new EPICSServer is created for every set of AnyValues that is added. When
+ * configured to use a single server, the first set of AnyValues creates the server and all later
+ * sets are added to that running server, so that all AnyValues share one update thread. Without a
+ * single server, AnyValues can only be removed together with all other AnyValues of the set they
+ * were added with, while the single server removes them individually and reuses their PVs when
+ * they are added again.
+ *
+ * Requests for user input are not serialized: all outstanding requests of an input server are
+ * published in a list PV, while the request PV always contains the oldest outstanding request, so
+ * that clients that only handle one request at a time keep working.
  */
 class EPICSAnyValueManager : public IAnyValueManager
 {
 public:
   EPICSAnyValueManager();
+  explicit EPICSAnyValueManager(const EPICSServerConfig& config);
   ~EPICSAnyValueManager() override;
 
   bool AddAnyValues(const NameAnyValueSet& name_value_set) override;
@@ -51,16 +65,33 @@ public:
   bool UpdateAnyValue(const std::string& name, const sup::dto::AnyValue& value) override;
   UserInputReply GetUserInput(const std::string& input_server_name, sup::dto::uint64 id,
                               const UserInputRequest& request) override;
+  std::pair<UserInputStatus, UserInputReply> GetUserInputUntil(
+    const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+    std::chrono::steady_clock::time_point deadline) override;
   void Interrupt(const std::string& input_server_name, sup::dto::uint64 id) override;
+  bool RemoveAnyValues(const std::set<std::string>& names) override;
+  bool RemoveInputHandler(const std::string& input_server_name) override;
+
+  /**
+   * @brief Get the number of AnyValues that are currently published by this manager.
+   */
+  sup::dto::uint32 GetNumberOfAnyValues() const;
 
 private:
   bool AddAnyValuesImpl(const NameAnyValueSet& name_value_set);
   bool ValidateNameValueSet(const NameAnyValueSet& name_value_set) const;
   EPICSServer* FindServer(const std::string& name) const;
   EPICSInputServer* FindInputServer(const std::string& server_name) const;
+  std::pair<UserInputStatus, UserInputReply> GetUserInputImpl(
+    const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+    const std::optional<std::chrono::steady_clock::time_point>& deadline);
+  void PublishInputRequests(const std::string& input_server_name,
+                            const EPICSInputServer& input_server);
 
+  const EPICSServerConfig m_config;
   mutable std::mutex m_map_mtx;
-  mutable std::mutex m_user_input_mtx;
+  std::mutex m_user_input_mtx;
+  std::map<std::string, sup::dto::uint64> m_published_request_ids;
   std::map<std::string, EPICSServer*> m_name_server_map;
   std::vector<std::unique_ptr<EPICSServer>> m_servers;
   std::map<std::string, EPICSInputServer*> m_name_input_server_map;
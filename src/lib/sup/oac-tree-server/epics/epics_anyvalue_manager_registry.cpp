@@ -30,12 +30,17 @@ namespace oac_tree_server
 {
 
 EPICSAnyValueManagerRegistry::EPICSAnyValueManagerRegistry(sup::dto::uint32 n_managers)
+  : EPICSAnyValueManagerRegistry{n_managers, EPICSServerConfig{}}
+{}
+
+EPICSAnyValueManagerRegistry::EPICSAnyValueManagerRegistry(sup::dto::uint32 n_managers,
+                                                           const EPICSServerConfig& config)
   : m_anyvalue_managers{}
 {
   m_anyvalue_managers.reserve(n_managers);
   for (sup::dto::uint32 idx = 0; idx < n_managers; ++idx)
   {
-    (void)m_anyvalue_managers.emplace_back(std::make_unique<EPICSAnyValueManager>());
+    (void)m_anyvalue_managers.emplace_back(std::make_unique<EPICSAnyValueManager>(config));
   }
 }
 
@@ -23,6 +23,7 @@
 #ifndef SUP_OAC_TREE_SERVER_EPICS_ANYVALUE_MANAGER_REGISTRY_H_
 #define SUP_OAC_TREE_SERVER_EPICS_ANYVALUE_MANAGER_REGISTRY_H_
 
+#include <sup/oac-tree-server/epics_server_config.h>
 #include <sup/oac-tree-server/i_anyvalue_manager_registry.h>
 
 namespace sup
@@ -39,6 +40,7 @@ class EPICSAnyValueManagerRegistry : public IAnyValueManagerRegistry
 {
 public:
   explicit EPICSAnyValueManagerRegistry(sup::dto::uint32 n_managers);
+  EPICSAnyValueManagerRegistry(sup::dto::uint32 n_managers, const EPICSServerConfig& config);
   EPICSAnyValueManagerRegistry(const EPICSAnyValueManagerRegistry &) = delete;
   EPICSAnyValueManagerRegistry(EPICSAnyValueManagerRegistry &&) = delete;
   EPICSAnyValueManagerRegistry &operator=(const EPICSAnyValueManagerRegistry &) = delete;
@@ -24,6 +24,7 @@
 
 #include <sup/oac-tree-server/automation_client_stack.h>
 #include <sup/oac-tree-server/epics/epics_anyvalue_manager_registry.h>
+#include <sup/oac-tree-server/epics/epics_sharded_anyvalue_manager_registry.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 #include <sup/epics/epics_protocol_factory.h>
 
@@ -59,6 +60,27 @@ std::unique_ptr<IAnyValueManagerRegistry> CreateEPICSAnyValueManagerRegistry(
   return result;
 }
 
+std::unique_ptr<IAnyValueManagerRegistry> CreateEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_managers, const EPICSServerConfig& config)
+{
+  auto result = std::make_unique<EPICSAnyValueManagerRegistry>(n_managers, config);
+  return result;
+}
+
+std::unique_ptr<IAnyValueManagerRegistry> CreateShardedEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_shards)
+{
+  auto result = std::make_unique<EPICSShardedAnyValueManagerRegistry>(n_shards);
+  return result;
+}
+
+std::unique_ptr<IAnyValueManagerRegistry> CreateShardedEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_shards, const EPICSServerConfig& config)
+{
+  auto result = std::make_unique<EPICSShardedAnyValueManagerRegistry>(n_shards, config);
+  return result;
+}
+
 }  // namespace utils
 
 }  // namespace oac_tree_server
@@ -43,6 +43,12 @@ bool EPICSInputClient::SetClientReply(sup::dto::uint64 id, const UserInputReply&
   return m_protocol_client.SetClientReply(id, reply);
 }
 
+std::tuple<bool, sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+EPICSInputClient::GetPendingRequests(sup::dto::uint64 update_count, sup::dto::uint32 timeout_ms)
+{
+  return m_protocol_client.GetPendingRequests(update_count, timeout_ms);
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
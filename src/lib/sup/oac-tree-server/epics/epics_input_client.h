@@ -52,6 +52,9 @@ public:
 
   bool SetClientReply(sup::dto::uint64 id, const UserInputReply& reply);
 
+  std::tuple<bool, sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+  GetPendingRequests(sup::dto::uint64 update_count, sup::dto::uint32 timeout_ms);
+
 private:
   std::unique_ptr<sup::protocol::Protocol> m_client_stack;
   InputProtocolClient m_protocol_client;
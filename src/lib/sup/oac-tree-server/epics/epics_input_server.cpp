@@ -44,11 +44,27 @@ void EPICSInputServer::InitNewRequest(sup::dto::uint64 id)
   return m_request_server.InitNewRequest(id);
 }
 
+void EPICSInputServer::AddRequest(sup::dto::uint64 id, const UserInputRequest& request)
+{
+  m_request_server.AddRequest(id, request);
+}
+
+std::map<sup::dto::uint64, UserInputRequest> EPICSInputServer::GetPendingRequests() const
+{
+  return m_request_server.GetPendingRequests();
+}
+
 std::pair<bool, UserInputReply> EPICSInputServer::WaitForReply(sup::dto::uint64 id)
 {
   return m_request_server.WaitForReply(id);
 }
 
+std::pair<UserInputStatus, UserInputReply> EPICSInputServer::WaitForReplyUntil(
+  sup::dto::uint64 id, std::chrono::steady_clock::time_point deadline)
+{
+  return m_request_server.WaitForReplyUntil(id, deadline);
+}
+
 void EPICSInputServer::Interrupt(sup::dto::uint64 id)
 {
   m_request_server.Interrupt(id);
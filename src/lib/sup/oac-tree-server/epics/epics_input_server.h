@@ -28,6 +28,7 @@
 #include <sup/protocol/protocol_factory.h>
 #include <sup/oac-tree/user_input_reply.h>
 
+#include <map>
 #include <memory>
 
 namespace sup
@@ -40,8 +41,17 @@ using sup::oac_tree::UserInputReply;
 /**
  * @brief EPICSInputServer is the EPICS implementation of an RPC server that handles user input.
  *
- * @note Clients using this server should ensure that only one input request is active at a time.
- * This means that WaitForReply should return before a new request can be made.
+ * @details Requests started with AddRequest() are reported as pending, together with their
+ * UserInputRequest, until they are replied to or interrupted. This allows multiple requests to be
+ * outstanding at the same time. Clients can retrieve the pending requests over the same RPC
+ * connection they use for replying, optionally waiting for changes. A request started with
+ * InitNewRequest() discards all other outstanding requests.
+ *
+ * The request PVs that EPICSAnyValueManager publishes next to this server are kept, since
+ * EPICSIOClient and older clients that monitor the request PV depend on them. PvAccess only sends
+ * PV updates to clients that monitor them. A client that retrieves the pending requests over RPC
+ * opts out of this traffic by not monitoring those PVs. It pays instead with one handler thread
+ * of this server while its call waits for changes.
  */
 class EPICSInputServer
 {
@@ -62,6 +72,21 @@ public:
    */
   void InitNewRequest(sup::dto::uint64 id);
 
+  /**
+   * @brief Add a new request for user input without discarding other outstanding requests.
+   *
+   * @param id Identifier of the new user input request.
+   * @param request The user input request itself.
+   */
+  void AddRequest(sup::dto::uint64 id, const UserInputRequest& request);
+
+  /**
+   * @brief Get all pending requests that were added with AddRequest().
+   *
+   * @return Map of request identifiers to their user input request.
+   */
+  std::map<sup::dto::uint64, UserInputRequest> GetPendingRequests() const;
+
   /**
    * @brief Wait for a client to provide user input or for interrupt.
    *
@@ -72,6 +97,17 @@ public:
    */
   std::pair<bool, UserInputReply> WaitForReply(sup::dto::uint64 id);
 
+  /**
+   * @brief Wait for a client to provide user input, for interrupt or until the deadline passes.
+   *
+   * @param id Unique index that identifies a specific request for user input.
+   * @param deadline Point in time after which the request is abandoned.
+   *
+   * @return Pair of status - reply, which is only valid when the status indicates a reply.
+   */
+  std::pair<UserInputStatus, UserInputReply> WaitForReplyUntil(
+    sup::dto::uint64 id, std::chrono::steady_clock::time_point deadline);
+
   /**
    * @brief Interrupt an ongoing user input request.
    *
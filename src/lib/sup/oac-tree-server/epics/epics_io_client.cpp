@@ -27,10 +27,16 @@
 #include <sup/oac-tree-server/i_anyvalue_manager.h>
 #include <sup/oac-tree-server/client_reply_delegator.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/variable_delta_helper.h>
 
 #include <sup/epics/pv_access_client_pv.h>
 #include <sup/oac-tree/user_input_request.h>
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -55,11 +61,35 @@ public:
 private:
   void AddMonitorPV(const std::string& channel);
 
-  void HandleUserInput(const std::string& input_server_name, const sup::dto::AnyValue& req_av);
+  void AddKeyframeMonitorPV(const std::string& var_channel);
+
+  void HandleInputRequest(const sup::dto::AnyValue& req_av);
+
+  void HandleInputRequestList(const sup::dto::AnyValue& req_list_av);
+
+  void StartUserInput(sup::dto::uint64 id, const UserInputRequest& input_request);
+
+  void HandleUserInput(sup::dto::uint64 id, const UserInputRequest& input_request);
+
+  void InterruptUserInput(const std::vector<sup::dto::uint64>& ids);
 
   IAnyValueManager& m_av_mgr;
+  std::string m_input_server_name;
   std::unique_ptr<EPICSInputClient> m_input_client;
   std::unique_ptr<ClientReplyDelegator> m_reply_delegator;
+  // Keyframe channels are only monitored once the server is known to publish them, which is
+  // detected from a monitor callback.
+  std::set<std::string> m_keyframe_channels;
+  // Input requests that were started and are still outstanding on the server, the subset of those
+  // that still wait for user input, and the tasks that wait for it. Once the server is known to
+  // publish the list of outstanding requests, the single request channel is ignored.
+  std::set<sup::dto::uint64> m_known_requests;
+  std::set<sup::dto::uint64> m_active_requests;
+  std::vector<std::future<void>> m_input_tasks;
+  bool m_use_request_list;
+  // The mutex protects the monitors, the input request bookkeeping and the halt flag:
+  bool m_halted;
+  std::mutex m_pv_mtx;
   // Order matters: destroy these client PVs before the objects that are involved in callbacks:
   std::vector<sup::epics::PvAccessClientPV> m_client_pvs;
 };
@@ -83,12 +113,35 @@ bool EPICSIOClient::AddInputHandler(const std::string& input_server_name)
 
 EPICSIOClientImpl::EPICSIOClientImpl(IAnyValueManager& av_mgr)
   : m_av_mgr{av_mgr}
+  , m_input_server_name{}
   , m_input_client{}
   , m_reply_delegator{}
+  , m_keyframe_channels{}
+  , m_known_requests{}
+  , m_active_requests{}
+  , m_input_tasks{}
+  , m_use_request_list{false}
+  , m_halted{false}
+  , m_pv_mtx{}
   , m_client_pvs{}
 {}
 
-EPICSIOClientImpl::~EPICSIOClientImpl() = default;
+EPICSIOClientImpl::~EPICSIOClientImpl()
+{
+  // Prevent callbacks from adding monitors or starting input requests while the existing ones are
+  // destroyed:
+  std::vector<sup::dto::uint64> active_ids{};
+  std::vector<std::future<void>> input_tasks{};
+  {
+    std::lock_guard<std::mutex> lk{m_pv_mtx};
+    m_halted = true;
+    active_ids.assign(m_active_requests.begin(), m_active_requests.end());
+    input_tasks = std::move(m_input_tasks);
+  }
+  // Interrupt outstanding user input, so the input tasks finish before their futures are
+  // destroyed:
+  InterruptUserInput(active_ids);
+}
 
 bool EPICSIOClientImpl::AddAnyValues(const IAnyValueIO::NameAnyValueSet& monitor_set)
 {
@@ -111,60 +164,185 @@ bool EPICSIOClientImpl::AddInputHandler(const std::string& input_server_name)
   {
     return false;
   }
+  m_input_server_name = input_server_name;
   m_input_client = std::make_unique<EPICSInputClient>(input_server_name);
   auto reply_func = std::bind(&EPICSInputClient::SetClientReply, m_input_client.get(), _1, _2);
   auto interrupt_func = std::bind(&IAnyValueManager::Interrupt, std::addressof(m_av_mgr),
                                   input_server_name, _1);
   m_reply_delegator = std::make_unique<ClientReplyDelegator>(reply_func, interrupt_func);
-  auto input_request_pv_name = GetInputRequestPVName(input_server_name);
-  IAnyValueIO::NameAnyValueSet input_pv_set;
-  (void)input_pv_set.emplace_back(input_request_pv_name, kInputRequestAnyValue);
-  auto cb = [this, input_server_name](const PvAccessClientPV::ExtendedValue& ext_val) {
+  auto req_cb = [this](const PvAccessClientPV::ExtendedValue& ext_val) {
     if (ext_val.connected)
     {
-      auto [decoded, value] = Base64DecodeAnyValue(ext_val.value);
+      auto [decoded, value] = DecodeChannelValue(ext_val.value);
       if (decoded)
       {
-        HandleUserInput(input_server_name, value);
+        HandleInputRequest(value);
       }
     }
   };
-  (void)m_client_pvs.emplace_back(input_request_pv_name, cb);
+  auto req_list_cb = [this](const PvAccessClientPV::ExtendedValue& ext_val) {
+    if (ext_val.connected)
+    {
+      auto [decoded, value] = DecodeChannelValue(ext_val.value);
+      if (decoded)
+      {
+        HandleInputRequestList(value);
+      }
+    }
+  };
+  PvAccessClientPV req_pv{GetInputRequestPVName(input_server_name), req_cb};
+  PvAccessClientPV req_list_pv{GetInputRequestListPVName(input_server_name), req_list_cb};
+  std::lock_guard<std::mutex> lk{m_pv_mtx};
+  m_client_pvs.push_back(std::move(req_pv));
+  m_client_pvs.push_back(std::move(req_list_pv));
   return true;
 }
 
 void EPICSIOClientImpl::AddMonitorPV(const std::string& channel)
 {
   using sup::epics::PvAccessClientPV;
-  auto cb = [this, channel](const PvAccessClientPV::ExtendedValue& ext_val) {
+  bool is_variable = ParseValueName(channel).val_type == ValueNameType::kVariable;
+  auto cb = [this, channel, is_variable](const PvAccessClientPV::ExtendedValue& ext_val) {
     if (ext_val.connected)
     {
-      auto [decoded, value] = Base64DecodeAnyValue(ext_val.value);
+      auto [decoded, value] = DecodeChannelValue(ext_val.value);
       if (decoded)
       {
         m_av_mgr.UpdateAnyValue(channel, value);
+        if (is_variable && IsSequencedVariableState(value))
+        {
+          AddKeyframeMonitorPV(channel);
+        }
       }
     }
   };
-  (void)m_client_pvs.emplace_back(channel, cb);
+  PvAccessClientPV client_pv{channel, cb};
+  std::lock_guard<std::mutex> lk{m_pv_mtx};
+  if (!m_halted)
+  {
+    m_client_pvs.push_back(std::move(client_pv));
+  }
+}
+
+void EPICSIOClientImpl::AddKeyframeMonitorPV(const std::string& var_channel)
+{
+  auto keyframe_channel = GetVariableKeyframePVName(var_channel);
+  {
+    std::lock_guard<std::mutex> lk{m_pv_mtx};
+    if (m_halted || !m_keyframe_channels.insert(keyframe_channel).second)
+    {
+      return;
+    }
+  }
+  AddMonitorPV(keyframe_channel);
+}
+
+void EPICSIOClientImpl::HandleInputRequest(const sup::dto::AnyValue& req_av)
+{
+  auto [success, id, input_request] = DecodeInputRequest(req_av);
+  std::vector<sup::dto::uint64> withdrawn_ids{};
+  {
+    std::lock_guard<std::mutex> lk{m_pv_mtx};
+    if (m_halted || m_use_request_list)
+    {
+      return;
+    }
+    if (success && input_request.m_request_type != InputRequestType::kInvalid)
+    {
+      if (m_known_requests.find(id) == m_known_requests.end())
+      {
+        StartUserInput(id, input_request);
+      }
+      return;
+    }
+    // A cleared request channel means that no request is outstanding anymore:
+    withdrawn_ids.assign(m_active_requests.begin(), m_active_requests.end());
+    m_known_requests.clear();
+  }
+  m_reply_delegator->InterruptAll();
+  InterruptUserInput(withdrawn_ids);
 }
 
-void EPICSIOClientImpl::HandleUserInput(const std::string& input_server_name,
-                                        const sup::dto::AnyValue& req_av)
+void EPICSIOClientImpl::HandleInputRequestList(const sup::dto::AnyValue& req_list_av)
 {
-  auto req = DecodeInputRequest(req_av);
-  auto success = std::get<0>(req);
-  auto id = std::get<1>(req);
-  auto input_request = std::get<2>(req);
-  if (!success || input_request.m_request_type == InputRequestType::kInvalid)
+  auto [success, input_requests] = DecodeInputRequestList(req_list_av);
+  if (!success)
   {
-    m_reply_delegator->InterruptAll();
     return;
   }
-  auto reply = m_av_mgr.GetUserInput(input_server_name, id, input_request);
+  std::vector<sup::dto::uint64> withdrawn_ids{};
+  {
+    std::lock_guard<std::mutex> lk{m_pv_mtx};
+    if (m_halted)
+    {
+      return;
+    }
+    m_use_request_list = true;
+    for (auto iter = m_known_requests.begin(); iter != m_known_requests.end();)
+    {
+      auto id = *iter;
+      if (input_requests.find(id) != input_requests.end())
+      {
+        ++iter;
+        continue;
+      }
+      if (m_active_requests.find(id) != m_active_requests.end())
+      {
+        withdrawn_ids.push_back(id);
+      }
+      iter = m_known_requests.erase(iter);
+    }
+    for (const auto& [id, input_request] : input_requests)
+    {
+      if (input_request.m_request_type != InputRequestType::kInvalid &&
+          m_known_requests.find(id) == m_known_requests.end())
+      {
+        StartUserInput(id, input_request);
+      }
+    }
+  }
+  InterruptUserInput(withdrawn_ids);
+}
+
+void EPICSIOClientImpl::StartUserInput(sup::dto::uint64 id, const UserInputRequest& input_request)
+{
+  // Called with the mutex locked. User input blocks, so each request waits on its own task, which
+  // allows requests of the same server to be answered in any order:
+  (void)m_known_requests.insert(id);
+  (void)m_active_requests.insert(id);
+  auto is_finished = [](const std::future<void>& task) {
+    return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  };
+  (void)m_input_tasks.erase(
+    std::remove_if(m_input_tasks.begin(), m_input_tasks.end(), is_finished), m_input_tasks.end());
+  m_input_tasks.push_back(std::async(std::launch::async, [this, id, input_request]() {
+    HandleUserInput(id, input_request);
+  }));
+}
+
+void EPICSIOClientImpl::HandleUserInput(sup::dto::uint64 id, const UserInputRequest& input_request)
+{
+  auto reply = m_av_mgr.GetUserInput(m_input_server_name, id, input_request);
+  {
+    std::lock_guard<std::mutex> lk{m_pv_mtx};
+    (void)m_active_requests.erase(id);
+    // Do not reply to requests that the server withdrew in the meantime:
+    if (m_halted || m_known_requests.find(id) == m_known_requests.end())
+    {
+      return;
+    }
+  }
   m_reply_delegator->QueueReply(id, reply);
 }
 
+void EPICSIOClientImpl::InterruptUserInput(const std::vector<sup::dto::uint64>& ids)
+{
+  for (auto id : ids)
+  {
+    m_av_mgr.Interrupt(m_input_server_name, id);
+  }
+}
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
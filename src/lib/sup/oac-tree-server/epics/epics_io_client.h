@@ -34,6 +34,13 @@ namespace oac_tree_server
 class EPICSIOClientImpl;
 /**
  * @brief EPICSIOClient implements IAnyValueIO using EPICS PvAccess.
+ *
+ * @details When a variable channel carries delta encoded updates, the client also monitors the
+ * keyframe channel of that variable and forwards its values to the IAnyValueManager.
+ *
+ * User input requests are taken from the list of outstanding requests that the input server
+ * publishes, so several requests can wait for user input at the same time. Servers that do not
+ * publish this list are served one request at a time from their single request channel.
  */
 class EPICSIOClient : public IAnyValueIO
 {
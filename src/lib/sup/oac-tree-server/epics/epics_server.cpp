@@ -22,17 +22,39 @@
 
 #include "epics_server.h"
 
+#include "anyvalue_update_queue.h"
+#include "anyvalue_update_ring.h"
+
 #include <sup/oac-tree-server/exceptions.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/variable_delta_helper.h>
 
 #include <sup/epics/pv_access_server.h>
+#include <sup/protocol/base64_variable_codec.h>
+
+#include <set>
+
+namespace
+{
+std::unique_ptr<sup::oac_tree_server::IAnyValueUpdateQueue> CreateUpdateQueue(
+  const sup::oac_tree_server::EPICSServerConfig& config);
+bool IsStateChannel(const std::string& name);
+bool IsVariableChannel(const std::string& name);
+}  // unnamed namespace
 
 namespace sup
 {
 namespace oac_tree_server
 {
 EPICSServer::EPICSServer(const IAnyValueIO::NameAnyValueSet& name_value_set)
-  : m_update_queue{}
+  : EPICSServer{name_value_set, EPICSServerConfig{}}
+{}
+
+EPICSServer::EPICSServer(const IAnyValueIO::NameAnyValueSet& name_value_set,
+                         const EPICSServerConfig& config)
+  : m_native_channels{config.m_native_channels}
+  , m_error_handler{config.m_error_handler}
+  , m_update_queue{CreateUpdateQueue(config)}
   , m_update_future{}
 {
   m_update_future = std::async(std::launch::async, &EPICSServer::UpdateLoop, this, name_value_set);
@@ -40,35 +62,186 @@ EPICSServer::EPICSServer(const IAnyValueIO::NameAnyValueSet& name_value_set)
 
 EPICSServer::~EPICSServer()
 {
-  m_update_queue.PushExit();
+  m_update_queue->PushExit();
 }
 
 void EPICSServer::UpdateAnyValue(const std::string& name, const sup::dto::AnyValue& value)
 {
-  const auto update_val = Base64EncodeAnyValue(value);
-  m_update_queue.Push(name, update_val);
+  if (IsStateChannel(name))
+  {
+    m_update_queue->Push(name, value);
+  }
+  else if (ParseValueName(name).val_type == ValueNameType::kVariableKeyframe)
+  {
+    // Clients need the latest keyframe to decode the deltas of the variable channel:
+    m_update_queue->PushKeyframe(name, value);
+  }
+  else
+  {
+    m_update_queue->PushEntry(name, value);
+  }
+}
+
+void EPICSServer::AddAnyValues(const IAnyValueIO::NameAnyValueSet& name_value_set)
+{
+  for (const auto& [name, value] : name_value_set)
+  {
+    m_update_queue->PushAddVariable(name, value);
+  }
+}
+
+void EPICSServer::RemoveAnyValues(const std::set<std::string>& names)
+{
+  for (const auto& name : names)
+  {
+    m_update_queue->PushRemoveVariable(name);
+  }
 }
 
 void EPICSServer::UpdateLoop(const IAnyValueIO::NameAnyValueSet& name_value_set)
 {
   sup::epics::PvAccessServer server;
+  // State channels are published natively when their initial value allows it, since their type
+  // never changes afterwards. Entry channels may carry values of different types (e.g. batches).
+  std::set<std::string> native_channels;
+  // Removed channels keep their PV, which is reused when they are added again:
+  std::set<std::string> removed_channels;
+  // Variable channels only get a typed value with their first update, so their PV is created then:
+  std::set<std::string> deferred_channels;
+  auto create_func = [this, &server, &native_channels](const std::string& channel,
+                                                       const sup::dto::AnyValue& value) {
+    // Delta encoded variable updates change type between keyframes and deltas:
+    if (m_native_channels && IsStateChannel(channel) && IsNativeChannelValue(value) &&
+        !IsSequencedVariableState(value))
+    {
+      (void)native_channels.insert(channel);
+      server.AddVariable(channel, value);
+      return;
+    }
+    auto [encoded, base64value] = sup::protocol::Base64VariableCodec::Encode(value);
+    if (!encoded)
+    {
+      ReportError("EPICSServer: could not encode initial value of channel [" + channel
+                  + "]; channel is not served");
+      return;
+    }
+    server.AddVariable(channel, base64value);
+  };
+  auto update_func = [this, &server, &native_channels, &removed_channels, &deferred_channels,
+                      &create_func](const std::string& channel, const sup::dto::AnyValue& value) {
+    if (removed_channels.find(channel) != removed_channels.end())
+    {
+      return;
+    }
+    if (deferred_channels.erase(channel) > 0)
+    {
+      create_func(channel, value);
+      return;
+    }
+    if (native_channels.find(channel) != native_channels.end())
+    {
+      if (!server.SetValue(channel, value))
+      {
+        ReportError("EPICSServer: could not publish value of native channel [" + channel + "]");
+      }
+      return;
+    }
+    auto [encoded, base64value] = sup::protocol::Base64VariableCodec::Encode(value);
+    if (!encoded)
+    {
+      ReportError("EPICSServer: could not encode value of channel [" + channel + "]");
+      return;
+    }
+    if (!server.SetValue(channel, base64value))
+    {
+      ReportError("EPICSServer: could not publish value of channel [" + channel + "]");
+    }
+  };
+  auto add_func = [this, &native_channels, &removed_channels, &deferred_channels, &create_func,
+                   &update_func](const std::string& channel, const sup::dto::AnyValue& value) {
+    if (removed_channels.erase(channel) > 0)
+    {
+      // A native PV cannot take the untyped initial value of a variable:
+      if (native_channels.find(channel) == native_channels.end() || IsNativeChannelValue(value))
+      {
+        update_func(channel, value);
+      }
+      return;
+    }
+    if (m_native_channels && IsVariableChannel(channel) && !IsNativeChannelValue(value))
+    {
+      (void)deferred_channels.insert(channel);
+      return;
+    }
+    create_func(channel, value);
+  };
+  auto remove_func = [&removed_channels, &deferred_channels](const std::string& channel) {
+    if (deferred_channels.erase(channel) > 0)
+    {
+      return;
+    }
+    (void)removed_channels.insert(channel);
+  };
   for (const auto& [name, value] : name_value_set)
   {
-    server.AddVariable(name, Base64EncodeAnyValue(value));
+    add_func(name, value);
   }
   server.Start();
   bool exit = false;
-  auto update_func = [&server](const std::string& channel, const sup::dto::AnyValue& value) {
-    server.SetValue(channel, value);
-  };
   while (!exit)
   {
-    m_update_queue.WaitForNonEmpty();
-    auto queue = m_update_queue.PopCommands();
-    exit = ProcessCommandQueue(queue, update_func);
+    m_update_queue->WaitForNonEmpty();
+    auto queue = m_update_queue->PopCommands();
+    exit = ProcessCommandQueue(queue, update_func, add_func, remove_func);
+  }
+}
+
+void EPICSServer::ReportError(const std::string& message) const
+{
+  if (m_error_handler)
+  {
+    m_error_handler(message);
   }
 }
 
 }  // namespace oac_tree_server
 
 }  // namespace sup
+
+namespace
+{
+using namespace sup::oac_tree_server;
+
+std::unique_ptr<IAnyValueUpdateQueue> CreateUpdateQueue(const EPICSServerConfig& config)
+{
+  if (config.m_lock_free_queue)
+  {
+    return std::make_unique<AnyValueUpdateRing>(config.m_queue_capacity,
+                                                config.m_overflow_policy);
+  }
+  auto mode = config.m_coalesce_updates ? AnyValueUpdateQueue::kCoalescing
+                                        : AnyValueUpdateQueue::kSequential;
+  return std::make_unique<AnyValueUpdateQueue>(mode);
+}
+
+bool IsStateChannel(const std::string& name)
+{
+  switch (ParseValueName(name).val_type)
+  {
+  case ValueNameType::kInstruction:
+  case ValueNameType::kVariable:
+  case ValueNameType::kJobStatus:
+  case ValueNameType::kBreakpointInstruction:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
+bool IsVariableChannel(const std::string& name)
+{
+  return ParseValueName(name).val_type == ValueNameType::kVariable;
+}
+
+}  // unnamed namespace
@@ -23,11 +23,15 @@
 #ifndef SUP_OAC_TREE_SERVER_EPICS_SERVER_H_
 #define SUP_OAC_TREE_SERVER_EPICS_SERVER_H_
 
-#include "anyvalue_update_queue.h"
+#include "i_anyvalue_update_queue.h"
 
+#include <sup/oac-tree-server/epics_server_config.h>
 #include <sup/oac-tree-server/i_anyvalue_manager.h>
 
 #include <future>
+#include <memory>
+#include <set>
+#include <string>
 
 namespace sup
 {
@@ -37,6 +41,16 @@ namespace oac_tree_server
 /**
  * @brief EPICSServer serves a set of PvAccess variables. The corresponding PVs are created during
  * construction and torn down upon destruction.
+ *
+ * @details Values are queued unencoded and only base64 encoded by the thread that publishes them,
+ * so callers never pay for the encoding. Values that cannot be encoded or published are reported to
+ * the configured error handler (see EPICSServerConfig) and the channel keeps its value. When
+ * configured to publish native channels, state AnyValues (instructions, variables, job state and
+ * breakpoints) whose initial value can be represented natively (see IsNativeChannelValue) are
+ * published without base64 encoding. The PV of a variable whose initial value cannot be
+ * represented natively is only created with its first update, so that its representation can be
+ * chosen based on a typed value. Updates with a different type than the value that created a
+ * native PV cannot be published and are reported.
  */
 class EPICSServer
 {
@@ -49,6 +63,17 @@ public:
    * @note It is the user's responsibility to ensure the provided names are unique.
    */
   explicit EPICSServer(const IAnyValueIO::NameAnyValueSet& name_value_set);
+
+  /**
+   * @brief Construct a new EPICSServer object with the given configuration and immediately start
+   * serving the provided values.
+   *
+   * @param name_value_set List of name/value pairs to serve.
+   * @param config Configuration of the server.
+   *
+   * @note It is the user's responsibility to ensure the provided names are unique.
+   */
+  EPICSServer(const IAnyValueIO::NameAnyValueSet& name_value_set, const EPICSServerConfig& config);
   ~EPICSServer();
 
   // No copy or move
@@ -65,9 +90,35 @@ public:
    */
   void UpdateAnyValue(const std::string& name, const sup::dto::AnyValue& value);
 
+  /**
+   * @brief Add AnyValues to the running server. They are published after all previously queued
+   * updates.
+   *
+   * @param name_value_set List of name/value pairs to add.
+   *
+   * @note It is the user's responsibility to ensure the provided names are unique and differ from
+   * the ones already served.
+   */
+  void AddAnyValues(const IAnyValueIO::NameAnyValueSet& name_value_set);
+
+  /**
+   * @brief Remove AnyValues from the running server. Updates that are queued afterwards for these
+   * names are ignored until they are added again.
+   *
+   * @param names Names of the AnyValues to remove.
+   *
+   * @note PvAccess variables cannot be removed from a running server, so their PVs keep their last
+   * value. When a removed name is added again, its PV is reused and takes the new initial value.
+   * For a native channel, this requires the new value to have the same type.
+   */
+  void RemoveAnyValues(const std::set<std::string>& names);
+
 private:
   void UpdateLoop(const IAnyValueIO::NameAnyValueSet& name_value_set);
-  AnyValueUpdateQueue m_update_queue;
+  void ReportError(const std::string& message) const;
+  const bool m_native_channels;
+  const EPICSServerConfig::ErrorHandler m_error_handler;
+  std::unique_ptr<IAnyValueUpdateQueue> m_update_queue;
   std::future<void> m_update_future;
 };
 
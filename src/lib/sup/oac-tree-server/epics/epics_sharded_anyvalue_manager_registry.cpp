@@ -0,0 +1,124 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "epics_sharded_anyvalue_manager_registry.h"
+
+#include "epics_anyvalue_manager.h"
+
+#include <thread>
+
+namespace
+{
+sup::dto::uint32 GetValidNumberOfShards(sup::dto::uint32 n_shards);
+sup::oac_tree_server::EPICSServerConfig GetShardConfig(
+  const sup::oac_tree_server::EPICSServerConfig& config);
+}  // unnamed namespace
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+EPICSShardedAnyValueManagerRegistry::EPICSShardedAnyValueManagerRegistry(sup::dto::uint32 n_shards)
+  : EPICSShardedAnyValueManagerRegistry{n_shards, EPICSServerConfig{}}
+{}
+
+EPICSShardedAnyValueManagerRegistry::EPICSShardedAnyValueManagerRegistry(
+  sup::dto::uint32 n_shards, const EPICSServerConfig& config)
+  : m_shards{}
+  , m_n_assigned{}
+  , m_assigned_shards{}
+  , m_mtx{}
+{
+  auto valid_n_shards = GetValidNumberOfShards(n_shards);
+  auto shard_config = GetShardConfig(config);
+  m_shards.reserve(valid_n_shards);
+  for (sup::dto::uint32 idx = 0; idx < valid_n_shards; ++idx)
+  {
+    (void)m_shards.emplace_back(std::make_unique<EPICSAnyValueManager>(shard_config));
+  }
+  m_n_assigned.resize(valid_n_shards, 0);
+}
+
+EPICSShardedAnyValueManagerRegistry::~EPICSShardedAnyValueManagerRegistry() = default;
+
+IAnyValueManager& EPICSShardedAnyValueManagerRegistry::GetAnyValueManager(sup::dto::uint32 idx)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  auto iter = m_assigned_shards.find(idx);
+  if (iter != m_assigned_shards.end())
+  {
+    return *m_shards[iter->second];
+  }
+  auto shard_idx = SelectShard();
+  m_assigned_shards[idx] = shard_idx;
+  ++m_n_assigned[shard_idx];
+  return *m_shards[shard_idx];
+}
+
+sup::dto::uint32 EPICSShardedAnyValueManagerRegistry::GetNumberOfShards() const
+{
+  return static_cast<sup::dto::uint32>(m_shards.size());
+}
+
+std::size_t EPICSShardedAnyValueManagerRegistry::SelectShard() const
+{
+  std::size_t result = 0;
+  auto min_n_values = m_shards[0]->GetNumberOfAnyValues();
+  for (std::size_t idx = 1; idx < m_shards.size(); ++idx)
+  {
+    auto n_values = m_shards[idx]->GetNumberOfAnyValues();
+    if (n_values < min_n_values ||
+        (n_values == min_n_values && m_n_assigned[idx] < m_n_assigned[result]))
+    {
+      result = idx;
+      min_n_values = n_values;
+    }
+  }
+  return result;
+}
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+namespace
+{
+sup::dto::uint32 GetValidNumberOfShards(sup::dto::uint32 n_shards)
+{
+  if (n_shards > 0)
+  {
+    return n_shards;
+  }
+  auto n_threads = static_cast<sup::dto::uint32>(std::thread::hardware_concurrency());
+  return n_threads > 0 ? n_threads : 1;
+}
+
+sup::oac_tree_server::EPICSServerConfig GetShardConfig(
+  const sup::oac_tree_server::EPICSServerConfig& config)
+{
+  auto result = config;
+  result.m_single_server = true;
+  return result;
+}
+
+}  // unnamed namespace
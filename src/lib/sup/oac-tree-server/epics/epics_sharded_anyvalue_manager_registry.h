@@ -0,0 +1,82 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_EPICS_SHARDED_ANYVALUE_MANAGER_REGISTRY_H_
+#define SUP_OAC_TREE_SERVER_EPICS_SHARDED_ANYVALUE_MANAGER_REGISTRY_H_
+
+#include <sup/oac-tree-server/epics_server_config.h>
+#include <sup/oac-tree-server/i_anyvalue_manager_registry.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+class EPICSAnyValueManager;
+
+/**
+ * @brief EPICS PvAccess implementation of IAnyValueManagerRegistry that publishes through a fixed
+ * pool of shards. Each shard is an EPICSAnyValueManager that uses a single server and update
+ * thread, so the number of publishing threads does not depend on the number of jobs.
+ *
+ * @details The first time an index is requested, it is assigned to the shard that currently
+ * publishes the least AnyValues. Ties are broken by the number of indices already assigned to the
+ * shard and then by the shard's index. Later requests for the same index return the same shard.
+ */
+class EPICSShardedAnyValueManagerRegistry : public IAnyValueManagerRegistry
+{
+public:
+  /**
+   * @brief Construct a registry with the given number of shards.
+   *
+   * @param n_shards Number of shards. Zero means the number of hardware threads.
+   */
+  explicit EPICSShardedAnyValueManagerRegistry(sup::dto::uint32 n_shards);
+  EPICSShardedAnyValueManagerRegistry(sup::dto::uint32 n_shards, const EPICSServerConfig& config);
+  EPICSShardedAnyValueManagerRegistry(const EPICSShardedAnyValueManagerRegistry &) = delete;
+  EPICSShardedAnyValueManagerRegistry(EPICSShardedAnyValueManagerRegistry &&) = delete;
+  EPICSShardedAnyValueManagerRegistry &operator=(
+    const EPICSShardedAnyValueManagerRegistry &) = delete;
+  EPICSShardedAnyValueManagerRegistry &operator=(EPICSShardedAnyValueManagerRegistry &&) = delete;
+  virtual ~EPICSShardedAnyValueManagerRegistry();
+
+  IAnyValueManager& GetAnyValueManager(sup::dto::uint32 idx) override;
+
+  sup::dto::uint32 GetNumberOfShards() const;
+
+private:
+  std::size_t SelectShard() const;
+  std::vector<std::unique_ptr<EPICSAnyValueManager>> m_shards;
+  std::vector<sup::dto::uint32> m_n_assigned;
+  std::map<sup::dto::uint32, std::size_t> m_assigned_shards;
+  mutable std::mutex m_mtx;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_EPICS_SHARDED_ANYVALUE_MANAGER_REGISTRY_H_
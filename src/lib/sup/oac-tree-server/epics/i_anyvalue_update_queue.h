@@ -0,0 +1,114 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_I_ANYVALUE_UPDATE_QUEUE_H_
+#define SUP_OAC_TREE_SERVER_I_ANYVALUE_UPDATE_QUEUE_H_
+
+#include "anyvalue_update_command.h"
+
+#include <sup/dto/anyvalue.h>
+
+#include <deque>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Interface for threadsafe queues of AnyValue update commands with a single consumer.
+ */
+class IAnyValueUpdateQueue
+{
+public:
+  IAnyValueUpdateQueue() = default;
+  IAnyValueUpdateQueue(const IAnyValueUpdateQueue&) = delete;
+  IAnyValueUpdateQueue(IAnyValueUpdateQueue&&) = delete;
+  IAnyValueUpdateQueue& operator=(const IAnyValueUpdateQueue&) = delete;
+  IAnyValueUpdateQueue& operator=(IAnyValueUpdateQueue&&) = delete;
+  virtual ~IAnyValueUpdateQueue();
+
+  /**
+   * @brief Push new PV update of a channel that represents a state. Implementations may coalesce
+   * such updates.
+   *
+   * @param name Name of AnyValue to update.
+   * @param value Value for update.
+   */
+  virtual void Push(const std::string& channel, const sup::dto::AnyValue& value) = 0;
+
+  /**
+   * @brief Push new PV update to queue that is part of a stream of entries (e.g. log entries), where
+   * every single update needs to be published. Such updates are never coalesced.
+   *
+   * @param name Name of AnyValue to update.
+   * @param value Value for update.
+   */
+  virtual void PushEntry(const std::string& channel, const sup::dto::AnyValue& value) = 0;
+
+  /**
+   * @brief Push new PV update that later updates of other channels depend on, e.g. a variable
+   * keyframe. Such updates are never coalesced or dropped.
+   *
+   * @param name Name of AnyValue to update.
+   * @param value Value for update.
+   */
+  virtual void PushKeyframe(const std::string& channel, const sup::dto::AnyValue& value) = 0;
+
+  /**
+   * @brief Push a command to add a new AnyValue with the given initial value.
+   *
+   * @param name Name of AnyValue to add.
+   * @param value Initial value.
+   */
+  virtual void PushAddVariable(const std::string& channel, const sup::dto::AnyValue& value) = 0;
+
+  /**
+   * @brief Push a command to remove an AnyValue. Updates of the same channel that were pushed
+   * before are never coalesced with updates pushed afterwards.
+   *
+   * @param name Name of AnyValue to remove.
+   */
+  virtual void PushRemoveVariable(const std::string& channel) = 0;
+
+  /**
+   * @brief Push a command that will terminate any processing loops.
+   */
+  virtual void PushExit() = 0;
+
+  /**
+   * @brief Blocks until the queue becomes non-empty.
+   */
+  virtual void WaitForNonEmpty() = 0;
+
+  /**
+   * @brief Pops out all queued commands.
+   */
+  virtual std::deque<AnyValueUpdateCommand> PopCommands() = 0;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_I_ANYVALUE_UPDATE_QUEUE_H_
@@ -23,6 +23,7 @@
 #ifndef SUP_OAC_TREE_SERVER_EPICS_CLIENT_UTILS_H_
 #define SUP_OAC_TREE_SERVER_EPICS_CLIENT_UTILS_H_
 
+#include <sup/oac-tree-server/epics_server_config.h>
 #include <sup/oac-tree-server/i_anyvalue_io.h>
 #include <sup/oac-tree-server/i_anyvalue_manager_registry.h>
 #include <sup/oac-tree-server/i_job_manager.h>
@@ -44,6 +45,21 @@ std::unique_ptr<IJobManager> CreateEPICSJobManager(const std::string& server_nam
 std::unique_ptr<IAnyValueManagerRegistry> CreateEPICSAnyValueManagerRegistry(
     sup::dto::uint32 n_managers);
 
+std::unique_ptr<IAnyValueManagerRegistry> CreateEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_managers, const EPICSServerConfig& config);
+
+/**
+ * @brief Create a registry that publishes the AnyValues of all jobs through a fixed number of
+ * shards, each with a single server and update thread. Jobs are assigned to the least loaded shard.
+ *
+ * @param n_shards Number of shards. Zero means the number of hardware threads.
+ */
+std::unique_ptr<IAnyValueManagerRegistry> CreateShardedEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_shards);
+
+std::unique_ptr<IAnyValueManagerRegistry> CreateShardedEPICSAnyValueManagerRegistry(
+    sup::dto::uint32 n_shards, const EPICSServerConfig& config);
+
 }  // namespace utils
 
 }  // namespace oac_tree_server
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_EPICS_SERVER_CONFIG_H_
+#define SUP_OAC_TREE_SERVER_EPICS_SERVER_CONFIG_H_
+
+#include <sup/dto/basic_scalar_types.h>
+
+#include <functional>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Configuration of the EPICS servers that publish the AnyValues of jobs.
+ */
+struct EPICSServerConfig
+{
+  /**
+   * @brief Function that reports errors that occur while publishing values.
+   */
+  using ErrorHandler = std::function<void(const std::string&)>;
+
+  /**
+   * @brief Policy for a bounded update queue when it is full.
+   */
+  enum OverflowPolicy : sup::dto::uint32
+  {
+    kBlock = 0,   // Block the publishing thread until there is room in the queue.
+    kDropOldest,  // Drop the oldest value update or entry in the queue.
+    kCoalesce     // Keep only the latest value of state channels until the queue is drained.
+  };
+
+  /**
+   * @brief When true, pending updates of channels that represent a state (instructions, variables,
+   * job state and breakpoint instruction) are coalesced, so that only their latest value is
+   * published. Channels that publish entries (log, messages, output values, input requests) are
+   * never coalesced.
+   */
+  bool m_coalesce_updates = false;
+
+  /**
+   * @brief When true, each EPICSAnyValueManager publishes all its AnyValues through a single
+   * server and update thread, instead of creating a new server for every set of AnyValues.
+   */
+  bool m_single_server = false;
+
+  /**
+   * @brief When true, updates are queued in a bounded lock-free ring buffer instead of a mutex
+   * protected queue. In that case, m_coalesce_updates is ignored and m_overflow_policy defines
+   * what happens when the ring buffer is full.
+   */
+  bool m_lock_free_queue = false;
+
+  /**
+   * @brief Capacity of the lock-free ring buffer. It is rounded up to a power of two.
+   */
+  sup::dto::uint32 m_queue_capacity = 1024;
+
+  /**
+   * @brief Policy to apply when the lock-free ring buffer is full. Commands that add AnyValues are
+   * never dropped or coalesced, nor are entries (e.g. log entries) when coalescing.
+   */
+  OverflowPolicy m_overflow_policy = kBlock;
+
+  /**
+   * @brief When true, state AnyValues whose initial value can be represented as a PvAccess
+   * structure are published natively instead of base64 encoded. This reduces bandwidth and
+   * encoding overhead, but requires clients that support protocol version 1.1: the server does not
+   * know which clients are connected, so older clients can no longer decode these channels.
+   * Variables are judged by their first update instead, since their initial value has no type yet.
+   * Delta encoded variable updates are always base64 encoded.
+   */
+  bool m_native_channels = false;
+
+  /**
+   * @brief Called with a description of each value that could not be published, e.g. because it
+   * could not be encoded. It is called from the update thread of the server. When empty, these
+   * errors are ignored.
+   */
+  ErrorHandler m_error_handler;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_EPICS_SERVER_CONFIG_H_
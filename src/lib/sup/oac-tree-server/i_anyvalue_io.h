@@ -100,6 +100,16 @@ IAnyValueIO::NameAnyValueSet GetInitialValueSet(const std::string& job_prefix,
 IAnyValueIO::NameAnyValueSet GetInstructionValueSet(const std::string& job_prefix,
                                                          sup::dto::uint32 n_instr);
 
+/**
+ * @brief Get the set of AnyValues that carry the keyframes of delta encoded variable updates.
+ *
+ * @param job_prefix Job specific prefix to use for the AnyValue names.
+ * @param n_vars Number of variables in the job.
+ * @return List of pairs of AnyValue names and initial values for all variable keyframes.
+ */
+IAnyValueIO::NameAnyValueSet GetVariableKeyframeValueSet(const std::string& job_prefix,
+                                                         sup::dto::uint32 n_vars);
+
 /**
  * @brief AnyValueIOFactoryFunction defines the signature of a factory function that can be injected
  * into other classes and that will be used to create an IAnyValueIO that will forward all its
@@ -29,6 +29,9 @@
 #include <sup/oac-tree/user_input_reply.h>
 #include <sup/oac-tree/user_input_request.h>
 
+#include <chrono>
+#include <utility>
+
 namespace sup
 {
 namespace oac_tree_server
@@ -75,6 +78,21 @@ public:
   virtual UserInputReply GetUserInput(const std::string& input_server_name, sup::dto::uint64 id,
                                       const UserInputRequest& request) = 0;
 
+  /**
+   * @brief Get user input using the given input server and request information, abandoning the
+   * request when no reply was received before the deadline. The default implementation ignores
+   * the deadline and reports an invalid reply from GetUserInput() as interrupted.
+   *
+   * @param input_server_name Name of the input server.
+   * @param id Identification of the user input request.
+   * @param request Description of the input requested.
+   * @param deadline Point in time after which the request is abandoned.
+   * @return Pair of status - response from the user, which is only valid for a reply.
+   */
+  virtual std::pair<UserInputStatus, UserInputReply> GetUserInputUntil(
+    const std::string& input_server_name, sup::dto::uint64 id, const UserInputRequest& request,
+    std::chrono::steady_clock::time_point deadline);
+
   /**
    * @brief Interrupt a user input request.
    *
@@ -85,6 +103,29 @@ public:
    * @param id Identification of the user input request to interrupt.
    */
   virtual void Interrupt(const std::string& input_server_name, sup::dto::uint64 id) = 0;
+
+  /**
+   * @brief Stop managing the AnyValues with the given names, e.g. when the job that published
+   * them is torn down. The default implementation does not support this and returns false.
+   *
+   * @note Callers need to ensure that these AnyValues are no longer updated concurrently.
+   *
+   * @param names Names of the managed AnyValues to remove.
+   * @return true on success. Failure may include unknown names or AnyValues that cannot be
+   * removed separately from others.
+   */
+  virtual bool RemoveAnyValues(const std::set<std::string>& names);
+
+  /**
+   * @brief Remove the input handler with the given name, e.g. when the job that used it is torn
+   * down. The default implementation does not support this and returns false.
+   *
+   * @note Callers need to ensure that no user input is requested concurrently from this handler.
+   *
+   * @param input_server_name Name of the input server.
+   * @return true on success.
+   */
+  virtual bool RemoveInputHandler(const std::string& input_server_name);
 };
 
 }  // namespace oac_tree_server
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_I_ASYNC_JOB_MANAGER_H_
+#define SUP_OAC_TREE_SERVER_I_ASYNC_JOB_MANAGER_H_
+
+#include <sup/oac-tree-server/i_job_manager.h>
+
+#include <future>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief IAsyncJobManager defines an asynchronous variant of the IJobManager API. Each call
+ * returns immediately with a future that will hold the result of that specific request, or the
+ * exception it threw. Callers are not blocked while a request is pending, e.g. to poll several
+ * servers from a single thread. How many requests are actually executed concurrently depends on
+ * the implementation.
+ */
+class IAsyncJobManager
+{
+public:
+  IAsyncJobManager() = default;
+  IAsyncJobManager(const IAsyncJobManager &) = delete;
+  IAsyncJobManager(IAsyncJobManager &&) = delete;
+  IAsyncJobManager &operator=(const IAsyncJobManager &) = delete;
+  IAsyncJobManager &operator=(IAsyncJobManager &&) = delete;
+  virtual ~IAsyncJobManager();
+
+  /**
+   * @brief Request the server prefix. See IJobManager::GetServerPrefix.
+   */
+  virtual std::future<std::string> GetServerPrefix() const = 0;
+
+  /**
+   * @brief Request the number of jobs. See IJobManager::GetNumberOfJobs.
+   */
+  virtual std::future<sup::dto::uint32> GetNumberOfJobs() const = 0;
+
+  /**
+   * @brief Request the JobInfo of a single job. See IJobManager::GetJobInfo.
+   */
+  virtual std::future<sup::oac_tree::JobInfo> GetJobInfo(sup::dto::uint32 job_idx) const = 0;
+
+  /**
+   * @brief Request the JobInfo of multiple jobs. See IJobManager::GetAllJobInfos.
+   */
+  virtual std::future<JobManagerInfo> GetAllJobInfos(
+    const std::vector<sup::dto::uint32>& job_indices) const = 0;
+
+  /**
+   * @brief Request the generation numbers of all jobs. See IJobManager::GetJobGenerations.
+   */
+  virtual std::future<std::vector<sup::dto::uint64>> GetJobGenerations() const = 0;
+
+  /**
+   * @brief Request the recent output entries of a job. See IJobManager::GetOutputEntries.
+   */
+  virtual std::future<OutputEntries> GetOutputEntries(
+    sup::dto::uint32 job_idx, const OutputEntryIndices& last_indices) const = 0;
+
+  /**
+   * @brief (De)activate a breakpoint. See IJobManager::EditBreakpoint.
+   */
+  virtual std::future<void> EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
+                                           bool breakpoint_active) = 0;
+
+  /**
+   * @brief (De)activate multiple breakpoints. See IJobManager::EditBreakpoints.
+   */
+  virtual std::future<void> EditBreakpoints(sup::dto::uint32 job_idx,
+                                            const std::set<sup::dto::uint32>& instr_indices,
+                                            bool breakpoint_active) = 0;
+
+  /**
+   * @brief Send a JobCommand to a single job. See IJobManager::SendJobCommand.
+   */
+  virtual std::future<void> SendJobCommand(sup::dto::uint32 job_idx,
+                                           sup::oac_tree::JobCommand command) = 0;
+
+  /**
+   * @brief Send a JobCommand to multiple jobs. See IJobManager::SendJobCommands.
+   */
+  virtual std::future<std::vector<bool>> SendJobCommands(
+    const std::vector<sup::dto::uint32>& job_indices, sup::oac_tree::JobCommand command) = 0;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_I_ASYNC_JOB_MANAGER_H_
@@ -23,16 +23,33 @@
 #ifndef SUP_OAC_TREE_SERVER_I_JOB_MANAGER_H_
 #define SUP_OAC_TREE_SERVER_I_JOB_MANAGER_H_
 
+#include <sup/oac-tree-server/output_entry_types.h>
+
 #include <sup/oac-tree/job_commands.h>
 #include <sup/oac-tree/job_info.h>
 
+#include <set>
 #include <string>
+#include <vector>
 
 namespace sup
 {
 namespace oac_tree_server
 {
 
+/**
+ * @brief Server prefix, number of jobs and JobInfo objects of a selection of jobs, as retrieved
+ * in a single call. The job index of each JobInfo object is stored at the same position in the
+ * list of job indices, since removed jobs are left out when all jobs are requested.
+ */
+struct JobManagerInfo
+{
+  std::string m_server_prefix;
+  sup::dto::uint32 m_n_jobs;
+  std::vector<sup::oac_tree::JobInfo> m_job_infos;
+  std::vector<sup::dto::uint32> m_job_indices;
+};
+
 /**
  * @brief IJobManager defines the API for implementations that manage multiple jobs. The API
  * allows consumers to query static information about the jobs: number of jobs, instruction tree
@@ -72,6 +89,53 @@ public:
    */
   virtual sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx) const = 0;
 
+  /**
+   * @brief Get the number of instructions of the specified job. The default implementation
+   * retrieves this from the job's JobInfo. Implementations that can provide this number without
+   * copying the whole JobInfo should override this method.
+   *
+   * @param job_idx Index that identifies a single job.
+   * @return Number of instructions of the requested job.
+   */
+  virtual sup::dto::uint32 GetNumberOfInstructions(sup::dto::uint32 job_idx) const;
+
+  /**
+   * @brief Get the server prefix, the number of jobs and the JobInfo of the specified jobs at once.
+   * This allows clients to attach to many jobs without a separate request for each of them. The
+   * default implementation calls GetJobInfo for each job and, when all jobs are requested, skips
+   * jobs for which this throws an InvalidOperationException.
+   *
+   * @param job_indices Indices that identify the requested jobs. An empty list requests all jobs,
+   * except those that were removed from the server.
+   * @return Server prefix, number of jobs and JobInfo objects in the order of the requested jobs,
+   * together with their job indices.
+   */
+  virtual JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const;
+
+  /**
+   * @brief Get the generation number of each job. A job's generation identifies its structure:
+   * as long as the generation is unchanged, so is its JobInfo. This allows clients to cache
+   * JobInfo objects and only check the generations before reusing them. A generation equal to
+   * zero is never issued and means that the generation is unknown. The default implementation
+   * reports all generations as unknown.
+   *
+   * @return Generation number of each job, indexed by job index.
+   */
+  virtual std::vector<sup::dto::uint64> GetJobGenerations() const;
+
+  /**
+   * @brief Get the log, message and output value entries of the specified job that are more recent
+   * than the provided indices. Only a bounded number of recent entries is retained, so the first
+   * returned entries may have an index that is not consecutive to the provided ones. The default
+   * implementation retains no entries and returns none.
+   *
+   * @param job_idx Index that identifies a single job.
+   * @param last_indices Indices of the last entries the caller already received.
+   * @return Retained entries that are more recent than the provided indices.
+   */
+  virtual OutputEntries GetOutputEntries(sup::dto::uint32 job_idx,
+                                         const OutputEntryIndices& last_indices) const;
+
   /**
    * @brief (De)activate a breakpoint for the given instruction of the specified job.
    *
@@ -82,6 +146,21 @@ public:
   virtual void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
                               bool breakpoint_active) = 0;
 
+  /**
+   * @brief (De)activate breakpoints for a set of instructions of the specified job. Either all
+   * breakpoints are edited or, when one of the instruction indices is invalid, none of them. The
+   * default implementation checks the indices against GetNumberOfInstructions and then calls
+   * EditBreakpoint for each instruction.
+   *
+   * @param job_idx Index that identifies a single job.
+   * @param instr_indices Indices that identify instructions in the job.
+   * @param breakpoint_active True if breakpoints need to be set, false in the opposite case.
+   * @throws InvalidOperationException when one of the instruction indices is out of bounds.
+   */
+  virtual void EditBreakpoints(sup::dto::uint32 job_idx,
+                               const std::set<sup::dto::uint32>& instr_indices,
+                               bool breakpoint_active);
+
   /**
    * @brief Send a JobCommand to the specified job.
    *
@@ -89,6 +168,27 @@ public:
    * @param command JobCommand to send.
    */
   virtual void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) = 0;
+
+  /**
+   * @brief Send the same JobCommand to multiple jobs. The default implementation calls
+   * SendJobCommand for each job. When concurrent calls are supported (see
+   * SupportsConcurrentCalls), the jobs are split in contiguous ranges that are dispatched in
+   * parallel, one per hardware thread. Otherwise, the jobs are addressed one after the other.
+   *
+   * @param job_indices Indices of the jobs. An empty list addresses all jobs.
+   * @param command JobCommand to send.
+   * @return Success of sending the command to each addressed job, in the same order.
+   */
+  virtual std::vector<bool> SendJobCommands(const std::vector<sup::dto::uint32>& job_indices,
+                                            sup::oac_tree::JobCommand command);
+
+  /**
+   * @brief Indicate if the methods of this object can be called from different threads at the
+   * same time. The default implementation returns false.
+   *
+   * @return True when concurrent calls are supported.
+   */
+  virtual bool SupportsConcurrentCalls() const;
 };
 
 }  // namespace oac_tree_server
@@ -57,6 +57,12 @@ private:
                                                 sup::dto::AnyValue& output);
   sup::protocol::ProtocolResult GetJobInfo(const sup::dto::AnyValue& input,
                                            sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult GetAllJobInfos(const sup::dto::AnyValue& input,
+                                               sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult GetJobGenerations(const sup::dto::AnyValue& input,
+                                                  sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult GetOutputEntries(const sup::dto::AnyValue& input,
+                                                 sup::dto::AnyValue& output);
 };
 
 }  // namespace oac_tree_server
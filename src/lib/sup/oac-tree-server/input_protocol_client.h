@@ -26,15 +26,21 @@
 #include <sup/dto/anyvalue.h>
 #include <sup/protocol/protocol.h>
 #include <sup/oac-tree/user_input_reply.h>
+#include <sup/oac-tree/user_input_request.h>
+
+#include <map>
+#include <tuple>
 
 namespace sup
 {
 namespace oac_tree_server
 {
 using sup::oac_tree::UserInputReply;
+using sup::oac_tree::UserInputRequest;
 
 /**
- * @brief InputProtocolClient .
+ * @brief InputProtocolClient is the client side of InputProtocolServer: it retrieves pending
+ * requests for user input and sends replies to them.
  */
 class InputProtocolClient
 {
@@ -50,6 +56,22 @@ public:
 
   bool SetClientReply(sup::dto::uint64 id, const UserInputReply& reply);
 
+  /**
+   * @brief Retrieve the pending requests for user input. When the given update count is still
+   * current, the server waits for a change in the pending requests or until the timeout expires.
+   *
+   * @note While it waits, the call occupies a request handling thread of the server. Timeouts
+   * longer than kMaxPendingRequestsTimeoutMs are truncated by the server.
+   *
+   * @param update_count Update count returned by the previous call (use zero initially).
+   * @param timeout_ms Maximum time the server waits for a change, in milliseconds.
+   *
+   * @return Tuple of success state - current update count - map of pending request identifiers to
+   * their user input request.
+   */
+  std::tuple<bool, sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+  GetPendingRequests(sup::dto::uint64 update_count, sup::dto::uint32 timeout_ms);
+
 private:
   sup::protocol::Protocol& m_protocol;
 };
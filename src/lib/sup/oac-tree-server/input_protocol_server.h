@@ -34,9 +34,14 @@ namespace oac_tree_server
 {
 
 /**
- * @brief InputProtocolServer exposes the sup protocol for clients providing user input. It handles
- * only one input request at a time, so clients of this code should make sure only one request is
- * active at a time.
+ * @brief InputProtocolServer exposes the sup protocol for clients providing user input. Besides
+ * accepting replies, it allows clients to retrieve the pending input requests, waiting for changes
+ * to avoid polling, so that a client can handle all user input over a single connection.
+ *
+ * @note A GetPendingRequests call that waits for changes blocks the thread of the RPC server that
+ * handles it, for at most kMaxPendingRequestsTimeoutMs. Every client that waits this way occupies
+ * one request handling thread of the server. Replies from other clients may be delayed when all
+ * of those threads are taken.
  */
 class InputProtocolServer : public sup::protocol::Protocol
 {
@@ -59,6 +64,8 @@ private:
   InputRequestServer& m_request_server;
   sup::protocol::ProtocolResult SetClientReply(const sup::dto::AnyValue& input,
                                                sup::dto::AnyValue& output);
+  sup::protocol::ProtocolResult GetPendingRequests(const sup::dto::AnyValue& input,
+                                                   sup::dto::AnyValue& output);
 };
 
 }  // namespace oac_tree_server
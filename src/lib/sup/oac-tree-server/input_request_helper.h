@@ -27,7 +27,9 @@
 
 #include <sup/dto/anyvalue.h>
 
+#include <map>
 #include <tuple>
+#include <utility>
 
 namespace sup
 {
@@ -36,6 +38,16 @@ namespace oac_tree_server
 
 using sup::oac_tree::UserInputRequest;
 
+/**
+ * @brief Outcome of waiting for the reply to a user input request.
+ */
+enum class UserInputStatus
+{
+  kReplied = 0,
+  kInterrupted,
+  kTimedOut
+};
+
 /**
  * @brief Pack an UserInputRequest with the given request id into a base64 encoded AnyValue.
  *
@@ -56,6 +68,27 @@ sup::dto::AnyValue EncodeInputRequest(sup::dto::uint64 id, const UserInputReques
 std::tuple<bool, sup::dto::uint64, UserInputRequest> DecodeInputRequest(
   const sup::dto::AnyValue& encoded);
 
+/**
+ * @brief Pack a list of outstanding UserInputRequests, indexed by their request id, into a single
+ * AnyValue.
+ *
+ * @param input_requests Map of request ids to UserInputRequest objects.
+ *
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeInputRequestList(
+  const std::map<sup::dto::uint64, UserInputRequest>& input_requests);
+
+/**
+ * @brief Decode the packed AnyValue into a list of outstanding UserInputRequests.
+ *
+ * @param encoded Encoded AnyValue.
+ *
+ * @return Pair of success state - map of request ids to UserInputRequest objects.
+ */
+std::pair<bool, std::map<sup::dto::uint64, UserInputRequest>> DecodeInputRequestList(
+  const sup::dto::AnyValue& encoded);
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
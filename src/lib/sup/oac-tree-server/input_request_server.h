@@ -23,10 +23,16 @@
 #ifndef SUP_OAC_TREE_SERVER_INPUT_REQUEST_SERVER_H_
 #define SUP_OAC_TREE_SERVER_INPUT_REQUEST_SERVER_H_
 
+#include <sup/oac-tree-server/input_request_helper.h>
+
 #include <sup/oac-tree/user_input_reply.h>
+#include <sup/oac-tree/user_input_request.h>
 
+#include <chrono>
 #include <condition_variable>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <utility>
 
 namespace sup
@@ -35,15 +41,20 @@ namespace oac_tree_server
 {
 
 using sup::oac_tree::UserInputReply;
+using sup::oac_tree::UserInputRequest;
 
 /**
- * @brief InputRequestServer is a helper class that manages a single request for user input at
- * a time. It is intended to be used in a multithreaded context, e.g. the server is waiting for a
- * reply, while a client thread sets it.
+ * @brief InputRequestServer is a helper class that manages requests for user input. It is intended
+ * to be used in a multithreaded context, e.g. the server is waiting for a reply, while a client
+ * thread sets it.
+ *
+ * @details Each outstanding request has its own reply slot, identified by the request id. A request
+ * started with InitNewRequest() discards all other outstanding requests, while AddRequest() keeps
+ * them, so that multiple requests can wait for their reply concurrently.
  *
- * @note This class does not prevent users to instantiate new requests when an older one was still
- * not satisfied, i.e. replied to by a client. Users of this class are thus responsible for
- * handling such cases.
+ * Requests added together with their UserInputRequest are reported as pending until they are
+ * replied to or interrupted. Every change to the set of pending requests increments an update
+ * count, which clients can use to wait for changes without polling.
  */
 class InputRequestServer
 {
@@ -58,16 +69,24 @@ public:
   InputRequestServer& operator=(InputRequestServer&& other) = delete;
 
   /**
-   * @brief Clear the internal reply field. This also disables any SetClientReply() calls from being
-   * taken into account.
+   * @brief Start a new request and discard all other outstanding requests. Pending calls to
+   * WaitForReply() for discarded requests return as interrupted.
    *
    * @param id Identification of the user input request.
    */
    void InitNewRequest(sup::dto::uint64 id);
 
   /**
-   * @brief Set a client reply. If the index does not match the current index, this reply will be
-   * ignored.
+   * @brief Start a new request without discarding other outstanding requests.
+   *
+   * @param id Identification of the user input request.
+   * @param request The user input request itself, which is reported as pending.
+   */
+   void AddRequest(sup::dto::uint64 id, const UserInputRequest& request);
+
+  /**
+   * @brief Set a client reply. If the index does not match an outstanding request, this reply will
+   * be ignored.
    *
    * @param id Unique index that identifies a specific request for user input.
    * @param reply Reply from the client.
@@ -78,7 +97,8 @@ public:
   bool SetClientReply(sup::dto::uint64 id, const UserInputReply& reply);
 
   /**
-   * @brief Wait for a client to provide user input or timeout.
+   * @brief Wait for a client to provide user input or for interrupt. The request is no longer
+   * outstanding when this method returns.
    *
    * @param id Unique index that identifies a specific request for user input.
    *
@@ -87,13 +107,58 @@ public:
    */
   std::pair<bool, UserInputReply> WaitForReply(sup::dto::uint64 id);
 
+  /**
+   * @brief Wait for a client to provide user input, for interrupt or until the deadline passes.
+   * The request is no longer outstanding when this method returns.
+   *
+   * @param id Unique index that identifies a specific request for user input.
+   * @param deadline Point in time after which the request is abandoned.
+   *
+   * @return Pair of status - reply, which is only valid when the status indicates a reply.
+   */
+  std::pair<UserInputStatus, UserInputReply> WaitForReplyUntil(
+    sup::dto::uint64 id, std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Interrupt an outstanding request. Interrupting an unknown request is ignored.
+   *
+   * @param id Unique index that identifies a specific request for user input.
+   */
   void Interrupt(sup::dto::uint64 id);
 
+  /**
+   * @brief Get all requests that were added with AddRequest() and are still waiting for a reply.
+   *
+   * @return Map of request identifiers to their user input request.
+   */
+  std::map<sup::dto::uint64, UserInputRequest> GetPendingRequests() const;
+
+  /**
+   * @brief Wait until the set of pending requests differs from the one identified by the given
+   * update count or until the timeout expires.
+   *
+   * @param update_count Update count that was last seen by the caller.
+   * @param timeout Maximum time to wait for a change.
+   *
+   * @return Pair of current update count - map of pending request identifiers to their user input
+   * request.
+   */
+  std::pair<sup::dto::uint64, std::map<sup::dto::uint64, UserInputRequest>>
+  WaitForPendingRequests(sup::dto::uint64 update_count, std::chrono::milliseconds timeout);
+
 private:
-  sup::dto::uint64 m_request_id;
-  UserInputReply m_reply;
-  bool m_interrupt;
-  std::mutex m_mtx;
+  struct ReplySlot
+  {
+    UserInputRequest m_request;
+    UserInputReply m_reply;
+    bool m_interrupt;
+  };
+  std::pair<UserInputStatus, UserInputReply> WaitForReplyImpl(
+    sup::dto::uint64 id, const std::optional<std::chrono::steady_clock::time_point>& deadline);
+  std::map<sup::dto::uint64, UserInputRequest> GetPendingRequestsImpl() const;
+  std::map<sup::dto::uint64, ReplySlot> m_slots;
+  sup::dto::uint64 m_update_count;
+  mutable std::mutex m_mtx;
   std::condition_variable m_cv;
 };
 
@@ -24,12 +24,15 @@
 #define SUP_OAC_TREE_SERVER_SUP_OAC_TREE_PROTOCOL_H_
 
 #include <sup/dto/anyvalue.h>
+#include <sup/oac-tree/job_info.h>
 #include <sup/oac-tree/job_states.h>
 
 #include <sup/dto/basic_scalar_types.h>
 #include <sup/protocol/protocol_result.h>
 
+#include <set>
 #include <string>
+#include <vector>
 
 namespace sup
 {
@@ -50,6 +53,8 @@ const std::string kBreakpointInstructionId = "BP-INSTR";
 
 // Variable pv identifier
 const std::string kVariableId = "VAR-";
+// Variable keyframe pv identifier (only used when variable updates are delta encoded)
+const std::string kVariableKeyframeId = "VARKEY-";
 const std::string kVariableType = "sup::variableType/v1.0";
 // Variable fields:
 const std::string kVariableValueField = "var_value";
@@ -61,9 +66,13 @@ extern const sup::dto::AnyValue kVariableAnyValue;
 // Basic input request AnyValue
 extern const sup::dto::AnyValue kInputRequestAnyValue;
 
+// Basic list of outstanding input requests AnyValue
+extern const sup::dto::AnyValue kInputRequestListAnyValue;
+
 // User input server and request names:
 const std::string kInputServerName = "INPUT";
 const std::string kInputRequestName = "-REQ";
+const std::string kInputRequestListName = "-REQLIST";
 const std::string kInputRequestType = "sup::inputRequestType/v1.0";
 // Input request fields:
 const std::string kInputRequestIndexField = "idx";
@@ -108,6 +117,22 @@ const std::string kValueField = "value";
 // Basic output value entry AnyValue
 extern const sup::dto::AnyValue kOutputValueEntryAnyValue;
 
+// Entry batch type names and field:
+const std::string kLogEntryBatchType = "sup::logEntryBatchType/v1.0";
+const std::string kMessageEntryBatchType = "sup::messageEntryBatchType/v1.0";
+const std::string kEntryBatchField = "batch";
+
+// Output entry history type name and fields:
+const std::string kOutputEntriesType = "sup::outputEntriesType/v1.0";
+const std::string kLogEntriesField = "log_entries";
+const std::string kMessageEntriesField = "message_entries";
+const std::string kOutputValueEntriesField = "output_value_entries";
+// Output entry indices type name and fields:
+const std::string kOutputEntryIndicesType = "sup::outputEntryIndicesType/v1.0";
+const std::string kLogIndexField = "log_index";
+const std::string kMessageIndexField = "message_index";
+const std::string kOutputValueIndexField = "output_value_index";
+
 // Job state postfix:
 const std::string kJobStateId = "STATE";
 // Job state type name and fields:
@@ -117,37 +142,68 @@ const std::string kJobStateField = "state";
 // Basic job state AnyValue
 extern const sup::dto::AnyValue kJobStateAnyValue;
 
-// Automation servers will report the following type and version:
+// Automation servers will report the following type and version. The version is informational:
+// clients do not negotiate it, but detect which features a server supports. Functions a server
+// does not support return NotSupported, and the representation of channel values is detected per
+// value (see `DecodeChannelValue`).
 const std::string kAutomationInfoServerProtocolServerType = "SUP::AutomationInfoServerProtocol";
-const std::string kAutomationInfoServerProtocolServerVersion = "1.0";
+// Version 1.1: channels that can be represented natively may be published without base64 encoding
+// Version 1.2: adds retrieval of the output entry history of a job
+// Version 1.3: log and message entries may be published in batches
+// Version 1.4: adds retrieval of the information of multiple jobs in a single request
+// Version 1.5: adds retrieval of the generation numbers of the jobs
+const std::string kAutomationInfoServerProtocolServerVersion = "1.5";
 const std::string kAutomationControlServerProtocolServerType = "SUP::AutomationControlServerProtocol";
-const std::string kAutomationControlServerProtocolServerVersion = "1.0";
+// Version 1.1: adds editing of multiple breakpoints of a job in a single request
+// Version 1.2: adds sending a command to multiple jobs in a single request
+const std::string kAutomationControlServerProtocolServerVersion = "1.2";
 
 // Supported function names for automation servers:
 const std::string kGetServerPrefixFunctionName = "GetServerPrefix";
 const std::string kGetNumberOfJobsFunctionName = "GetNumberOfJobs";
 const std::string kGetJobInfoFunctionName = "GetJobInfo";
+const std::string kGetOutputEntriesFunctionName = "GetOutputEntries";
+const std::string kGetAllJobInfosFunctionName = "GetAllJobInfos";
+const std::string kGetJobGenerationsFunctionName = "GetJobGenerations";
 const std::string kEditBreakpointCommandFunctionName = "EditBreakpoint";
+const std::string kEditBreakpointsCommandFunctionName = "EditBreakpoints";
 const std::string kSendJobCommandFunctionName = "SendJobCommand";
+const std::string kSendJobCommandsFunctionName = "SendJobCommands";
 
 // Field names used for the supported functions of automation servers:
 const std::string kServerPrefixFieldName = "server_prefix";
 const std::string kNumberOfJobsFieldName = "number_of_jobs";
 const std::string kJobIndexFieldName = "job_index";
 const std::string kJobInfoFieldName = "job_info";
+const std::string kJobIndicesFieldName = "job_indices";
+const std::string kJobInfosFieldName = "job_infos";
+const std::string kJobGenerationsFieldName = "job_generations";
 const std::string kInstructionIndexFieldName = "instruction_index";
+const std::string kInstructionIndicesFieldName = "instruction_indices";
 const std::string kBreakpointActiveFieldName = "breakpoint_active";
 const std::string kJobCommandFieldName = "command";
+const std::string kJobCommandResultsFieldName = "command_results";
+const std::string kOutputEntryIndicesFieldName = "output_entry_indices";
+const std::string kOutputEntriesFieldName = "output_entries";
 
 // Input request servers will report the following type and version:
 const std::string kAutomationInputRequestServerType = "SUP::AutoInputServerProtocol";
-const std::string kAutomationInputRequestServerVersion = "1.0";
+const std::string kAutomationInputRequestServerVersion = "1.1";
 
 // Supported function names for input request servers:
 const std::string KSetReplyFunctionName = "SetReply";
+const std::string kGetPendingRequestsFunctionName = "GetPendingRequests";
 
 // Field names used for the supported functions of input request servers:
 const std::string kUserReplyValueFieldName = "value";
+const std::string kUpdateCountFieldName = "update_count";
+const std::string kTimeoutFieldName = "timeout";
+const std::string kPendingRequestsFieldName = "requests";
+
+// Maximum time in milliseconds that an input request server waits for changes in the pending
+// requests before answering a client (longer timeouts requested by clients are truncated). This
+// also bounds how long a single waiting client occupies a request handling thread of the server:
+const sup::dto::uint32 kMaxPendingRequestsTimeoutMs = 1000;
 
 enum class ValueNameType : dto::uint32
 {
@@ -158,7 +214,8 @@ enum class ValueNameType : dto::uint32
   kMessageEntry,
   kOutputValueEntry,
   kJobStatus,
-  kBreakpointInstruction
+  kBreakpointInstruction,
+  kVariableKeyframe
 };
 
 struct ValueNameInfo
@@ -244,6 +301,16 @@ std::string GetBreakpointInstructionPVName(const std::string& prefix);
  */
 std::string GetVariablePVName(const std::string& prefix, sup::dto::uint32 index);
 
+/**
+ * @brief Create a PV channel name for the keyframes of a variable, given the PV channel name of
+ * that variable.
+ *
+ * @param var_pv_name PV channel name of the variable (see GetVariablePVName).
+ * @return PV channel name for the variable's keyframes or an empty string if the given name is not
+ * a variable PV channel name.
+ */
+std::string GetVariableKeyframePVName(const std::string& var_pv_name);
+
 /**
  * @brief Create a name for the server that handles user input for a job.
  *
@@ -260,6 +327,14 @@ std::string GetInputServerName(const std::string& prefix);
  */
 std::string GetInputRequestPVName(const std::string& server_name);
 
+/**
+ * @brief Create a PV name for publishing the list of all outstanding input requests.
+ *
+ * @param server_name Name of the server associated with the input requests.
+ * @return PV name for publishing the list of outstanding input requests.
+ */
+std::string GetInputRequestListPVName(const std::string& server_name);
+
 /**
  * @brief Create a PV channel name for the log entries.
  *
@@ -357,6 +432,93 @@ ValueNameInfo ParseValueName(const std::string& val_name);
 sup::protocol::ProtocolResult ExtractJobIndex(
   const sup::dto::AnyValue& input, sup::dto::uint32 n_jobs, sup::dto::uint32& idx);
 
+/**
+ * @brief Encode a list of job indices, e.g. to pack them as input for an RPC server protocol.
+ *
+ * @param job_indices List of job indices.
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeJobIndices(const std::vector<sup::dto::uint32>& job_indices);
+
+/**
+ * @brief Decode a list of job indices, e.g. as returned by an RPC server protocol. See also
+ * `EncodeJobIndices`.
+ *
+ * @param anyvalue AnyValue to decode.
+ * @return Boolean indicating success of the decoding operation and the decoded job indices
+ * (if success).
+ */
+std::pair<bool, std::vector<sup::dto::uint32>> DecodeJobIndices(
+  const sup::dto::AnyValue& anyvalue);
+
+/**
+ * @brief Extract a list of job indices from the given input AnyValue. This is used in RPC server
+ * protocols. When the input does not contain a list of job indices, an empty list is returned,
+ * which requests all jobs.
+ *
+ * @param input AnyValue passed as input to a protocol server.
+ * @param n_jobs Total number of jobs (to provide bounds for the answer).
+ * @param job_indices Output parameter that will hold the parsed job indices.
+ * @return ProtocolResult indicating success or failure conditions.
+ */
+sup::protocol::ProtocolResult ExtractJobIndices(
+  const sup::dto::AnyValue& input, sup::dto::uint32 n_jobs,
+  std::vector<sup::dto::uint32>& job_indices);
+
+/**
+ * @brief Encode a list of JobInfo objects into a single AnyValue.
+ *
+ * @param job_infos List of JobInfo objects.
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeJobInfos(const std::vector<sup::oac_tree::JobInfo>& job_infos);
+
+/**
+ * @brief Decode a list of JobInfo objects. See also `EncodeJobInfos`.
+ *
+ * @param anyvalue AnyValue to decode.
+ * @return Boolean indicating success of the decoding operation and the decoded JobInfo objects
+ * (if success).
+ */
+std::pair<bool, std::vector<sup::oac_tree::JobInfo>> DecodeJobInfos(
+  const sup::dto::AnyValue& anyvalue);
+
+/**
+ * @brief Encode the generation numbers of jobs into a single AnyValue.
+ *
+ * @param generations Generation number of each job.
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeJobGenerations(const std::vector<sup::dto::uint64>& generations);
+
+/**
+ * @brief Decode the generation numbers of jobs. See also `EncodeJobGenerations`.
+ *
+ * @param anyvalue AnyValue to decode.
+ * @return Boolean indicating success of the decoding operation and the decoded generation
+ * numbers (if success).
+ */
+std::pair<bool, std::vector<sup::dto::uint64>> DecodeJobGenerations(
+  const sup::dto::AnyValue& anyvalue);
+
+/**
+ * @brief Encode the results of sending a command to multiple jobs into a single AnyValue.
+ *
+ * @param results Success of sending the command to each job.
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeJobCommandResults(const std::vector<bool>& results);
+
+/**
+ * @brief Decode the results of sending a command to multiple jobs. See also
+ * `EncodeJobCommandResults`.
+ *
+ * @param anyvalue AnyValue to decode.
+ * @return Boolean indicating success of the decoding operation and the decoded results (if
+ * success).
+ */
+std::pair<bool, std::vector<bool>> DecodeJobCommandResults(const sup::dto::AnyValue& anyvalue);
+
 /**
  * @brief Extract the instruction index from the given input AnyValue. This is used in RPC server
  * protocols.
@@ -369,6 +531,28 @@ sup::protocol::ProtocolResult ExtractJobIndex(
 sup::protocol::ProtocolResult ExtractInstructionIndex(
   const sup::dto::AnyValue& input, sup::dto::uint32 n_instr, sup::dto::uint32& idx);
 
+/**
+ * @brief Encode a set of instruction indices, e.g. to pack them as input for an RPC server
+ * protocol.
+ *
+ * @param instr_indices Set of instruction indices.
+ * @return Encoded AnyValue.
+ */
+sup::dto::AnyValue EncodeInstructionIndices(const std::set<sup::dto::uint32>& instr_indices);
+
+/**
+ * @brief Extract a set of instruction indices from the given input AnyValue. This is used in RPC
+ * server protocols.
+ *
+ * @param input AnyValue passed as input to a protocol server.
+ * @param n_instr Total number of instructions (to provide bounds for the answer).
+ * @param instr_indices Output parameter that will hold the parsed instruction indices.
+ * @return ProtocolResult indicating success or failure conditions.
+ */
+sup::protocol::ProtocolResult ExtractInstructionIndices(
+  const sup::dto::AnyValue& input, sup::dto::uint32 n_instr,
+  std::set<sup::dto::uint32>& instr_indices);
+
 /**
  * @brief This encoding can be used for all server AnyValues to enforce them to have the same type.
  * The encoded AnyValue will be a struct with two string members (one for the encoding name and
@@ -388,6 +572,28 @@ sup::dto::AnyValue Base64EncodeAnyValue(const sup::dto::AnyValue& value);
  */
 std::pair<bool, sup::dto::AnyValue> Base64DecodeAnyValue(const sup::dto::AnyValue& value);
 
+/**
+ * @brief Check if an AnyValue can be published natively, i.e. without base64 encoding. This
+ * requires a structure without empty leaf values, as these cannot be represented over PvAccess.
+ *
+ * @param value AnyValue to check.
+ * @return true when the AnyValue can be published natively.
+ */
+bool IsNativeChannelValue(const sup::dto::AnyValue& value);
+
+/**
+ * @brief Decode an AnyValue received from a server channel, which can be base64 encoded or
+ * published natively (see `IsNativeChannelValue`). Servers reporting protocol version 1.1 or
+ * higher may publish channels natively. The representation is detected from the type of the value
+ * and not from the version reported by the server. Clients that do not use this function, i.e.
+ * clients before version 1.1, cannot decode natively published channels.
+ *
+ * @param value AnyValue to decode.
+ * @return Boolean indicating success of the decoding operation and the decoded AnyValue
+ * (if success).
+ */
+std::pair<bool, sup::dto::AnyValue> DecodeChannelValue(const sup::dto::AnyValue& value);
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_BATCHER_H_
+#define SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_BATCHER_H_
+
+#include <sup/oac-tree-server/output_entry_types.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief OutputEntryBatcher accumulates log and message entries and publishes them in batches
+ * from a dedicated thread.
+ *
+ * @details A batch is published when the flush interval expires after the first entry of the batch
+ * was added, or earlier when the number of pending entries of one kind reaches the maximum batch
+ * size. Since all batches are published from the same thread, the order of entries of the same
+ * kind is preserved. Pending entries are published on destruction.
+ */
+class OutputEntryBatcher
+{
+public:
+  using LogBatchFunction = std::function<void(const std::vector<LogEntry>&)>;
+  using MessageBatchFunction = std::function<void(const std::vector<MessageEntry>&)>;
+
+  OutputEntryBatcher(std::chrono::milliseconds flush_interval, std::size_t max_batch_size,
+                     const LogBatchFunction& log_batch_func,
+                     const MessageBatchFunction& msg_batch_func);
+  OutputEntryBatcher(const OutputEntryBatcher&) = delete;
+  OutputEntryBatcher(OutputEntryBatcher&&) = delete;
+  OutputEntryBatcher& operator=(const OutputEntryBatcher&) = delete;
+  OutputEntryBatcher& operator=(OutputEntryBatcher&&) = delete;
+  ~OutputEntryBatcher();
+
+  void AddLogEntry(const LogEntry& log_entry);
+
+  void AddMessageEntry(const MessageEntry& msg_entry);
+
+private:
+  void FlushLoop();
+  bool BatchFull() const;
+  const std::chrono::milliseconds m_flush_interval;
+  const std::size_t m_max_batch_size;
+  LogBatchFunction m_log_batch_func;
+  MessageBatchFunction m_msg_batch_func;
+  std::vector<LogEntry> m_log_entries;
+  std::vector<MessageEntry> m_msg_entries;
+  bool m_exit;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  std::future<void> m_flush_future;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_BATCHER_H_
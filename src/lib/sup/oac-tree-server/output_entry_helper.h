@@ -50,6 +50,28 @@ sup::dto::AnyValue EncodeOutputValueEntry(const OutputValueEntry& output_entry);
 
 std::pair<bool, OutputValueEntry> DecodeOutputValueEntry(const sup::dto::AnyValue& anyvalue);
 
+sup::dto::AnyValue EncodeLogEntryBatch(const std::vector<LogEntry>& log_entries);
+
+std::pair<bool, std::vector<LogEntry>> DecodeLogEntryBatch(const sup::dto::AnyValue& anyvalue);
+
+sup::dto::AnyValue EncodeMessageEntryBatch(const std::vector<MessageEntry>& msg_entries);
+
+std::pair<bool, std::vector<MessageEntry>> DecodeMessageEntryBatch(
+  const sup::dto::AnyValue& anyvalue);
+
+/**
+ * @brief Check if the AnyValue represents a batch of entries, as opposed to a single entry.
+ */
+bool IsEntryBatch(const sup::dto::AnyValue& anyvalue);
+
+sup::dto::AnyValue EncodeOutputEntries(const OutputEntries& output_entries);
+
+std::pair<bool, OutputEntries> DecodeOutputEntries(const sup::dto::AnyValue& anyvalue);
+
+sup::dto::AnyValue EncodeOutputEntryIndices(const OutputEntryIndices& indices);
+
+std::pair<bool, OutputEntryIndices> DecodeOutputEntryIndices(const sup::dto::AnyValue& anyvalue);
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_HISTORY_H_
+#define SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_HISTORY_H_
+
+#include <sup/oac-tree-server/output_entry_types.h>
+
+#include <deque>
+#include <mutex>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Threadsafe bounded history of the log, message and output value entries of a single job.
+ *
+ * @details For each kind of entry, at most 'capacity' entries are retained: adding an entry to a
+ * full history discards the oldest entry of that kind. This allows clients that missed entries,
+ * e.g. because they could not keep up with the published updates, to retrieve them afterwards.
+ */
+class OutputEntryHistory
+{
+public:
+  explicit OutputEntryHistory(sup::dto::uint32 capacity);
+  ~OutputEntryHistory();
+
+  void AddLogEntry(const LogEntry& log_entry);
+
+  void AddMessageEntry(const MessageEntry& msg_entry);
+
+  void AddOutputValueEntry(const OutputValueEntry& output_entry);
+
+  /**
+   * @brief Get all retained entries with an index larger than the corresponding index in the
+   * provided structure. Entries of each kind are sorted by their index.
+   *
+   * @param last_indices Indices of the last entries the caller already received.
+   * @return Retained entries that are more recent than the provided indices.
+   */
+  OutputEntries GetEntriesAfter(const OutputEntryIndices& last_indices) const;
+
+private:
+  const sup::dto::uint32 m_capacity;
+  std::deque<LogEntry> m_log_entries;
+  std::deque<MessageEntry> m_message_entries;
+  std::deque<OutputValueEntry> m_output_value_entries;
+  mutable std::mutex m_mtx;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_OUTPUT_ENTRY_HISTORY_H_
@@ -26,6 +26,7 @@
 #include <sup/dto/anyvalue.h>
 
 #include <string>
+#include <vector>
 
 namespace sup
 {
@@ -61,6 +62,34 @@ struct OutputValueEntry
 bool operator==(const OutputValueEntry& left, const OutputValueEntry& right);
 bool operator!=(const OutputValueEntry& left, const OutputValueEntry& right);
 
+/**
+ * @brief Collection of log, message and output value entries of a single job, each sorted by
+ * their index.
+ */
+struct OutputEntries
+{
+  std::vector<LogEntry> m_log_entries;
+  std::vector<MessageEntry> m_message_entries;
+  std::vector<OutputValueEntry> m_output_value_entries;
+};
+
+bool operator==(const OutputEntries& left, const OutputEntries& right);
+bool operator!=(const OutputEntries& left, const OutputEntries& right);
+
+/**
+ * @brief Indices of the last log, message and output value entries that were received. Since valid
+ * entry indices are never zero, zero indicates that no entries were received yet.
+ */
+struct OutputEntryIndices
+{
+  sup::dto::uint64 m_log_idx;
+  sup::dto::uint64 m_message_idx;
+  sup::dto::uint64 m_output_value_idx;
+};
+
+bool operator==(const OutputEntryIndices& left, const OutputEntryIndices& right);
+bool operator!=(const OutputEntryIndices& left, const OutputEntryIndices& right);
+
 }  // namespace oac_tree_server
 
 }  // namespace sup
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_REPLY_EXECUTOR_H_
+#define SUP_OAC_TREE_SERVER_REPLY_EXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief Default number of threads of the shared ReplyExecutor.
+ */
+const std::size_t kDefaultReplyExecutorThreads = 4;
+
+/**
+ * @brief ReplyExecutor runs posted tasks on a fixed number of worker threads. It allows many
+ * ClientReplyDelegator objects to deliver replies concurrently without each owning a thread.
+ * AsyncJobManager uses its own ReplyExecutor to run the requests it wraps.
+ *
+ * @details Tasks are started in the order they were posted, but tasks may run concurrently when
+ * there is more than one thread. Tasks that are still queued on destruction are run before the
+ * threads are joined.
+ */
+class ReplyExecutor
+{
+public:
+  using Task = std::function<void()>;
+
+  explicit ReplyExecutor(std::size_t n_threads);
+  ~ReplyExecutor();
+
+  // No copy or move
+  ReplyExecutor(const ReplyExecutor& other) = delete;
+  ReplyExecutor(ReplyExecutor&& other) = delete;
+  ReplyExecutor& operator=(const ReplyExecutor& other) = delete;
+  ReplyExecutor& operator=(ReplyExecutor&& other) = delete;
+
+  /**
+   * @brief Queue a task to be run on one of the worker threads.
+   *
+   * @param task Task to run.
+   */
+  void Post(const Task& task);
+
+  /**
+   * @brief Get the number of worker threads.
+   */
+  std::size_t GetNumberOfThreads() const;
+
+private:
+  void WorkerLoop();
+  std::deque<Task> m_tasks;
+  bool m_halt;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  std::vector<std::thread> m_workers;
+};
+
+/**
+ * @brief Get the ReplyExecutor that is shared by all ClientReplyDelegator objects that were not
+ * given their own executor. It uses kDefaultReplyExecutorThreads threads.
+ */
+ReplyExecutor& GetSharedReplyExecutor();
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_REPLY_EXECUTOR_H_
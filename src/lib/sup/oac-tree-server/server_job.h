@@ -0,0 +1,195 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_SERVER_JOB_H_
+#define SUP_OAC_TREE_SERVER_SERVER_JOB_H_
+
+#include <sup/oac-tree-server/i_anyvalue_manager.h>
+#include <sup/oac-tree-server/output_entry_types.h>
+#include <sup/oac-tree-server/server_job_info_io.h>
+
+#include <sup/oac-tree/job_commands.h>
+#include <sup/oac-tree/job_info.h>
+#include <sup/oac-tree/procedure.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+/**
+ * @brief Function that creates a new procedure for a job, e.g. by parsing its file again. This
+ * allows a job to be instantiated again after it was torn down.
+ */
+using ProcedureFactory = std::function<std::unique_ptr<sup::oac_tree::Procedure>()>;
+
+/**
+ * @brief Configuration of how an AutomationServer manages the lifecycle of its jobs.
+ */
+struct ServerJobConfig
+{
+  /**
+   * @brief When true, the published values, input handler and LocalJob of a job are only
+   * instantiated when the job is first used, i.e. when its information is requested or a command
+   * is sent to it.
+   */
+  bool m_lazy_instantiation = false;
+
+  /**
+   * @brief When non-zero and jobs are instantiated lazily, jobs that were not used for at least
+   * the given number of milliseconds and that are not running are torn down again. This only
+   * applies to jobs that were added with a procedure factory. Zero keeps jobs alive.
+   */
+  sup::dto::uint32 m_idle_timeout_ms = 0;
+};
+
+/**
+ * @brief ServerJob manages the lifecycle of a single job on the server side: the ServerJobInfoIO
+ * that publishes its state and the LocalJob that runs its procedure. These can be instantiated
+ * lazily on first use and, when a procedure factory is available, torn down again when idle.
+ *
+ * @note Each (re)instantiation from the procedure factory assigns a new generation to the job,
+ * since the recreated procedure is not guaranteed to be identical. Breakpoints are kept and set
+ * again when the job is instantiated again, as far as their instructions still exist.
+ *
+ * @note Once the job is instantiated, requests only load its atomically published instance and
+ * do not take the job's mutex, so concurrent requests do not serialize against each other or
+ * against instantiation. Loading uses the atomic shared_ptr functions, which are not lock-free in
+ * common standard library implementations: libstdc++ briefly holds one of a small global pool of
+ * mutexes while copying the pointer.
+ */
+class ServerJob
+{
+public:
+  ServerJob(const std::string& job_prefix, IAnyValueManager& av_manager,
+            const ServerJobInfoIOConfig& job_info_io_config,
+            std::unique_ptr<sup::oac_tree::Procedure> proc, const ProcedureFactory& factory,
+            bool lazy, std::atomic<sup::dto::uint64>& next_generation);
+  ~ServerJob();
+
+  ServerJob(const ServerJob& other) = delete;
+  ServerJob(ServerJob&& other) = delete;
+  ServerJob& operator=(const ServerJob& other) = delete;
+  ServerJob& operator=(ServerJob&& other) = delete;
+
+  bool IsInstantiated() const;
+
+  /**
+   * @brief Instantiate the job if it was not instantiated yet: prepare it (see Prepare()) and
+   * publish its values. When publishing fails, the values that were already published are
+   * released again and the prepared job is kept, so publishing is retried on next use.
+   *
+   * @throws InvalidOperationException when the job was torn down, could not be prepared or its
+   * values could not be published.
+   */
+  void Instantiate();
+
+  /**
+   * @brief Create the LocalJob of the job and set up its procedure, without publishing anything.
+   * This allows checking that a job can be set up while another job still publishes the same
+   * values. Does nothing when the job was already prepared or instantiated.
+   *
+   * @throws InvalidOperationException when the job was torn down or no procedure is available.
+   * Exceptions from setting up the procedure are passed on. The procedure is lost in that case,
+   * so preparing again needs the procedure factory.
+   */
+  void Prepare();
+
+  sup::dto::uint64 GetGeneration() const;
+
+  sup::oac_tree::JobInfo GetInfo();
+
+  sup::dto::uint32 GetNumberOfInstructions();
+
+  /**
+   * @brief Get the retained output entries of the job. This does not instantiate the job and
+   * returns no entries when it is not instantiated.
+   */
+  OutputEntries GetOutputEntries(const OutputEntryIndices& last_indices) const;
+
+  void EditBreakpoints(const std::set<sup::dto::uint32>& instr_indices, bool breakpoint_active);
+
+  void SendJobCommand(sup::oac_tree::JobCommand command);
+
+  /**
+   * @brief Tear down the instantiated job if it was not used for at least the given timeout, is
+   * not running and can be recreated from its procedure factory.
+   *
+   * @param idle_timeout Minimum duration since the last use of the job.
+   * @return true when the job was torn down.
+   */
+  bool TearDownIfIdle(std::chrono::steady_clock::duration idle_timeout);
+
+  /**
+   * @brief Halt and destroy the job and release its published values, e.g. when it is removed from
+   * the server. This waits for requests that are still using the job. Afterwards, the job can no
+   * longer be used.
+   *
+   * @return false when not all published values could be released. Their names then cannot be
+   * published again by another job.
+   */
+  bool TearDown();
+
+private:
+  struct Instance;
+  std::shared_ptr<Instance> LoadInstance() const;
+  std::shared_ptr<Instance> Acquire();
+  std::shared_ptr<Instance> InstantiateImpl();
+  std::shared_ptr<Instance> PrepareImpl();
+  bool ReleaseInstance(Instance& instance) const;
+  const std::string m_job_prefix;
+  IAnyValueManager& m_av_manager;
+  const ServerJobInfoIOConfig m_job_info_io_config;
+  std::unique_ptr<sup::oac_tree::Procedure> m_proc;
+  const ProcedureFactory m_factory;
+  std::atomic<sup::dto::uint64>& m_next_generation;
+  std::atomic<sup::dto::uint64> m_generation;
+  // Published atomically, so requests can use an instantiated job without taking m_mtx:
+  std::shared_ptr<Instance> m_instance;
+  // The published instance does not own the instance. Its owner is handed back here once the
+  // last request released the published instance:
+  std::future<std::shared_ptr<Instance>> m_unpublished_instance;
+  // Instance that was set up, but whose values were not published yet:
+  std::shared_ptr<Instance> m_prepared;
+  std::atomic<std::chrono::steady_clock::rep> m_last_used;
+  bool m_torn_down;
+  // Serializes instantiation and teardown:
+  mutable std::mutex m_mtx;
+  // Serializes breakpoint edits, so bulk edits are applied as a whole:
+  std::mutex m_breakpoint_mtx;
+  // Breakpoints to set again when the job is instantiated again:
+  std::set<sup::dto::uint32> m_breakpoints;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_SERVER_JOB_H_
@@ -25,13 +25,65 @@
 
 #include <sup/oac-tree-server/i_anyvalue_manager.h>
 #include <sup/oac-tree-server/index_generator.h>
+#include <sup/oac-tree-server/output_entry_batcher.h>
+#include <sup/oac-tree-server/output_entry_history.h>
+#include <sup/oac-tree-server/variable_delta_codec.h>
 
 #include <sup/oac-tree/i_job_info_io.h>
+#include <sup/oac-tree/job_states.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace sup
 {
 namespace oac_tree_server
 {
+/**
+ * @brief Configuration of how a ServerJobInfoIO publishes job information.
+ */
+struct ServerJobInfoIOConfig
+{
+  /**
+   * @brief When non-zero, variable updates are published as deltas that only contain the changed
+   * leaf values, with a full keyframe every given number of updates. Keyframes are also published
+   * on a separate keyframe channel per variable (see GetVariableKeyframePVName), so clients can
+   * always decode the latest delta. Zero publishes every update in full.
+   */
+  sup::dto::uint32 m_variable_keyframe_interval = 0;
+
+  /**
+   * @brief Maximum number of log, message and output value entries (each) that are retained, so
+   * clients can retrieve entries they missed. Zero disables this history.
+   */
+  sup::dto::uint32 m_output_entry_history_size = 1024;
+
+  /**
+   * @brief When non-zero, log and message entries are published in batches at most every given
+   * number of milliseconds, instead of one update per entry. Zero publishes every entry
+   * immediately.
+   */
+  sup::dto::uint32 m_entry_batch_interval_ms = 0;
+
+  /**
+   * @brief When batching entries, a batch is published as soon as it contains this number of
+   * entries, without waiting for the batch interval to expire.
+   */
+  sup::dto::uint32 m_entry_batch_size = 256;
+
+  /**
+   * @brief When non-zero, requests for user input are abandoned when no reply was received within
+   * the given number of milliseconds. The request then fails and a warning is logged. Zero waits
+   * until a reply is received or the request is interrupted.
+   */
+  sup::dto::uint32 m_user_input_timeout_ms = 0;
+};
+
 /**
  * @brief Implementation of IJobInfoIO that delegates its calls to an IAnyValueManager
  * implementation. This implementation will be used at the server side.
@@ -39,10 +91,40 @@ namespace oac_tree_server
 class ServerJobInfoIO : public sup::oac_tree::IJobInfoIO
 {
 public:
+  /**
+   * @brief Construct and publish the values and input handler of the job.
+   *
+   * @throws InvalidOperationException when the values or input handler could not be published,
+   * e.g. because their names are already in use. Values that were already published are removed
+   * again in that case.
+   */
   ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
                   IAnyValueManager& av_manager);
+  ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
+                  IAnyValueManager& av_manager, const ServerJobInfoIOConfig& config);
+
+  /**
+   * @brief Construct without publishing when publish is false. Until PublishAnyValues() is called,
+   * nothing is sent to the IAnyValueManager: the job state, number of instructions and last value
+   * of each variable are only recorded, and log, message and output value entries are only
+   * retained. This allows a job to be set up while another job still publishes the same names.
+   *
+   * @throws InvalidOperationException when publish is true and publishing fails.
+   */
+  ServerJobInfoIO(const std::string& job_prefix, sup::dto::uint32 n_vars,
+                  IAnyValueManager& av_manager, const ServerJobInfoIOConfig& config,
+                  bool publish);
   virtual ~ServerJobInfoIO();
 
+  /**
+   * @brief Publish the values and input handler of the job, followed by the recorded job state
+   * and variable values. Does nothing when they are already published.
+   *
+   * @throws InvalidOperationException when the values or input handler could not be published.
+   * Values that were already published are removed again in that case, so this can be retried.
+   */
+  void PublishAnyValues();
+
   void InitNumberOfInstructions(sup::dto::uint32 n_instr) override;
 
   void InstructionStateUpdated(sup::dto::uint32 instr_idx,
@@ -71,13 +153,53 @@ public:
 
   void ProcedureTicked() override;
 
+  /**
+   * @brief Get the retained log, message and output value entries that are more recent than the
+   * provided indices.
+   *
+   * @param last_indices Indices of the last entries the caller already received.
+   * @return Retained entries that are more recent than the provided indices.
+   */
+  OutputEntries GetOutputEntries(const OutputEntryIndices& last_indices) const;
+
+  /**
+   * @brief Get the last job state that was published.
+   */
+  sup::oac_tree::JobState GetJobState() const;
+
+  /**
+   * @brief Stop publishing all values of this job and remove its input handler. This is used when
+   * the job is torn down while the server keeps running. The job itself needs to be destroyed
+   * before calling this method. Nothing is removed when the values were never published.
+   *
+   * @return true when the IAnyValueManager supported removing all values.
+   */
+  bool ReleaseAnyValues();
+
 private:
+  bool PublishInitialValues();
+
+  void PublishVariable(sup::dto::uint32 var_idx, const sup::dto::AnyValue& value, bool connected);
+
+  UserInputReply GetUserInput(sup::dto::uint64 id, const UserInputRequest& request);
+
   const std::string m_job_prefix;
   const sup::dto::uint32 m_n_vars;
+  std::atomic<sup::dto::uint32> m_n_instr;
+  std::atomic<sup::oac_tree::JobState> m_job_state;
   IAnyValueManager& m_av_manager;
   IndexGenerator m_log_idx_gen;
   IndexGenerator m_msg_idx_gen;
   IndexGenerator m_out_val_idx_gen;
+  OutputEntryHistory m_output_entry_history;
+  std::vector<VariableDeltaEncoder> m_delta_encoders;
+  std::mutex m_delta_mtx;
+  std::unique_ptr<OutputEntryBatcher> m_entry_batcher;
+  const std::chrono::milliseconds m_user_input_timeout;
+  // Serializes publishing with the updates that are recorded until then:
+  std::atomic<bool> m_published;
+  std::mutex m_publish_mtx;
+  std::map<sup::dto::uint32, std::pair<sup::dto::AnyValue, bool>> m_unpublished_variables;
 };
 
 }  // namespace oac_tree_server
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_SERVER_JOB_TABLE_H_
+#define SUP_OAC_TREE_SERVER_SERVER_JOB_TABLE_H_
+
+#include <sup/oac-tree-server/server_job.h>
+
+#include <sup/dto/basic_scalar_types.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+/**
+ * @brief Table of server jobs, indexed by job index. Jobs are stored in fixed size chunks that
+ * are never relocated, and both chunks and jobs are published atomically. This allows readers to
+ * look up jobs without taking the writers' mutex or a server-wide mutex, while jobs are added,
+ * replaced or removed concurrently.
+ *
+ * @note Writers are serialized internally.
+ *
+ * @note The chunk pointers and the size are lock-free atomics, but the job slots are accessed with
+ * the atomic shared_ptr functions. Common standard library implementations, e.g. libstdc++, guard
+ * those with a small global pool of mutexes selected by address. Lookups are therefore not
+ * lock-free: they briefly hold such a mutex while copying a slot, and may contend with accesses to
+ * other atomic shared_ptr objects that map to the same mutex.
+ */
+class ServerJobTable
+{
+public:
+  static constexpr sup::dto::uint32 kChunkSize = 256;
+  static constexpr sup::dto::uint32 kMaxChunks = 4096;
+
+  ServerJobTable();
+  ~ServerJobTable();
+
+  ServerJobTable(const ServerJobTable& other) = delete;
+  ServerJobTable(ServerJobTable&& other) = delete;
+  ServerJobTable& operator=(const ServerJobTable& other) = delete;
+  ServerJobTable& operator=(ServerJobTable&& other) = delete;
+
+  /**
+   * @brief Get the number of indices in use, including those of removed jobs.
+   */
+  sup::dto::uint32 GetSize() const;
+
+  /**
+   * @brief Get the job with the given index.
+   *
+   * @return Job with the given index or an empty pointer if the index is out of bounds or the job
+   * was removed.
+   */
+  std::shared_ptr<ServerJob> Get(sup::dto::uint32 idx) const;
+
+  /**
+   * @brief Get all jobs in the order of their indices. Removed jobs are represented by empty
+   * pointers.
+   */
+  std::vector<std::shared_ptr<ServerJob>> GetAll() const;
+
+  /**
+   * @brief Append a job to the table.
+   *
+   * @param job Job to append.
+   * @return Index of the appended job.
+   * @throws InvalidOperationException when the table is full.
+   */
+  sup::dto::uint32 Append(std::shared_ptr<ServerJob> job);
+
+  /**
+   * @brief Replace the job with the given index. Passing an empty pointer removes the job.
+   *
+   * @param idx Index of the job to replace.
+   * @param job New job.
+   * @return Job that was replaced.
+   * @throws InvalidOperationException when the index is out of bounds.
+   */
+  std::shared_ptr<ServerJob> Exchange(sup::dto::uint32 idx, std::shared_ptr<ServerJob> job);
+
+private:
+  using Chunk = std::array<std::shared_ptr<ServerJob>, kChunkSize>;
+  std::shared_ptr<ServerJob>* GetSlot(sup::dto::uint32 idx) const;
+  std::array<std::atomic<Chunk*>, kMaxChunks> m_chunks;
+  std::atomic<sup::dto::uint32> m_size;
+  std::mutex m_write_mtx;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_SERVER_JOB_TABLE_H_
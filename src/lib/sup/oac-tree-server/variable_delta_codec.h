@@ -0,0 +1,111 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_VARIABLE_DELTA_CODEC_H_
+#define SUP_OAC_TREE_SERVER_VARIABLE_DELTA_CODEC_H_
+
+#include <sup/oac-tree-server/variable_delta_helper.h>
+
+#include <sup/dto/anyvalue.h>
+#include <sup/dto/basic_scalar_types.h>
+
+#include <utility>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+/**
+ * @brief VariableDeltaEncoder encodes the successive states of a single variable as keyframes or
+ * deltas. A keyframe contains the full value, while a delta only contains the leaf values that
+ * differ from the last keyframe.
+ *
+ * @details Since deltas are relative to the last keyframe instead of the previous update, a client
+ * can decode any delta as long as it received the keyframe, even when intermediate updates were
+ * dropped or coalesced. A new keyframe is produced every 'keyframe_interval' updates and whenever
+ * the type of the value changes.
+ */
+class VariableDeltaEncoder
+{
+public:
+  explicit VariableDeltaEncoder(sup::dto::uint32 keyframe_interval);
+  ~VariableDeltaEncoder();
+
+  sup::dto::AnyValue Encode(const sup::dto::AnyValue& value, bool connected);
+
+private:
+  const sup::dto::uint32 m_keyframe_interval;
+  sup::dto::AnyValue m_keyframe;
+  sup::dto::uint64 m_keyframe_seq;
+  sup::dto::uint64 m_seq;
+};
+
+/**
+ * @brief VariableDeltaDecoder decodes the successive states of a single variable, encoded either
+ * by VariableDeltaEncoder or as a plain variable state (see EncodeVariableState).
+ *
+ * @details Besides the updates of the variable itself, the decoder can be fed the keyframes that
+ * are published separately (see DecodeKeyframe). This allows decoding the latest delta when its
+ * keyframe was not received as a variable update, e.g. because the client connected after the
+ * keyframe was published or because the keyframe was coalesced with later updates.
+ */
+class VariableDeltaDecoder
+{
+public:
+  VariableDeltaDecoder();
+  ~VariableDeltaDecoder();
+
+  /**
+   * @brief Decode the variable state. Deltas whose keyframe was not received, decode to an empty
+   * value.
+   *
+   * @param encoded Encoded variable state.
+   * @return Pair of variable value and its connected state.
+   */
+  std::pair<sup::dto::AnyValue, bool> Decode(const sup::dto::AnyValue& encoded);
+
+  /**
+   * @brief Decode a keyframe that was received separately from the variable updates. The keyframe
+   * is retained to decode later deltas, as well as the last delta that could not be decoded yet.
+   *
+   * @param encoded Encoded keyframe.
+   * @return Pair of variable value and its connected state if the keyframe allowed decoding a
+   * pending delta. Otherwise, the value is empty.
+   */
+  std::pair<sup::dto::AnyValue, bool> DecodeKeyframe(const sup::dto::AnyValue& encoded);
+
+private:
+  void StoreKeyframe(const sup::dto::AnyValue& value, sup::dto::uint64 seq);
+  std::pair<sup::dto::AnyValue, bool> ApplyDelta(const VariableDelta& delta) const;
+  bool m_has_keyframe;
+  sup::dto::AnyValue m_keyframe;
+  sup::dto::uint64 m_keyframe_seq;
+  bool m_has_pending_delta;
+  VariableDelta m_pending_delta;
+};
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_VARIABLE_DELTA_CODEC_H_
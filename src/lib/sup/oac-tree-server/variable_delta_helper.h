@@ -0,0 +1,115 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#ifndef SUP_OAC_TREE_SERVER_VARIABLE_DELTA_HELPER_H_
+#define SUP_OAC_TREE_SERVER_VARIABLE_DELTA_HELPER_H_
+
+#include <sup/dto/anyvalue.h>
+#include <sup/dto/basic_scalar_types.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sup
+{
+namespace oac_tree_server
+{
+
+// Sequence number of a variable update (both keyframes and deltas):
+const std::string kVariableSequenceField = "var_seq";
+
+// Variable delta type and fields:
+const std::string kVariableDeltaType = "sup::variableDeltaType/v1.0";
+// const std::string kVariableConnectedField already defined
+const std::string kVariableDeltaBaseField = "var_base";
+const std::string kVariableDeltaChangesField = "var_changes";
+// Fields of a single change:
+const std::string kVariableChangePathField = "path";
+const std::string kVariableChangeValueField = "value";
+
+/**
+ * @brief List of changed leaf values. Each leaf is identified by its path, e.g. "a.b[2].c", where
+ * the empty path denotes the value itself.
+ */
+using LeafChanges = std::vector<std::pair<std::string, sup::dto::AnyValue>>;
+
+/**
+ * @brief Structure holding a decoded variable delta.
+ */
+struct VariableDelta
+{
+  bool m_connected;
+  sup::dto::uint64 m_seq;
+  sup::dto::uint64 m_base;
+  LeafChanges m_changes;
+};
+
+/**
+ * @brief Get the list of leaf values that differ between two AnyValues.
+ *
+ * @param from Original value.
+ * @param to Changed value.
+ * @return Boolean indicating if both values have the same type and the list of changed leaves.
+ */
+std::pair<bool, LeafChanges> GetLeafChanges(const sup::dto::AnyValue& from,
+                                            const sup::dto::AnyValue& to);
+
+/**
+ * @brief Apply a list of changed leaf values to an AnyValue.
+ *
+ * @param value AnyValue to change.
+ * @param changes List of changed leaves.
+ * @return true on success. On failure, the value may be partially changed.
+ */
+bool ApplyLeafChanges(sup::dto::AnyValue& value, const LeafChanges& changes);
+
+/**
+ * @brief Pack a variable's value and connected state as a keyframe with the given sequence
+ * number. A keyframe can also be decoded with DecodeVariableState.
+ */
+sup::dto::AnyValue EncodeVariableKeyframe(const sup::dto::AnyValue& value, bool connected,
+                                          sup::dto::uint64 seq);
+
+/**
+ * @brief Pack the changes of a variable with respect to the keyframe with sequence number 'base'.
+ */
+sup::dto::AnyValue EncodeVariableDelta(const VariableDelta& delta);
+
+/**
+ * @brief Check if the given encoded variable state is a delta.
+ */
+bool IsVariableDelta(const sup::dto::AnyValue& encoded);
+
+/**
+ * @brief Check if the given encoded variable state carries a sequence number, i.e. it is a keyframe
+ * or a delta. This indicates that the server publishes keyframes on a separate channel.
+ */
+bool IsSequencedVariableState(const sup::dto::AnyValue& encoded);
+
+std::pair<bool, VariableDelta> DecodeVariableDelta(const sup::dto::AnyValue& encoded);
+
+}  // namespace oac_tree_server
+
+}  // namespace sup
+
+#endif  // SUP_OAC_TREE_SERVER_VARIABLE_DELTA_HELPER_H_
@@ -43,11 +43,24 @@ TEST_F(AnyValueUpdateCommandTest, CreateCommands)
   EXPECT_EQ(update_command.Name(), var_name);
   EXPECT_EQ(update_command.Value(), var_val);
 
+  // Keyframe update command
+  auto keyframe_command = AnyValueUpdateCommand::CreateKeyframeUpdate(var_name, var_val);
+  EXPECT_EQ(keyframe_command.GetCommandType(),
+            AnyValueUpdateCommand::CommandType::kKeyframeUpdate);
+  EXPECT_EQ(keyframe_command.Name(), var_name);
+  EXPECT_EQ(keyframe_command.Value(), var_val);
+
   // Exit command
   auto exit_command = AnyValueUpdateCommand::CreateExitCommand();
   EXPECT_EQ(exit_command.GetCommandType(), AnyValueUpdateCommand::CommandType::kExit);
   EXPECT_EQ(exit_command.Name(), "");
   EXPECT_EQ(exit_command.Value(), sup::dto::AnyValue{});
+
+  // Remove variable command
+  auto remove_command = AnyValueUpdateCommand::CreateRemoveVariableCommand(var_name);
+  EXPECT_EQ(remove_command.GetCommandType(), AnyValueUpdateCommand::CommandType::kRemoveVariable);
+  EXPECT_EQ(remove_command.Name(), var_name);
+  EXPECT_EQ(remove_command.Value(), sup::dto::AnyValue{});
 }
 
 TEST_F(AnyValueUpdateCommandTest, Move)
@@ -26,7 +26,9 @@
 
 #include <atomic>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace sup::oac_tree_server;
 
@@ -99,3 +101,155 @@ TEST_F(AnyValueUpdateQueueTest, WaitForNonEmpty)
   wait_future.get();
   EXPECT_TRUE(is_finished.load());
 }
+
+TEST_F(AnyValueUpdateQueueTest, Coalescing)
+{
+  // Create coalescing queue with multiple updates of the same channels
+  AnyValueUpdateQueue update_queue{AnyValueUpdateQueue::kCoalescing};
+  const std::string var_name = "my_var";
+  const std::string other_var_name = "other_var";
+  const std::string entry_name = "my_entry";
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  sup::dto::AnyValue var_val_3{ sup::dto::UnsignedInteger16Type, 3u };
+  update_queue.Push(var_name, var_val_1);
+  update_queue.Push(other_var_name, var_val_1);
+  update_queue.PushEntry(entry_name, var_val_1);
+  update_queue.Push(var_name, var_val_2);
+  update_queue.PushEntry(entry_name, var_val_2);
+  update_queue.PushExit();
+  update_queue.Push(var_name, var_val_3);
+
+  // Check popped commands: only the latest value of 'my_var' before the exit command is kept at
+  // the position of its first update, while entries are all kept.
+  update_queue.WaitForNonEmpty();
+  auto commands = update_queue.PopCommands();
+  ASSERT_EQ(commands.size(), 6);
+  EXPECT_EQ(commands.front().Name(), var_name);
+  EXPECT_EQ(commands.front().Value(), var_val_2);
+  commands.pop_front();
+  EXPECT_EQ(commands.front().Name(), other_var_name);
+  EXPECT_EQ(commands.front().Value(), var_val_1);
+  commands.pop_front();
+  EXPECT_EQ(commands.front().Name(), entry_name);
+  EXPECT_EQ(commands.front().Value(), var_val_1);
+  commands.pop_front();
+  EXPECT_EQ(commands.front().Name(), entry_name);
+  EXPECT_EQ(commands.front().Value(), var_val_2);
+  commands.pop_front();
+  EXPECT_EQ(commands.front().GetCommandType(), AnyValueUpdateCommand::CommandType::kExit);
+  commands.pop_front();
+  EXPECT_EQ(commands.front().GetCommandType(), AnyValueUpdateCommand::CommandType::kUpdate);
+  EXPECT_EQ(commands.front().Name(), var_name);
+  EXPECT_EQ(commands.front().Value(), var_val_3);
+
+  // After popping, new updates are queued again
+  update_queue.Push(var_name, var_val_1);
+  update_queue.Push(var_name, var_val_2);
+  commands = update_queue.PopCommands();
+  ASSERT_EQ(commands.size(), 1);
+  EXPECT_EQ(commands.front().Value(), var_val_2);
+}
+
+TEST_F(AnyValueUpdateQueueTest, Keyframes)
+{
+  // Keyframe updates are never coalesced and updates pushed afterwards are not coalesced with
+  // updates pushed before them
+  AnyValueUpdateQueue update_queue{AnyValueUpdateQueue::kCoalescing};
+  const std::string var_name = "my_var";
+  const std::string keyframe_name = "my_keyframe";
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  update_queue.PushKeyframe(keyframe_name, var_val_1);
+  update_queue.Push(keyframe_name, var_val_2);
+  update_queue.PushKeyframe(keyframe_name, var_val_1);
+  update_queue.Push(var_name, var_val_1);
+  update_queue.Push(var_name, var_val_2);
+  auto commands = update_queue.PopCommands();
+  ASSERT_EQ(commands.size(), 4);
+  EXPECT_EQ(commands[0].GetCommandType(), AnyValueUpdateCommand::CommandType::kKeyframeUpdate);
+  EXPECT_EQ(commands[0].Value(), var_val_1);
+  EXPECT_EQ(commands[1].GetCommandType(), AnyValueUpdateCommand::CommandType::kUpdate);
+  EXPECT_EQ(commands[1].Value(), var_val_2);
+  EXPECT_EQ(commands[2].GetCommandType(), AnyValueUpdateCommand::CommandType::kKeyframeUpdate);
+  EXPECT_EQ(commands[2].Value(), var_val_1);
+  EXPECT_EQ(commands[3].Name(), var_name);
+  EXPECT_EQ(commands[3].Value(), var_val_2);
+}
+
+TEST_F(AnyValueUpdateQueueTest, AddVariable)
+{
+  // Push add commands interleaved with updates
+  AnyValueUpdateQueue update_queue{AnyValueUpdateQueue::kCoalescing};
+  const std::string var_name = "my_var";
+  const std::string new_var_name = "new_var";
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  update_queue.Push(var_name, var_val_1);
+  update_queue.PushAddVariable(new_var_name, var_val_1);
+  update_queue.Push(new_var_name, var_val_2);
+  update_queue.Push(var_name, var_val_2);
+
+  // Process commands and check that adding and updating are dispatched in order
+  std::vector<std::string> processed;
+  auto update_func = [&processed](const std::string& channel, const sup::dto::AnyValue& value) {
+    processed.push_back("update:" + channel + ":" + std::to_string(value.As<sup::dto::uint16>()));
+  };
+  auto add_func = [&processed](const std::string& channel, const sup::dto::AnyValue& value) {
+    processed.push_back("add:" + channel + ":" + std::to_string(value.As<sup::dto::uint16>()));
+  };
+  auto remove_func = [&processed](const std::string& channel) {
+    processed.push_back("remove:" + channel);
+  };
+  update_queue.WaitForNonEmpty();
+  auto commands = update_queue.PopCommands();
+  ASSERT_EQ(commands.size(), 3);
+  EXPECT_FALSE(ProcessCommandQueue(commands, update_func, add_func, remove_func));
+  EXPECT_TRUE(commands.empty());
+  std::vector<std::string> expected{ "update:my_var:2", "add:new_var:1", "update:new_var:2" };
+  EXPECT_EQ(processed, expected);
+
+  // Exit command stops processing
+  update_queue.PushAddVariable(var_name, var_val_1);
+  update_queue.PushExit();
+  update_queue.Push(var_name, var_val_2);
+  commands = update_queue.PopCommands();
+  EXPECT_TRUE(ProcessCommandQueue(commands, update_func, add_func, remove_func));
+  ASSERT_EQ(commands.size(), 1);
+  EXPECT_EQ(processed.back(), "add:my_var:1");
+}
+
+TEST_F(AnyValueUpdateQueueTest, RemoveVariable)
+{
+  // Updates before and after removing and adding a variable again are not coalesced
+  AnyValueUpdateQueue update_queue{AnyValueUpdateQueue::kCoalescing};
+  const std::string var_name = "my_var";
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  sup::dto::AnyValue var_val_3{ sup::dto::UnsignedInteger16Type, 3u };
+  update_queue.Push(var_name, var_val_1);
+  update_queue.PushRemoveVariable(var_name);
+  update_queue.Push(var_name, var_val_2);
+  update_queue.PushAddVariable(var_name, var_val_1);
+  update_queue.Push(var_name, var_val_2);
+  update_queue.Push(var_name, var_val_3);
+
+  // Process commands and check they are dispatched in order
+  std::vector<std::string> processed;
+  auto update_func = [&processed](const std::string& channel, const sup::dto::AnyValue& value) {
+    processed.push_back("update:" + channel + ":" + std::to_string(value.As<sup::dto::uint16>()));
+  };
+  auto add_func = [&processed](const std::string& channel, const sup::dto::AnyValue& value) {
+    processed.push_back("add:" + channel + ":" + std::to_string(value.As<sup::dto::uint16>()));
+  };
+  auto remove_func = [&processed](const std::string& channel) {
+    processed.push_back("remove:" + channel);
+  };
+  update_queue.WaitForNonEmpty();
+  auto commands = update_queue.PopCommands();
+  ASSERT_EQ(commands.size(), 5);
+  EXPECT_FALSE(ProcessCommandQueue(commands, update_func, add_func, remove_func));
+  std::vector<std::string> expected{ "update:my_var:1", "remove:my_var", "update:my_var:2",
+                                     "add:my_var:1", "update:my_var:3" };
+  EXPECT_EQ(processed, expected);
+}
@@ -0,0 +1,273 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/epics/anyvalue_update_ring.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree_server;
+
+class AnyValueUpdateRingTest : public ::testing::Test
+{
+protected:
+  AnyValueUpdateRingTest() = default;
+  virtual ~AnyValueUpdateRingTest() = default;
+};
+
+TEST_F(AnyValueUpdateRingTest, Capacity)
+{
+  EXPECT_EQ(AnyValueUpdateRing(0, EPICSServerConfig::kBlock).GetCapacity(), 2);
+  EXPECT_EQ(AnyValueUpdateRing(2, EPICSServerConfig::kBlock).GetCapacity(), 2);
+  EXPECT_EQ(AnyValueUpdateRing(5, EPICSServerConfig::kBlock).GetCapacity(), 8);
+  EXPECT_EQ(AnyValueUpdateRing(1024, EPICSServerConfig::kBlock).GetCapacity(), 1024);
+}
+
+TEST_F(AnyValueUpdateRingTest, PushPop)
+{
+  // Push different commands
+  AnyValueUpdateRing update_ring{8, EPICSServerConfig::kBlock};
+  const std::string var_name = "my_var";
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  update_ring.PushAddVariable(var_name, var_val_1);
+  update_ring.Push(var_name, var_val_2);
+  update_ring.PushEntry(var_name, var_val_1);
+  update_ring.PushExit();
+
+  // Check popped commands
+  update_ring.WaitForNonEmpty();
+  auto commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 4);
+  EXPECT_EQ(commands[0].GetCommandType(), AnyValueUpdateCommand::kAddVariable);
+  EXPECT_EQ(commands[0].Value(), var_val_1);
+  EXPECT_EQ(commands[1].GetCommandType(), AnyValueUpdateCommand::kUpdate);
+  EXPECT_EQ(commands[1].Value(), var_val_2);
+  EXPECT_EQ(commands[2].GetCommandType(), AnyValueUpdateCommand::kUpdate);
+  EXPECT_EQ(commands[2].Value(), var_val_1);
+  EXPECT_EQ(commands[3].GetCommandType(), AnyValueUpdateCommand::kExit);
+  EXPECT_TRUE(update_ring.PopCommands().empty());
+}
+
+TEST_F(AnyValueUpdateRingTest, BlockOnOverflow)
+{
+  // Fill the ring and check that the next push blocks until commands are popped
+  AnyValueUpdateRing update_ring{2, EPICSServerConfig::kBlock};
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  sup::dto::AnyValue var_val_3{ sup::dto::UnsignedInteger16Type, 3u };
+  update_ring.Push("var", var_val_1);
+  update_ring.Push("var", var_val_2);
+  auto future = std::async(std::launch::async, [&update_ring, &var_val_3](){
+    update_ring.Push("var", var_val_3);
+  });
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+  auto commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 2);
+  EXPECT_EQ(commands[0].Value(), var_val_1);
+  EXPECT_EQ(commands[1].Value(), var_val_2);
+  future.get();
+  commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 1);
+  EXPECT_EQ(commands[0].Value(), var_val_3);
+}
+
+TEST_F(AnyValueUpdateRingTest, WakeAllBlockedProducers)
+{
+  // Block two producers on a full ring and check that popping once lets both of them continue
+  AnyValueUpdateRing update_ring{2, EPICSServerConfig::kBlock};
+  sup::dto::AnyValue var_val{ sup::dto::UnsignedInteger16Type, 1u };
+  update_ring.Push("var", var_val);
+  update_ring.Push("var", var_val);
+  auto future_1 = std::async(std::launch::async, [&update_ring, &var_val](){
+    update_ring.PushEntry("var_1", var_val);
+  });
+  auto future_2 = std::async(std::launch::async, [&update_ring, &var_val](){
+    update_ring.PushEntry("var_2", var_val);
+  });
+  EXPECT_EQ(future_1.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+  EXPECT_EQ(future_2.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+  auto commands = update_ring.PopCommands();
+  EXPECT_EQ(commands.size(), 2);
+  future_1.get();
+  future_2.get();
+  commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 2);
+  EXPECT_NE(commands[0].Name(), commands[1].Name());
+}
+
+TEST_F(AnyValueUpdateRingTest, DropOldestOnOverflow)
+{
+  // Overflow the ring: only value updates are dropped
+  AnyValueUpdateRing update_ring{4, EPICSServerConfig::kDropOldest};
+  update_ring.PushAddVariable("var", { sup::dto::UnsignedInteger16Type, 0u });
+  for (sup::dto::uint16 val = 1; val < 10; ++val)
+  {
+    update_ring.Push("var", { sup::dto::UnsignedInteger16Type, val });
+  }
+  auto commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 5);
+  EXPECT_EQ(commands[0].GetCommandType(), AnyValueUpdateCommand::kAddVariable);
+  for (sup::dto::uint16 idx = 1; idx < 5; ++idx)
+  {
+    EXPECT_EQ(commands[idx].GetCommandType(), AnyValueUpdateCommand::kUpdate);
+    EXPECT_EQ(commands[idx].Value().As<sup::dto::uint16>(), idx + 5);
+  }
+}
+
+TEST_F(AnyValueUpdateRingTest, KeyframesOnOverflow)
+{
+  // Keyframe updates are never dropped
+  AnyValueUpdateRing drop_ring{4, EPICSServerConfig::kDropOldest};
+  drop_ring.PushKeyframe("key", { sup::dto::UnsignedInteger16Type, 0u });
+  for (sup::dto::uint16 val = 1; val < 10; ++val)
+  {
+    drop_ring.Push("var", { sup::dto::UnsignedInteger16Type, val });
+  }
+  auto commands = drop_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 5);
+  EXPECT_EQ(commands[0].GetCommandType(), AnyValueUpdateCommand::kKeyframeUpdate);
+  EXPECT_EQ(commands[0].Name(), "key");
+
+  // Keyframe updates are never coalesced, while state updates still are
+  AnyValueUpdateRing coalesce_ring{2, EPICSServerConfig::kCoalesce};
+  sup::dto::AnyValue val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  sup::dto::AnyValue val_3{ sup::dto::UnsignedInteger16Type, 3u };
+  coalesce_ring.Push("var", val_1);
+  coalesce_ring.Push("var", val_1);
+  coalesce_ring.Push("var", val_2);
+  coalesce_ring.PushKeyframe("key", val_2);
+  coalesce_ring.PushKeyframe("key", val_3);
+  coalesce_ring.Push("var", val_3);
+  commands = coalesce_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 5);
+  EXPECT_EQ(commands[2].Name(), "var");
+  EXPECT_EQ(commands[2].Value(), val_3);
+  EXPECT_EQ(commands[3].GetCommandType(), AnyValueUpdateCommand::kKeyframeUpdate);
+  EXPECT_EQ(commands[3].Value(), val_2);
+  EXPECT_EQ(commands[4].GetCommandType(), AnyValueUpdateCommand::kKeyframeUpdate);
+  EXPECT_EQ(commands[4].Value(), val_3);
+}
+
+TEST_F(AnyValueUpdateRingTest, CoalesceOnOverflow)
+{
+  // Overflow the ring with state updates and entries
+  AnyValueUpdateRing update_ring{2, EPICSServerConfig::kCoalesce};
+  sup::dto::AnyValue var_val_1{ sup::dto::UnsignedInteger16Type, 1u };
+  sup::dto::AnyValue var_val_2{ sup::dto::UnsignedInteger16Type, 2u };
+  sup::dto::AnyValue var_val_3{ sup::dto::UnsignedInteger16Type, 3u };
+  update_ring.Push("var_a", var_val_1);
+  update_ring.Push("var_b", var_val_1);
+  update_ring.Push("var_a", var_val_2);
+  update_ring.Push("var_b", var_val_2);
+  update_ring.Push("var_a", var_val_3);
+  auto commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 4);
+  EXPECT_EQ(commands[0].Name(), "var_a");
+  EXPECT_EQ(commands[0].Value(), var_val_1);
+  EXPECT_EQ(commands[1].Name(), "var_b");
+  EXPECT_EQ(commands[1].Value(), var_val_1);
+  EXPECT_EQ(commands[2].Name(), "var_a");
+  EXPECT_EQ(commands[2].Value(), var_val_3);
+  EXPECT_EQ(commands[3].Name(), "var_b");
+  EXPECT_EQ(commands[3].Value(), var_val_2);
+
+  // Entries are never coalesced and block on overflow
+  update_ring.PushEntry("log", var_val_1);
+  update_ring.PushEntry("log", var_val_2);
+  auto future = std::async(std::launch::async, [&update_ring, &var_val_3](){
+    update_ring.PushEntry("log", var_val_3);
+  });
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+  EXPECT_EQ(update_ring.PopCommands().size(), 2);
+  future.get();
+  EXPECT_EQ(update_ring.PopCommands().size(), 1);
+
+  // Removing and adding a variable keeps its order with respect to coalesced updates
+  update_ring.Push("var_a", var_val_1);
+  update_ring.Push("var_b", var_val_1);
+  update_ring.Push("var_a", var_val_2);
+  update_ring.PushRemoveVariable("var_a");
+  update_ring.PushAddVariable("var_a", var_val_1);
+  update_ring.Push("var_a", var_val_3);
+  commands = update_ring.PopCommands();
+  ASSERT_EQ(commands.size(), 6);
+  EXPECT_EQ(commands[2].GetCommandType(), AnyValueUpdateCommand::kUpdate);
+  EXPECT_EQ(commands[2].Value(), var_val_2);
+  EXPECT_EQ(commands[3].GetCommandType(), AnyValueUpdateCommand::kRemoveVariable);
+  EXPECT_EQ(commands[4].GetCommandType(), AnyValueUpdateCommand::kAddVariable);
+  EXPECT_EQ(commands[5].GetCommandType(), AnyValueUpdateCommand::kUpdate);
+  EXPECT_EQ(commands[5].Value(), var_val_3);
+}
+
+TEST_F(AnyValueUpdateRingTest, MultipleProducers)
+{
+  // Several producers push entries while a single consumer processes them
+  const sup::dto::uint32 n_producers = 4;
+  const sup::dto::uint32 n_entries = 5000;
+  AnyValueUpdateRing update_ring{16, EPICSServerConfig::kBlock};
+  auto producer = [&update_ring, n_entries](sup::dto::uint16 producer_idx) {
+    for (sup::dto::uint32 idx = 0; idx < n_entries; ++idx)
+    {
+      update_ring.PushEntry("producer", { sup::dto::UnsignedInteger16Type, producer_idx });
+    }
+  };
+  auto consumer = [&update_ring, n_producers]() {
+    std::vector<sup::dto::uint32> counts(n_producers, 0);
+    bool exit = false;
+    while (!exit)
+    {
+      update_ring.WaitForNonEmpty();
+      auto commands = update_ring.PopCommands();
+      for (auto& command : commands)
+      {
+        if (command.GetCommandType() == AnyValueUpdateCommand::kExit)
+        {
+          exit = true;
+          break;
+        }
+        ++counts[command.Value().As<sup::dto::uint16>()];
+      }
+    }
+    return counts;
+  };
+  auto consumer_future = std::async(std::launch::async, consumer);
+  std::vector<std::thread> producers;
+  for (sup::dto::uint16 idx = 0; idx < n_producers; ++idx)
+  {
+    producers.emplace_back(producer, idx);
+  }
+  for (auto& producer_thread : producers)
+  {
+    producer_thread.join();
+  }
+  update_ring.PushExit();
+  auto counts = consumer_future.get();
+  for (auto count : counts)
+  {
+    EXPECT_EQ(count, n_entries);
+  }
+}
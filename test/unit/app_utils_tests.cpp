@@ -22,8 +22,16 @@
 
 #include <app/oac-tree-server/utils.h>
 
+#include "unit_test_helper.h"
+
+#include <sup/oac-tree-server/exceptions.h>
+
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
 using namespace sup::oac_tree_server;
 
 class AppUtilsTest : public ::testing::Test
@@ -49,3 +57,155 @@ TEST_F(AppUtilsTest, Filelist)
   std::vector<std::string> expected{ "file1", "file2" };
   EXPECT_EQ(utils::GetProcedureFilenames(parser), expected);
 }
+
+TEST_F(AppUtilsTest, SortedDirectoryFilelist)
+{
+  auto dir = std::filesystem::temp_directory_path() / "oac_tree_server_app_utils_sorted";
+  std::filesystem::remove_all(dir);
+  ASSERT_TRUE(std::filesystem::create_directory(dir));
+  for (const auto& name : { "c.xml", "a.xml", "b.xml", "ignored.txt" })
+  {
+    std::ofstream{dir / name} << "content";
+  }
+  sup::cli::CommandLineParser parser;
+  parser.AddOption({"-d", "--dir"}, "Directory containing files with xml extension to be parsed and run")
+      .SetParameter(true)
+      .SetValueName("directory_name");
+
+  parser.AddPositionalOption("FILE...", "File(s) to be parsed and run as procedures");
+
+  const auto dir_name = dir.string();
+  const int argc = 4;
+  std::array<const char *, argc> argv{"progname", "-d", dir_name.c_str(), "file1"};
+
+  EXPECT_TRUE(parser.Parse(argc, &argv[0]));
+  std::vector<std::string> expected{ (dir / "a.xml").string(), (dir / "b.xml").string(),
+                                     (dir / "c.xml").string(), "file1" };
+  EXPECT_EQ(utils::GetProcedureFilenames(parser), expected);
+  std::filesystem::remove_all(dir);
+}
+
+TEST_F(AppUtilsTest, ParseProcedureFiles)
+{
+  auto dir = std::filesystem::temp_directory_path() / "oac_tree_server_app_utils_parse";
+  std::filesystem::remove_all(dir);
+  ASSERT_TRUE(std::filesystem::create_directory(dir));
+  const auto valid_file = (dir / "valid.xml").string();
+  const auto invalid_file = (dir / "invalid.xml").string();
+  const auto missing_file = (dir / "missing.xml").string();
+  std::ofstream{valid_file} << UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  std::ofstream{invalid_file} << "<Procedure><Sequence>";
+
+  // Failing files are reported and skipped without aborting the others
+  std::ostringstream errors;
+  auto procedures = utils::ParseProcedureFiles(
+    { valid_file, invalid_file, valid_file, missing_file }, errors);
+  EXPECT_EQ(procedures.size(), 2u);
+  for (const auto& proc : procedures)
+  {
+    EXPECT_NE(proc.get(), nullptr);
+  }
+  auto error_message = errors.str();
+  EXPECT_NE(error_message.find(invalid_file), std::string::npos);
+  EXPECT_NE(error_message.find(missing_file), std::string::npos);
+  EXPECT_EQ(error_message.find(valid_file), std::string::npos);
+  std::filesystem::remove_all(dir);
+}
+
+TEST_F(AppUtilsTest, ProcedureDirectoryWatcher)
+{
+  auto dir = std::filesystem::temp_directory_path() / "oac_tree_server_app_utils_watch";
+  std::filesystem::remove_all(dir);
+  ASSERT_TRUE(std::filesystem::create_directory(dir));
+  const auto file_a = (dir / "a.xml").string();
+  const auto file_b = (dir / "b.xml").string();
+  const auto file_c = (dir / "c.xml").string();
+  std::ofstream{file_a} << UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  std::ofstream{file_b} << UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+
+  UnitTestHelper::TestAnyValueManagerRegistry av_mgr_registry;
+  AutomationServer auto_server{"AppUtilsTest:Watch", av_mgr_registry};
+  std::ostringstream errors;
+  utils::ProcedureDirectoryWatcher watcher{dir.string(), auto_server, errors};
+
+  // Jobs added at startup are registered, so they are not added twice:
+  auto proc_list = utils::ParseProcedureFiles({ file_a }, errors);
+  ASSERT_EQ(proc_list.size(), 1u);
+  auto job_idx_a = auto_server.AddJob(std::move(proc_list.front()));
+  watcher.RegisterJob(file_a, job_idx_a);
+  watcher.RegisterJob("not_in_directory.xml", 5u);
+  watcher.Update();
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 2u);
+  auto generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(generations.size(), 2u);
+
+  // Nothing changed:
+  watcher.Update();
+  EXPECT_EQ(auto_server.GetJobGenerations(), generations);
+
+  // Modified file replaces its job, new file adds a job:
+  auto write_time = std::filesystem::last_write_time(file_a);
+  std::filesystem::last_write_time(file_a, write_time + std::chrono::seconds(1));
+  std::ofstream{file_c} << UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  watcher.Update();
+  auto new_generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(new_generations.size(), 3u);
+  EXPECT_NE(new_generations[0], generations[0]);
+  EXPECT_EQ(new_generations[1], generations[1]);
+
+  // Modified file that fails to parse keeps its job:
+  std::ofstream{file_c} << "<Procedure><Sequence>";
+  write_time = std::filesystem::last_write_time(file_c);
+  std::filesystem::last_write_time(file_c, write_time + std::chrono::seconds(1));
+  watcher.Update();
+  EXPECT_NE(errors.str().find(file_c), std::string::npos);
+  EXPECT_EQ(auto_server.GetJobGenerations()[2], new_generations[2]);
+
+  // Deleted file removes its job:
+  std::filesystem::remove(file_b);
+  watcher.Update();
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 3u);
+  EXPECT_THROW(auto_server.GetJobInfo(1), InvalidOperationException);
+  EXPECT_NO_THROW(auto_server.GetJobInfo(0));
+  std::filesystem::remove_all(dir);
+}
+
+TEST_F(AppUtilsTest, ProcedureDirectoryWatcherEvents)
+{
+  auto dir = std::filesystem::temp_directory_path() / "oac_tree_server_app_utils_events";
+  std::filesystem::remove_all(dir);
+  ASSERT_TRUE(std::filesystem::create_directory(dir));
+  const auto file_a = (dir / "a.xml").string();
+
+  UnitTestHelper::TestAnyValueManagerRegistry av_mgr_registry;
+  AutomationServer auto_server{"AppUtilsTest:Events", av_mgr_registry};
+  std::ostringstream errors;
+  utils::ProcedureDirectoryWatcher watcher{dir.string(), auto_server, errors};
+  EXPECT_TRUE(errors.str().empty());
+  EXPECT_FALSE(watcher.WaitForChanges(10));
+
+  // Added file is reported and adds a job:
+  std::ofstream{file_a} << UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  EXPECT_TRUE(watcher.WaitForChanges(1000));
+  watcher.Update();
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 1u);
+  auto generations = auto_server.GetJobGenerations();
+  EXPECT_FALSE(watcher.WaitForChanges(10));
+
+  // Modified file is reported and replaces its job:
+  std::ofstream{file_a} << UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  auto write_time = std::filesystem::last_write_time(file_a);
+  std::filesystem::last_write_time(file_a, write_time + std::chrono::seconds(1));
+  EXPECT_TRUE(watcher.WaitForChanges(1000));
+  watcher.Update();
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 1u);
+  EXPECT_NE(auto_server.GetJobGenerations()[0], generations[0]);
+  EXPECT_FALSE(watcher.WaitForChanges(10));
+
+  // Deleted file is reported and removes its job:
+  std::filesystem::remove(file_a);
+  EXPECT_TRUE(watcher.WaitForChanges(1000));
+  watcher.Update();
+  EXPECT_THROW(auto_server.GetJobInfo(0), InvalidOperationException);
+  std::filesystem::remove_all(dir);
+}
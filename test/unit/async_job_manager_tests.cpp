@@ -0,0 +1,165 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/async_job_manager.h>
+#include <sup/oac-tree-server/automation_protocol_client.h>
+#include <sup/oac-tree-server/control_protocol_server.h>
+#include <sup/oac-tree-server/exceptions.h>
+#include <sup/oac-tree-server/info_protocol_server.h>
+
+#include "unit_test_helper.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using ::testing::_;
+using ::testing::Exactly;
+using ::testing::Return;
+
+using namespace sup::oac_tree_server;
+
+namespace
+{
+// Mock job manager that declares support for concurrent calls, as gmock mocks are thread-safe
+class ConcurrentMockJobManager : public UnitTestHelper::MockJobManager
+{
+public:
+  bool SupportsConcurrentCalls() const override { return true; }
+};
+}  // unnamed namespace
+
+class AsyncJobManagerTest : public ::testing::Test
+{
+protected:
+  AsyncJobManagerTest();
+  virtual ~AsyncJobManagerTest();
+
+  using StrictMockJobManager = ::testing::StrictMock<UnitTestHelper::MockJobManager>;
+  StrictMockJobManager m_job_manager;
+  ::testing::StrictMock<ConcurrentMockJobManager> m_concurrent_job_manager;
+  InfoProtocolServer m_info_server;
+  ControlProtocolServer m_control_server;
+  AutomationProtocolClient m_client_job_manager;
+  AsyncJobManager m_async_job_manager;
+};
+
+TEST_F(AsyncJobManagerTest, Requests)
+{
+  const std::string server_prefix = "AsyncTestServerPrefix";
+  const sup::dto::uint32 n_jobs = 42u;
+  const sup::dto::uint32 job_id = 3u;
+  auto command = sup::oac_tree::JobCommand::kStart;
+  EXPECT_CALL(m_job_manager, GetServerPrefix()).Times(Exactly(1)).WillOnce(Return(server_prefix));
+  auto prefix_future = m_async_job_manager.GetServerPrefix();
+  EXPECT_EQ(prefix_future.get(), server_prefix);
+
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(2)).WillRepeatedly(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, SendJobCommand(job_id, command)).Times(Exactly(1));
+  auto n_jobs_future = m_async_job_manager.GetNumberOfJobs();
+  auto command_future = m_async_job_manager.SendJobCommand(job_id, command);
+  EXPECT_EQ(n_jobs_future.get(), n_jobs);
+  EXPECT_NO_THROW(command_future.get());
+}
+
+TEST_F(AsyncJobManagerTest, Exceptions)
+{
+  // Failures are reported through the future of the failing request only
+  const sup::dto::uint32 n_jobs = 42u;
+  auto command = sup::oac_tree::JobCommand::kStart;
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  auto command_future = m_async_job_manager.SendJobCommand(n_jobs, command);
+  EXPECT_THROW(command_future.get(), InvalidOperationException);
+}
+
+TEST_F(AsyncJobManagerTest, NoHeadOfLineBlocking)
+{
+  // With multiple threads, a slow request does not delay the replies of requests that were sent
+  // later
+  const std::string server_prefix = "AsyncTestServerPrefix";
+  const sup::dto::uint32 n_jobs = 42u;
+  std::promise<void> release_prefix;
+  auto release_future = release_prefix.get_future().share();
+  AsyncJobManager concurrent_manager{m_concurrent_job_manager, 2u};
+  EXPECT_CALL(m_concurrent_job_manager, GetServerPrefix()).Times(Exactly(1))
+    .WillOnce([release_future, server_prefix]() {
+      release_future.wait();
+      return server_prefix;
+    });
+  EXPECT_CALL(m_concurrent_job_manager, GetNumberOfJobs()).Times(Exactly(1))
+    .WillOnce(Return(n_jobs));
+  auto prefix_future = concurrent_manager.GetServerPrefix();
+  auto n_jobs_future = concurrent_manager.GetNumberOfJobs();
+  ASSERT_EQ(n_jobs_future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_EQ(n_jobs_future.get(), n_jobs);
+  EXPECT_EQ(prefix_future.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+  release_prefix.set_value();
+  EXPECT_EQ(prefix_future.get(), server_prefix);
+}
+
+TEST_F(AsyncJobManagerTest, BoundedThreads)
+{
+  // Requests beyond the number of threads wait until a thread becomes available
+  EXPECT_EQ(m_async_job_manager.GetNumberOfThreads(), kDefaultAsyncJobManagerThreads);
+  AsyncJobManager single_thread_manager{m_client_job_manager, 1u};
+  EXPECT_EQ(single_thread_manager.GetNumberOfThreads(), 1u);
+  const std::string server_prefix = "AsyncTestServerPrefix";
+  const sup::dto::uint32 n_jobs = 42u;
+  std::promise<void> release_prefix;
+  auto release_future = release_prefix.get_future().share();
+  EXPECT_CALL(m_job_manager, GetServerPrefix()).Times(Exactly(1))
+    .WillOnce([release_future, server_prefix]() {
+      release_future.wait();
+      return server_prefix;
+    });
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  auto prefix_future = single_thread_manager.GetServerPrefix();
+  auto n_jobs_future = single_thread_manager.GetNumberOfJobs();
+  EXPECT_EQ(n_jobs_future.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+  release_prefix.set_value();
+  EXPECT_EQ(prefix_future.get(), server_prefix);
+  EXPECT_EQ(n_jobs_future.get(), n_jobs);
+
+  // Zero threads is not allowed
+  EXPECT_THROW(AsyncJobManager(m_client_job_manager, 0u), InvalidOperationException);
+}
+
+TEST_F(AsyncJobManagerTest, ConcurrentCallsRequireSupport)
+{
+  // Only job managers that support concurrent calls can be wrapped with multiple threads
+  EXPECT_EQ(kDefaultAsyncJobManagerThreads, 1u);
+  EXPECT_FALSE(m_client_job_manager.SupportsConcurrentCalls());
+  EXPECT_THROW(AsyncJobManager(m_client_job_manager, 2u), InvalidOperationException);
+  AsyncJobManager concurrent_manager{m_concurrent_job_manager, 4u};
+  EXPECT_EQ(concurrent_manager.GetNumberOfThreads(), 4u);
+}
+
+AsyncJobManagerTest::AsyncJobManagerTest()
+  : m_job_manager{}
+  , m_concurrent_job_manager{}
+  , m_info_server{m_job_manager}
+  , m_control_server{m_job_manager}
+  , m_client_job_manager{m_info_server, m_control_server}
+  , m_async_job_manager{m_client_job_manager}
+{}
+
+AsyncJobManagerTest::~AsyncJobManagerTest() = default;
@@ -34,6 +34,13 @@ using namespace sup::oac_tree_server;
 
 const std::string kTestPrefix = "AutomationServerTests";
 
+// Procedure that can be parsed, but fails to be set up:
+const std::string kInvalidSetupProcedureBody{
+R"RAW(
+  <Wait timeout="not_a_number"/>
+  <Workspace/>
+)RAW"};
+
 class AutomationServerTests : public ::testing::Test
 {
 protected:
@@ -72,7 +79,14 @@ TEST_F(AutomationServerTests, ServerWithOneProcedure)
   const auto& job_info = auto_server.GetJobInfo(0);
   EXPECT_EQ(job_info.GetProcedureName(), "Common header");
   EXPECT_EQ(job_info.GetNumberOfVariables(), 0);
+  EXPECT_EQ(auto_server.GetNumberOfInstructions(0), job_info.GetNumberOfInstructions());
   EXPECT_THROW(auto_server.GetJobInfo(1), InvalidOperationException);
+  EXPECT_THROW(auto_server.GetNumberOfInstructions(1), InvalidOperationException);
+  const auto n_instr = job_info.GetNumberOfInstructions();
+  EXPECT_NO_THROW(auto_server.EditBreakpoints(0, {0u}, true));
+  EXPECT_NO_THROW(auto_server.EditBreakpoints(0, {0u}, false));
+  EXPECT_THROW(auto_server.EditBreakpoints(0, {0u, n_instr}, true), InvalidOperationException);
+  EXPECT_THROW(auto_server.EditBreakpoints(1, {0u}, true), InvalidOperationException);
   EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kStart));
   EXPECT_THROW(auto_server.SendJobCommand(1, JobCommand::kStart), InvalidOperationException);
 }
@@ -98,8 +112,176 @@ TEST_F(AutomationServerTests, ServerWithTwoProcedures)
   EXPECT_EQ(job_info_2.GetProcedureName(), "Common header");
   EXPECT_EQ(job_info_2.GetNumberOfVariables(), 0);
   EXPECT_THROW(auto_server.GetJobInfo(2), InvalidOperationException);
+  auto generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(generations.size(), 2u);
+  EXPECT_NE(generations[0], 0u);
+  EXPECT_NE(generations[0], generations[1]);
   EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kStart));
   EXPECT_NO_THROW(auto_server.SendJobCommand(1, JobCommand::kStart));
   EXPECT_THROW(auto_server.SendJobCommand(2, JobCommand::kStart), InvalidOperationException);
   EXPECT_THROW(auto_server.SendJobCommand(1, JobCommand::kTerminate), InvalidOperationException);
+  const std::vector<bool> all_sent{true, true};
+  EXPECT_EQ(auto_server.SendJobCommands({}, JobCommand::kHalt), all_sent);
+  const std::vector<bool> partially_sent{true, false};
+  EXPECT_EQ(auto_server.SendJobCommands({1u, 2u}, JobCommand::kHalt), partially_sent);
+  EXPECT_EQ(auto_server.SendJobCommands({0u, 1u}, JobCommand::kTerminate),
+            (std::vector<bool>{false, false}));
+}
+
+TEST_F(AutomationServerTests, AddJobs)
+{
+  const std::string prefix = "AutomationServerTests:AddJobs";
+  const auto long_wait_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  const auto sequence_string = UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  const auto invalid_string = UnitTestHelper::CreateProcedureString(kInvalidSetupProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(long_wait_string)), 0u);
+  const auto n_long_wait_instr = auto_server.GetNumberOfInstructions(0);
+
+  // Jobs get consecutive indices in the order of the procedures:
+  std::vector<std::unique_ptr<sup::oac_tree::Procedure>> procs;
+  procs.push_back(sup::oac_tree::ParseProcedureString(sequence_string));
+  procs.push_back(sup::oac_tree::ParseProcedureString(long_wait_string));
+  procs.push_back(sup::oac_tree::ParseProcedureString(sequence_string));
+  std::vector<ProcedureFactory> factories(procs.size());
+  std::vector<sup::dto::uint32> expected_indices{ 1u, 2u, 3u };
+  EXPECT_EQ(auto_server.AddJobs(std::move(procs), factories), expected_indices);
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 4u);
+  const auto n_sequence_instr = auto_server.GetNumberOfInstructions(1);
+  EXPECT_NE(n_sequence_instr, n_long_wait_instr);
+  EXPECT_EQ(auto_server.GetNumberOfInstructions(2), n_long_wait_instr);
+  EXPECT_EQ(auto_server.GetNumberOfInstructions(3), n_sequence_instr);
+
+  // No jobs are added when the factories do not match or when one of the jobs fails:
+  procs.clear();
+  procs.push_back(sup::oac_tree::ParseProcedureString(sequence_string));
+  EXPECT_THROW(auto_server.AddJobs(std::move(procs), {}), InvalidOperationException);
+  procs.clear();
+  procs.push_back(sup::oac_tree::ParseProcedureString(sequence_string));
+  procs.push_back(sup::oac_tree::ParseProcedureString(invalid_string));
+  EXPECT_ANY_THROW(auto_server.AddJobs(std::move(procs), std::vector<ProcedureFactory>(2)));
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 4u);
+  EXPECT_TRUE(auto_server.AddJobs({}, {}).empty());
+}
+
+TEST_F(AutomationServerTests, LazyInstantiation)
+{
+  using sup::oac_tree::JobCommand;
+  const std::string prefix = "AutomationServerTests:Lazy";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  auto proc_1 = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc_1.get(), nullptr);
+  auto proc_2 = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc_2.get(), nullptr);
+  ServerJobConfig server_job_config{};
+  server_job_config.m_lazy_instantiation = true;
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry, ServerJobInfoIOConfig{},
+                               server_job_config};
+  auto factory = [procedure_string]() {
+    return sup::oac_tree::ParseProcedureString(procedure_string);
+  };
+  auto_server.AddJob(std::move(proc_1), factory);
+  auto_server.AddJob(std::move(proc_2));
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 2);
+  auto output_entries = auto_server.GetOutputEntries(0, { 0, 0, 0 });
+  EXPECT_TRUE(output_entries.m_log_entries.empty());
+  EXPECT_TRUE(output_entries.m_message_entries.empty());
+  EXPECT_TRUE(output_entries.m_output_value_entries.empty());
+  auto generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(generations.size(), 2u);
+
+  // Jobs are instantiated on first use and can only be torn down when they have a factory:
+  const auto& job_info_1 = auto_server.GetJobInfo(0);
+  EXPECT_EQ(job_info_1.GetProcedureName(), "Common header");
+  EXPECT_NO_THROW(auto_server.SendJobCommand(1, JobCommand::kStart));
+  EXPECT_EQ(auto_server.TearDownIdleJobs(), 1u);
+  EXPECT_EQ(auto_server.TearDownIdleJobs(), 0u);
+  EXPECT_EQ(auto_server.GetJobGenerations(), generations);
+
+  // A torn down job is instantiated again from its factory with a new generation:
+  EXPECT_EQ(auto_server.GetNumberOfInstructions(0), job_info_1.GetNumberOfInstructions());
+  auto new_generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(new_generations.size(), 2u);
+  EXPECT_NE(new_generations[0], generations[0]);
+  EXPECT_EQ(new_generations[1], generations[1]);
+  EXPECT_NO_THROW(auto_server.SendJobCommand(1, JobCommand::kHalt));
+}
+
+TEST_F(AutomationServerTests, ReplaceAndRemoveJobs)
+{
+  using sup::oac_tree::JobCommand;
+  const std::string prefix = "AutomationServerTests:Replace";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 1u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 2u);
+  auto generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(generations.size(), 3u);
+  EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kStart));
+
+  // Replacing a running job keeps its index and assigns a new generation:
+  auto_server.ReplaceJob(0, sup::oac_tree::ParseProcedureString(procedure_string));
+  auto new_generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(new_generations.size(), 3u);
+  EXPECT_NE(new_generations[0], generations[0]);
+  EXPECT_EQ(new_generations[1], generations[1]);
+  EXPECT_EQ(auto_server.GetJobInfo(0).GetProcedureName(), "Common header");
+  EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kStart));
+
+  // A replacement that cannot be created keeps the current job:
+  EXPECT_THROW(auto_server.ReplaceJob(2, {}), InvalidOperationException);
+  EXPECT_EQ(auto_server.GetJobGenerations()[2], generations[2]);
+  EXPECT_NO_THROW(auto_server.GetJobInfo(2));
+
+  // Removing a job keeps the indices of the other jobs:
+  auto_server.RemoveJob(1);
+  EXPECT_EQ(auto_server.GetNumberOfJobs(), 3u);
+  EXPECT_THROW(auto_server.GetJobInfo(1), InvalidOperationException);
+  EXPECT_THROW(auto_server.SendJobCommand(1, JobCommand::kStart), InvalidOperationException);
+  EXPECT_THROW(auto_server.RemoveJob(1), InvalidOperationException);
+  EXPECT_THROW(auto_server.ReplaceJob(1, sup::oac_tree::ParseProcedureString(procedure_string)),
+               InvalidOperationException);
+  EXPECT_EQ(auto_server.GetJobGenerations()[1], 0u);
+  EXPECT_NO_THROW(auto_server.GetJobInfo(2));
+  auto all_infos = auto_server.GetAllJobInfos({});
+  EXPECT_EQ(all_infos.m_n_jobs, 3u);
+  EXPECT_EQ(all_infos.m_job_infos.size(), 2u);
+  const std::vector<sup::dto::uint32> remaining_indices{ 0u, 2u };
+  EXPECT_EQ(all_infos.m_job_indices, remaining_indices);
+  EXPECT_EQ(all_infos.m_job_infos[1], auto_server.GetJobInfo(2));
+
+  // Indices of removed jobs are not reused:
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 3u);
+  EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kHalt));
+}
+
+TEST_F(AutomationServerTests, ReplaceJobWithInvalidProcedure)
+{
+  using sup::oac_tree::JobCommand;
+  using sup::oac_tree::JobState;
+  const std::string prefix = "AutomationServerTests:ReplaceInvalid";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  const auto invalid_string = UnitTestHelper::CreateProcedureString(kInvalidSetupProcedureBody);
+  auto& av_mgr = dynamic_cast<UnitTestHelper::TestAnyValueManager&>(
+    m_test_av_mgr_registry.GetAnyValueManager(0));
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  auto job_state_name = GetJobStatePVName(CreateJobPrefix(prefix, 0));
+  EXPECT_NO_THROW(auto_server.SendJobCommand(0, JobCommand::kStart));
+  EXPECT_TRUE(av_mgr.WaitForValue(job_state_name, GetJobStateValue(JobState::kRunning), 1.0));
+  auto generations = auto_server.GetJobGenerations();
+
+  // A replacement that cannot be set up keeps the current job running and publishes nothing:
+  EXPECT_ANY_THROW(auto_server.ReplaceJob(
+    0, sup::oac_tree::ParseProcedureString(invalid_string)));
+  EXPECT_EQ(auto_server.GetJobGenerations(), generations);
+  EXPECT_EQ(av_mgr.GetAnyValue(job_state_name), GetJobStateValue(JobState::kRunning));
+  EXPECT_NO_THROW(auto_server.GetJobInfo(0));
+
+  // A valid replacement still succeeds afterwards:
+  EXPECT_NO_THROW(auto_server.ReplaceJob(
+    0, sup::oac_tree::ParseProcedureString(procedure_string)));
+  EXPECT_NE(auto_server.GetJobGenerations()[0], generations[0]);
+  EXPECT_TRUE(av_mgr.WaitForValue(job_state_name, GetJobStateValue(JobState::kInitial), 1.0));
 }
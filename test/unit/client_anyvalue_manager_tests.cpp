@@ -24,6 +24,8 @@
 
 #include <sup/oac-tree-server/client_anyvalue_manager.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/output_entry_helper.h>
+#include <sup/oac-tree-server/variable_delta_codec.h>
 
 #include <gtest/gtest.h>
 
@@ -64,3 +66,59 @@ TEST_F(ClientAnyValueManagerTests, Construction)
     client_av_mgr.UpdateAnyValue(val_name, new_job_state);
   }
 }
+
+TEST_F(ClientAnyValueManagerTests, EntryBatches)
+{
+  ClientAnyValueManager client_av_mgr{m_test_job_info_io};
+  {
+    // Set Expectations on mock IJobInfoIO calls
+    {
+      InSequence seq;
+      EXPECT_CALL(m_test_job_info_io, Log(0, ""));
+      EXPECT_CALL(m_test_job_info_io, Message(""));
+      EXPECT_CALL(m_test_job_info_io, Log(1, "one"));
+      EXPECT_CALL(m_test_job_info_io, Log(2, "two"));
+      EXPECT_CALL(m_test_job_info_io, Message("hello"));
+      EXPECT_CALL(m_test_job_info_io, Log(3, "three"));
+    }
+    // Add log and message entry anyvalues
+    IAnyValueIO::NameAnyValueSet value_set;
+    std::string log_name = "prefix:" + kLogEntryId;
+    std::string msg_name = "prefix:" + kMessageEntryId;
+    value_set.emplace_back(log_name, kLogEntryAnyValue);
+    value_set.emplace_back(msg_name, kMessageEntryAnyValue);
+    client_av_mgr.AddAnyValues(value_set);
+
+    // Batches are unpacked into separate calls, single entries are still supported
+    std::vector<LogEntry> log_entries{{ 1u, 1, "one" }, { 2u, 2, "two" }};
+    client_av_mgr.UpdateAnyValue(log_name, EncodeLogEntryBatch(log_entries));
+    std::vector<MessageEntry> msg_entries{{ 1u, "hello" }};
+    client_av_mgr.UpdateAnyValue(msg_name, EncodeMessageEntryBatch(msg_entries));
+    client_av_mgr.UpdateAnyValue(log_name, EncodeLogEntry({ 3u, 3, "three" }));
+  }
+}
+
+TEST_F(ClientAnyValueManagerTests, VariableKeyframes)
+{
+  ClientAnyValueManager client_av_mgr{m_test_job_info_io};
+  VariableDeltaEncoder encoder{4};
+  sup::dto::AnyValue value_1 = {{ { "a", { sup::dto::SignedInteger32Type, 1 }} }};
+  sup::dto::AnyValue value_2 = {{ { "a", { sup::dto::SignedInteger32Type, 2 }} }};
+  auto keyframe = encoder.Encode(value_1, true);
+  auto delta = encoder.Encode(value_2, true);
+  {
+    // Set Expectations on mock IJobInfoIO calls: the delta is only decoded after its keyframe was
+    // received on the keyframe channel
+    EXPECT_CALL(m_test_job_info_io, VariableUpdated(3u, value_2, true));
+
+    // Add variable anyvalue: its keyframe channel is registered too
+    IAnyValueIO::NameAnyValueSet value_set;
+    auto var_name = GetVariablePVName("prefix:", 3u);
+    value_set.emplace_back(var_name, kVariableAnyValue);
+    EXPECT_TRUE(client_av_mgr.AddAnyValues(value_set));
+
+    // Late joining client: the variable channel only provides the last delta
+    EXPECT_TRUE(client_av_mgr.UpdateAnyValue(var_name, delta));
+    EXPECT_TRUE(client_av_mgr.UpdateAnyValue(GetVariableKeyframePVName(var_name), keyframe));
+  }
+}
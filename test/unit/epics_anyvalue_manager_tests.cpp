@@ -130,3 +130,79 @@ TEST_F(EPICSAnyValueManagerTest, ServeAndUpdate)
   // Check failure to update variables with unknown names
   EXPECT_FALSE(m_epics_av_manager.UpdateAnyValue("unknown", scalar));
 }
+
+TEST_F(EPICSAnyValueManagerTest, RemoveAnyValues)
+{
+  IAnyValueIO::NameAnyValueSet removable_set = {
+    { "removable0", scalar},
+    { "removable1", scalar}
+  };
+  ASSERT_TRUE(m_epics_av_manager.AddAnyValues(removable_set));
+  ASSERT_TRUE(m_epics_av_manager.AddAnyValues(value_set_2));
+  EXPECT_EQ(m_epics_av_manager.GetNumberOfAnyValues(), 4u);
+
+  // Values can only be removed together with the other values published by the same server
+  EXPECT_FALSE(m_epics_av_manager.RemoveAnyValues({ "removable0" }));
+  EXPECT_FALSE(m_epics_av_manager.RemoveAnyValues({ "removable0", "removable1", "unknown" }));
+  EXPECT_EQ(m_epics_av_manager.GetNumberOfAnyValues(), 4u);
+  EXPECT_TRUE(m_epics_av_manager.RemoveAnyValues({ "removable0", "removable1" }));
+  EXPECT_EQ(m_epics_av_manager.GetNumberOfAnyValues(), 2u);
+  EXPECT_FALSE(m_epics_av_manager.UpdateAnyValue("removable0", scalar));
+  EXPECT_TRUE(m_epics_av_manager.UpdateAnyValue("val2", scalar));
+
+  // Removed values can be served again
+  EXPECT_TRUE(m_epics_av_manager.AddAnyValues(removable_set));
+  EXPECT_TRUE(m_epics_av_manager.UpdateAnyValue("removable0", scalar));
+
+  // Input handlers are removed together with their input request and request list values
+  const std::string input_server_name = "EPICSAnyValueManagerTest:Input";
+  ASSERT_TRUE(m_epics_av_manager.AddInputHandler(input_server_name));
+  EXPECT_EQ(m_epics_av_manager.GetNumberOfAnyValues(), 6u);
+  EXPECT_TRUE(m_epics_av_manager.RemoveInputHandler(input_server_name));
+  EXPECT_EQ(m_epics_av_manager.GetNumberOfAnyValues(), 4u);
+  EXPECT_FALSE(m_epics_av_manager.RemoveInputHandler(input_server_name));
+  EXPECT_TRUE(m_epics_av_manager.AddInputHandler(input_server_name));
+}
+
+TEST_F(EPICSAnyValueManagerTest, RemoveAnyValuesSingleServer)
+{
+  EPICSServerConfig config{};
+  config.m_single_server = true;
+  EPICSAnyValueManager av_manager{config};
+  IAnyValueIO::NameAnyValueSet shared_set_1 = {
+    { "SingleServer:val0", scalar},
+    { "SingleServer:val1", scalar}
+  };
+  IAnyValueIO::NameAnyValueSet shared_set_2 = {
+    { "SingleServer:val2", scalar}
+  };
+  ASSERT_TRUE(av_manager.AddAnyValues(shared_set_1));
+  ASSERT_TRUE(av_manager.AddAnyValues(shared_set_2));
+  EXPECT_EQ(av_manager.GetNumberOfAnyValues(), 3u);
+
+  // Values of the single server can be removed individually
+  EXPECT_FALSE(av_manager.RemoveAnyValues({ "SingleServer:val0", "unknown" }));
+  EXPECT_TRUE(av_manager.RemoveAnyValues({ "SingleServer:val0" }));
+  EXPECT_EQ(av_manager.GetNumberOfAnyValues(), 2u);
+  EXPECT_FALSE(av_manager.UpdateAnyValue("SingleServer:val0", scalar));
+  EXPECT_TRUE(av_manager.UpdateAnyValue("SingleServer:val1", scalar));
+
+  // Removed values can be served again and reuse their PV
+  auto readded = scalar;
+  readded["value"].ConvertFrom(7);
+  EXPECT_TRUE(av_manager.AddAnyValues({{ "SingleServer:val0", readded }}));
+  EXPECT_EQ(av_manager.GetNumberOfAnyValues(), 3u);
+  auto pv_callback = [this](const sup::epics::PvAccessClientPV::ExtendedValue& val) {
+    if(val.connected)
+    {
+      auto [decoded, value] = Base64DecodeAnyValue(val.value);
+      if (decoded)
+      {
+        OnUpdateValue(value);
+      }
+    }
+  };
+  sup::epics::PvAccessClientPV val0_pv{"SingleServer:val0", pv_callback};
+  EXPECT_TRUE(val0_pv.WaitForValidValue(1.0));
+  EXPECT_TRUE(WaitForValue(readded, 1.0));
+}
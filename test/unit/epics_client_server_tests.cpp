@@ -35,6 +35,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 using ::testing::Exactly;
 
 using namespace sup::oac_tree_server;
@@ -49,6 +55,50 @@ IAnyValueIO::NameAnyValueSet value_set_1 = {
   { "val0", scalar},
   { "val1", scalar}
 };
+
+/**
+ * TestAnyValueManager that only answers user input requests when a given number of them wait for
+ * user input at the same time (or after a timeout).
+ */
+class ConcurrentInputAnyValueManager : public UnitTestHelper::TestAnyValueManager
+{
+public:
+  explicit ConcurrentInputAnyValueManager(sup::dto::uint32 n_concurrent)
+    : m_n_concurrent{n_concurrent}
+    , m_n_waiting{0}
+    , m_max_waiting{0}
+    , m_input_mtx{}
+    , m_input_cv{}
+  {}
+
+  UserInputReply GetUserInput(const std::string& input_server_name, sup::dto::uint64 id,
+                              const UserInputRequest& request) override
+  {
+    {
+      std::unique_lock<std::mutex> lk{m_input_mtx};
+      ++m_n_waiting;
+      m_max_waiting = std::max(m_max_waiting, m_n_waiting);
+      m_input_cv.notify_all();
+      (void)m_input_cv.wait_for(lk, std::chrono::seconds(5),
+                                [this]() { return m_max_waiting >= m_n_concurrent; });
+      --m_n_waiting;
+    }
+    return TestAnyValueManager::GetUserInput(input_server_name, id, request);
+  }
+
+  sup::dto::uint32 GetMaxWaiting() const
+  {
+    std::lock_guard<std::mutex> lk{m_input_mtx};
+    return m_max_waiting;
+  }
+
+private:
+  const sup::dto::uint32 m_n_concurrent;
+  sup::dto::uint32 m_n_waiting;
+  sup::dto::uint32 m_max_waiting;
+  mutable std::mutex m_input_mtx;
+  std::condition_variable m_input_cv;
+};
 }  // unnamed namespace
 
 class EPICSClientServerTest : public ::testing::Test
@@ -147,6 +197,32 @@ TEST_F(EPICSClientServerTest, GetUserInput)
   ASSERT_NO_THROW(m_epics_av_manager.Interrupt(input_server_name, 1u));
 }
 
+TEST_F(EPICSClientServerTest, ConcurrentUserInput)
+{
+  // Add input servers with a client that only answers when both requests wait at the same time
+  ConcurrentInputAnyValueManager av_manager{2};
+  EPICSIOClient epics_client{av_manager};
+  const std::string input_server_name = "TestInputServer04";
+  ASSERT_TRUE(m_epics_av_manager.AddInputHandler(input_server_name));
+  ASSERT_TRUE(epics_client.AddInputHandler(input_server_name));
+
+  // Request user input twice at the same time over the network
+  sup::dto::AnyValue value{ sup::dto::UnsignedInteger64Type, 42u };
+  auto user_reply = sup::oac_tree::CreateUserValueReply(true, value);
+  av_manager.SetUserInputReply(user_reply);
+  sup::dto::AnyValue empty{};
+  auto input_request = sup::oac_tree::CreateUserValueRequest(empty, "Provide a value");
+  auto get_input = [this, input_server_name, input_request](sup::dto::uint64 id) {
+    return m_epics_av_manager.GetUserInput(input_server_name, id, input_request);
+  };
+  auto first_reply = std::async(std::launch::async, get_input, 1u);
+  auto second_reply = std::async(std::launch::async, get_input, 2u);
+  EXPECT_EQ(first_reply.get(), user_reply);
+  EXPECT_EQ(second_reply.get(), user_reply);
+  EXPECT_EQ(av_manager.GetNbrInputRequests(), 2);
+  EXPECT_EQ(av_manager.GetMaxWaiting(), 2);
+}
+
 EPICSClientServerTest::EPICSClientServerTest()
   : m_test_av_manager{}
   , m_epics_client{m_test_av_manager}
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/epics/epics_server.h>
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/variable_delta_helper.h>
+
+#include <sup/epics/pv_access_client_pv.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree_server;
+
+class EPICSServerTest : public ::testing::Test
+{
+protected:
+  EPICSServerTest() = default;
+  virtual ~EPICSServerTest() = default;
+
+  EPICSServerConfig GetConfig()
+  {
+    EPICSServerConfig config{};
+    config.m_native_channels = true;
+    config.m_error_handler = [this](const std::string& message) {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      m_errors.push_back(message);
+      m_cv.notify_one();
+    };
+    return config;
+  }
+
+  bool WaitForErrors(std::size_t n_errors, double seconds)
+  {
+    auto duration = std::chrono::duration<double>(seconds);
+    std::unique_lock<std::mutex> lk{m_mtx};
+    auto pred = [this, n_errors](){
+      return m_errors.size() >= n_errors;
+    };
+    return m_cv.wait_for(lk, duration, pred);
+  }
+
+  std::vector<std::string> m_errors;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+};
+
+TEST_F(EPICSServerTest, ReportPublishErrors)
+{
+  const std::string prefix = "EPICSServerTest:Errors";
+  const auto instr_name = GetInstructionPVName(prefix, 0);
+  const sup::dto::AnyValue state = {{
+    { "value", {sup::dto::SignedInteger32Type, 0}}
+  }};
+  EPICSServer server{{{ instr_name, state }}, GetConfig()};
+
+  // A value of a different type cannot be published on a native channel and is reported
+  server.UpdateAnyValue(instr_name, sup::dto::AnyValue{ sup::dto::StringType, "wrong" });
+  ASSERT_TRUE(WaitForErrors(1, 1.0));
+  std::lock_guard<std::mutex> lk{m_mtx};
+  EXPECT_NE(m_errors.front().find(instr_name), std::string::npos);
+}
+
+TEST_F(EPICSServerTest, NativeVariables)
+{
+  const std::string prefix = "EPICSServerTest:Variables";
+  const auto var_name = GetVariablePVName(prefix, 0);
+  const auto delta_var_name = GetVariablePVName(prefix, 1);
+  EPICSServer server{{{ var_name, kVariableAnyValue }, { delta_var_name, kVariableAnyValue }},
+                     GetConfig()};
+  const sup::dto::AnyValue var_value = {{
+    { "setpoint", {sup::dto::Float64Type, 1.5}},
+    { "enabled", {sup::dto::BooleanType, true}}
+  }};
+
+  // The first update of a structured variable creates a native channel
+  server.UpdateAnyValue(var_name, EncodeVariableState(var_value, true));
+  sup::epics::PvAccessClientPV var_pv{var_name};
+  ASSERT_TRUE(var_pv.WaitForValidValue(2.0));
+  auto published = var_pv.GetValue();
+  EXPECT_FALSE(Base64DecodeAnyValue(published).first);
+  auto [decoded, value] = DecodeChannelValue(published);
+  ASSERT_TRUE(decoded);
+  ASSERT_TRUE(value.HasField(kVariableValueField));
+  EXPECT_EQ(value[kVariableValueField], var_value);
+
+  // Delta encoded variable updates are always base64 encoded
+  server.UpdateAnyValue(delta_var_name, EncodeVariableKeyframe(var_value, true, 1));
+  sup::epics::PvAccessClientPV delta_var_pv{delta_var_name};
+  ASSERT_TRUE(delta_var_pv.WaitForValidValue(2.0));
+  auto [base64_decoded, keyframe] = Base64DecodeAnyValue(delta_var_pv.GetValue());
+  ASSERT_TRUE(base64_decoded);
+  EXPECT_TRUE(IsSequencedVariableState(keyframe));
+  std::lock_guard<std::mutex> lk{m_mtx};
+  EXPECT_TRUE(m_errors.empty());
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/epics/epics_sharded_anyvalue_manager_registry.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace sup::oac_tree_server;
+
+namespace
+{
+const sup::dto::AnyValue scalar = {{
+  { "value", {sup::dto::SignedInteger32Type, 0}}
+}};
+
+IAnyValueIO::NameAnyValueSet value_set_1 = {
+  { "ShardedRegistryTest:val0", scalar},
+  { "ShardedRegistryTest:val1", scalar},
+  { "ShardedRegistryTest:val2", scalar}
+};
+
+IAnyValueIO::NameAnyValueSet value_set_2 = {
+  { "ShardedRegistryTest:val3", scalar}
+};
+}  // unnamed namespace
+
+class EPICSShardedAnyValueManagerRegistryTest : public ::testing::Test
+{
+protected:
+  EPICSShardedAnyValueManagerRegistryTest() = default;
+  virtual ~EPICSShardedAnyValueManagerRegistryTest() = default;
+};
+
+TEST_F(EPICSShardedAnyValueManagerRegistryTest, NumberOfShards)
+{
+  EPICSShardedAnyValueManagerRegistry registry{3};
+  EXPECT_EQ(registry.GetNumberOfShards(), 3);
+
+  // Zero shards defaults to the number of hardware threads
+  EPICSShardedAnyValueManagerRegistry default_registry{0};
+  auto n_threads = std::thread::hardware_concurrency();
+  auto expected_n_shards = n_threads > 0 ? n_threads : 1;
+  EXPECT_EQ(default_registry.GetNumberOfShards(), expected_n_shards);
+}
+
+TEST_F(EPICSShardedAnyValueManagerRegistryTest, AssignByLoad)
+{
+  EPICSShardedAnyValueManagerRegistry registry{2};
+
+  // Without any load, indices are assigned to the shard with the fewest indices
+  auto& mgr_0 = registry.GetAnyValueManager(0);
+  auto& mgr_1 = registry.GetAnyValueManager(1);
+  EXPECT_NE(&mgr_0, &mgr_1);
+
+  // The same index always returns the same shard
+  EXPECT_EQ(&registry.GetAnyValueManager(0), &mgr_0);
+  EXPECT_EQ(&registry.GetAnyValueManager(1), &mgr_1);
+
+  // New indices are assigned to the shard that publishes the least values
+  ASSERT_TRUE(mgr_0.AddAnyValues(value_set_1));
+  ASSERT_TRUE(mgr_1.AddAnyValues(value_set_2));
+  EXPECT_EQ(&registry.GetAnyValueManager(2), &mgr_1);
+  EXPECT_EQ(&registry.GetAnyValueManager(3), &mgr_1);
+  EXPECT_EQ(&registry.GetAnyValueManager(0), &mgr_0);
+}
@@ -0,0 +1,249 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "unit_test_helper.h"
+
+#include <sup/oac-tree-server/automation_server.h>
+#include <sup/oac-tree-server/exceptions.h>
+
+#include <sup/oac-tree/sequence_parser.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace sup::oac_tree_server;
+
+namespace
+{
+/**
+ * @brief Job manager that only implements the pure virtual methods of IJobManager by forwarding
+ * them, so that the default implementations of the other methods are used.
+ */
+class MinimalJobManager : public IJobManager
+{
+public:
+  explicit MinimalJobManager(IJobManager& job_manager)
+    : m_job_manager{job_manager}
+  {}
+  ~MinimalJobManager() override = default;
+
+  std::string GetServerPrefix() const override
+  {
+    return m_job_manager.GetServerPrefix();
+  }
+  sup::dto::uint32 GetNumberOfJobs() const override
+  {
+    return m_job_manager.GetNumberOfJobs();
+  }
+  sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32 job_idx) const override
+  {
+    return m_job_manager.GetJobInfo(job_idx);
+  }
+  void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
+                      bool breakpoint_active) override
+  {
+    m_job_manager.EditBreakpoint(job_idx, instr_idx, breakpoint_active);
+  }
+  void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) override
+  {
+    m_job_manager.SendJobCommand(job_idx, command);
+  }
+
+private:
+  IJobManager& m_job_manager;
+};
+
+/**
+ * @brief Job manager that supports concurrent calls and whose SendJobCommand only succeeds when
+ * a given number of calls are in progress at the same time.
+ */
+class ConcurrentJobManager : public IJobManager
+{
+public:
+  explicit ConcurrentJobManager(sup::dto::uint32 n_jobs)
+    : m_n_jobs{n_jobs}
+    , m_mtx{}
+    , m_cv{}
+    , m_n_calls{0}
+  {}
+  ~ConcurrentJobManager() override = default;
+
+  std::string GetServerPrefix() const override { return "ConcurrentJobManager"; }
+  sup::dto::uint32 GetNumberOfJobs() const override { return m_n_jobs; }
+  sup::oac_tree::JobInfo GetJobInfo(sup::dto::uint32) const override
+  {
+    throw InvalidOperationException("ConcurrentJobManager::GetJobInfo(): not supported");
+  }
+  void EditBreakpoint(sup::dto::uint32, sup::dto::uint32, bool) override {}
+  void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand) override
+  {
+    if (job_idx >= m_n_jobs)
+    {
+      throw InvalidOperationException("ConcurrentJobManager::SendJobCommand(): unknown job");
+    }
+    std::unique_lock<std::mutex> lk{m_mtx};
+    ++m_n_calls;
+    m_cv.notify_all();
+    if (!m_cv.wait_for(lk, std::chrono::seconds(1), [this]{ return m_n_calls >= m_n_jobs; }))
+    {
+      throw InvalidOperationException("ConcurrentJobManager::SendJobCommand(): timeout");
+    }
+  }
+  bool SupportsConcurrentCalls() const override { return true; }
+
+private:
+  const sup::dto::uint32 m_n_jobs;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+  sup::dto::uint32 m_n_calls;
+};
+}  // unnamed namespace
+
+class IJobManagerTest : public ::testing::Test
+{
+protected:
+  IJobManagerTest() = default;
+  virtual ~IJobManagerTest() = default;
+
+  UnitTestHelper::TestAnyValueManagerRegistry m_test_av_mgr_registry;
+};
+
+TEST_F(IJobManagerTest, DefaultImplementations)
+{
+  const std::string prefix = "IJobManagerTest:Defaults";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 1u);
+  auto_server.RemoveJob(1);
+  MinimalJobManager job_manager{auto_server};
+
+  // Number of instructions is retrieved from the job information
+  auto job_info = job_manager.GetJobInfo(0);
+  const auto n_instr = job_info.GetNumberOfInstructions();
+  EXPECT_EQ(job_manager.GetNumberOfInstructions(0), n_instr);
+
+  // No entries are retained
+  EXPECT_EQ(job_manager.GetOutputEntries(0, { 0, 0, 0 }), OutputEntries{});
+
+  // Concurrent calls are only supported when declared explicitly
+  EXPECT_FALSE(job_manager.SupportsConcurrentCalls());
+  EXPECT_TRUE(auto_server.SupportsConcurrentCalls());
+}
+
+TEST_F(IJobManagerTest, DefaultGetAllJobInfos)
+{
+  const std::string prefix = "IJobManagerTest:DefaultGetAllJobInfos";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 1u);
+  auto_server.RemoveJob(1);
+  MinimalJobManager job_manager{auto_server};
+
+  // Job information is retrieved from the single job calls, skipping the removed job
+  auto job_info = job_manager.GetJobInfo(0);
+  auto all_infos = job_manager.GetAllJobInfos({});
+  EXPECT_EQ(all_infos.m_server_prefix, prefix);
+  EXPECT_EQ(all_infos.m_n_jobs, 2u);
+  ASSERT_EQ(all_infos.m_job_infos.size(), 1u);
+  EXPECT_EQ(all_infos.m_job_infos[0].GetProcedureName(), job_info.GetProcedureName());
+  EXPECT_EQ(all_infos.m_job_indices, std::vector<sup::dto::uint32>{ 0u });
+
+  // Explicitly requested jobs are returned in the requested order, or the call fails
+  all_infos = job_manager.GetAllJobInfos({ 0u, 0u });
+  EXPECT_EQ(all_infos.m_job_infos.size(), 2u);
+  EXPECT_EQ(all_infos.m_job_indices, std::vector<sup::dto::uint32>({ 0u, 0u }));
+  EXPECT_THROW(job_manager.GetAllJobInfos({ 0u, 1u }), InvalidOperationException);
+}
+
+TEST_F(IJobManagerTest, DefaultEditBreakpoints)
+{
+  const std::string prefix = "IJobManagerTest:DefaultEditBreakpoints";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  MinimalJobManager job_manager{auto_server};
+  const auto n_instr = job_manager.GetNumberOfInstructions(0);
+
+  // Breakpoints are only edited when all indices are valid
+  EXPECT_NO_THROW(job_manager.EditBreakpoints(0, {}, true));
+  EXPECT_NO_THROW(job_manager.EditBreakpoints(0, { 0u }, true));
+  EXPECT_NO_THROW(job_manager.EditBreakpoints(0, { 0u }, false));
+  EXPECT_THROW(job_manager.EditBreakpoints(0, { 0u, n_instr }, true), InvalidOperationException);
+  EXPECT_THROW(job_manager.EditBreakpoints(1, { 0u }, true), InvalidOperationException);
+}
+
+TEST_F(IJobManagerTest, DefaultSendJobCommands)
+{
+  using sup::oac_tree::JobCommand;
+  const std::string prefix = "IJobManagerTest:DefaultSendJobCommands";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 1u);
+  auto_server.RemoveJob(1);
+  MinimalJobManager job_manager{auto_server};
+
+  // Commands are sent to each job one after the other and failures are reported per job
+  std::vector<bool> expected_results{ true, false };
+  EXPECT_EQ(job_manager.SendJobCommands({}, JobCommand::kHalt), expected_results);
+  expected_results = { false, true };
+  EXPECT_EQ(job_manager.SendJobCommands({ 5u, 0u }, JobCommand::kHalt), expected_results);
+}
+
+TEST_F(IJobManagerTest, DefaultSendJobCommandsInParallel)
+{
+  using sup::oac_tree::JobCommand;
+  // Each command only succeeds when both jobs receive it at the same time, which requires at least
+  // two hardware threads. Otherwise, the first command times out waiting for the second one.
+  ConcurrentJobManager job_manager{2};
+  std::vector<bool> expected_results{ true, true };
+  if (std::thread::hardware_concurrency() < 2)
+  {
+    expected_results = { false, true };
+  }
+  EXPECT_EQ(job_manager.SendJobCommands({}, JobCommand::kHalt), expected_results);
+}
+
+TEST_F(IJobManagerTest, DefaultGetJobGenerations)
+{
+  const std::string prefix = "IJobManagerTest:DefaultGetJobGenerations";
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  AutomationServer auto_server{prefix, m_test_av_mgr_registry};
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 0u);
+  EXPECT_EQ(auto_server.AddJob(sup::oac_tree::ParseProcedureString(procedure_string)), 1u);
+  auto_server.RemoveJob(1);
+  MinimalJobManager job_manager{auto_server};
+
+  // All generations are unknown, including those of removed jobs, while the server issues them
+  std::vector<sup::dto::uint64> unknown_generations{ 0u, 0u };
+  EXPECT_EQ(job_manager.GetJobGenerations(), unknown_generations);
+  auto server_generations = auto_server.GetJobGenerations();
+  ASSERT_EQ(server_generations.size(), 2u);
+  EXPECT_NE(server_generations[0], 0u);
+  EXPECT_EQ(server_generations[1], 0u);
+}
@@ -89,6 +89,43 @@ TEST_F(InputProtocolClientServerTest, MultiThreadedInterrupted)
   halt.store(true);
 }
 
+TEST_F(InputProtocolClientServerTest, PendingRequests)
+{
+  auto request = sup::oac_tree::CreateUserValueRequest(
+    sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, 0u }, "Give a number");
+  sup::oac_tree::UserInputReply reply{ sup::oac_tree::InputRequestType::kUserValue, true,
+                                       { sup::dto::UnsignedInteger32Type, 42u }};
+  sup::dto::uint64 id{77};
+
+  // No pending requests: the call returns after the timeout
+  auto [success_0, count_0, pending_0] = m_client.GetPendingRequests(0, 10);
+  EXPECT_TRUE(success_0);
+  EXPECT_TRUE(pending_0.empty());
+
+  // A waiting client receives a new request and replies over the same protocol
+  auto client_func = [this, count_0 = count_0, reply]() {
+    auto [success, count, pending] = m_client.GetPendingRequests(count_0, 5000);
+    if (!success || pending.size() != 1)
+    {
+      return false;
+    }
+    return m_client.SetClientReply(pending.begin()->first, reply);
+  };
+  auto client_future = std::async(std::launch::async, client_func);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  m_request_server.AddRequest(id, request);
+  auto [retrieved, value] = m_request_server.WaitForReply(id);
+  EXPECT_TRUE(retrieved);
+  EXPECT_EQ(value, reply);
+  EXPECT_TRUE(client_future.get());
+
+  // Replied requests are no longer pending
+  auto [success_1, count_1, pending_1] = m_client.GetPendingRequests(0, 10);
+  EXPECT_TRUE(success_1);
+  EXPECT_NE(count_1, count_0);
+  EXPECT_TRUE(pending_1.empty());
+}
+
 InputProtocolClientServerTest::InputProtocolClientServerTest()
   : m_request_server{}
   , m_server{m_request_server}
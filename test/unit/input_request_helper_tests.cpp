@@ -186,3 +186,30 @@ TEST_F(InputRequestHelperTest, DecodeInputRequest)
     EXPECT_EQ(std::get<2>(decoded), kInvalidUserInputRequest);
   }
 }
+
+TEST_F(InputRequestHelperTest, EncodeInputRequestList)
+{
+  std::map<sup::dto::uint64, UserInputRequest> requests;
+  sup::dto::AnyValue value{ sup::dto::UnsignedInteger32Type, 42u };
+  (void)requests.emplace(3u, sup::oac_tree::CreateUserValueRequest(value, "Give a number"));
+  (void)requests.emplace(7u, sup::oac_tree::CreateUserValueRequest(value, "Give another number"));
+
+  // Encode and decode
+  auto encoded = EncodeInputRequestList(requests);
+  EXPECT_EQ(encoded.NumberOfMembers(), 2u);
+  auto [decoded_ok, decoded] = DecodeInputRequestList(encoded);
+  EXPECT_TRUE(decoded_ok);
+  EXPECT_EQ(decoded, requests);
+
+  // Empty list
+  auto [empty_ok, empty_list] = DecodeInputRequestList(kInputRequestListAnyValue);
+  EXPECT_TRUE(empty_ok);
+  EXPECT_TRUE(empty_list.empty());
+
+  // Unable to decode
+  sup::dto::AnyValue scalar{ sup::dto::UnsignedInteger32Type, 1u };
+  EXPECT_FALSE(DecodeInputRequestList(scalar).first);
+  auto invalid_list = sup::dto::EmptyStruct();
+  (void)invalid_list.AddMember("q0", scalar);
+  EXPECT_FALSE(DecodeInputRequestList(invalid_list).first);
+}
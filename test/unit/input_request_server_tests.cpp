@@ -32,6 +32,7 @@ using namespace sup::oac_tree_server;
 using sup::oac_tree::kInvalidUserInputReply;
 using sup::oac_tree::InputRequestType;
 using sup::oac_tree::UserInputReply;
+using sup::oac_tree::UserInputRequest;
 
 class InputRequestServerTest : public ::testing::Test
 {
@@ -137,3 +138,150 @@ TEST_F(InputRequestServerTest, MultiThreaded)
     EXPECT_EQ(value, kInvalidUserInputReply);
   }
 }
+
+TEST_F(InputRequestServerTest, MultipleRequests)
+{
+  InputRequestServer server{};
+  UserInputReply reply_1{ InputRequestType::kUserValue, true,
+                          { sup::dto::UnsignedInteger32Type, 1u }};
+  UserInputReply reply_2{ InputRequestType::kUserValue, true,
+                          { sup::dto::UnsignedInteger32Type, 2u }};
+
+  auto request = sup::oac_tree::CreateUserValueRequest(
+    sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, 0u }, "Give a number");
+
+  // Added requests do not discard each other and can be replied to in any order:
+  server.AddRequest(1u, request);
+  server.AddRequest(2u, request);
+  std::promise<void> ready;
+  auto ready_future = ready.get_future();
+  auto waiter = [&server, &ready] {
+    ready.set_value();
+    return server.WaitForReply(1u);
+  };
+  auto wait_future = std::async(std::launch::async, waiter);
+  ready_future.get();
+  EXPECT_TRUE(server.SetClientReply(2u, reply_2));
+  auto [retrieved2, value2] = server.WaitForReply(2u);
+  EXPECT_TRUE(retrieved2);
+  EXPECT_EQ(value2, reply_2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(server.SetClientReply(1u, reply_1));
+  auto [retrieved1, value1] = wait_future.get();
+  EXPECT_TRUE(retrieved1);
+  EXPECT_EQ(value1, reply_1);
+
+  // Interrupting one request leaves the others outstanding:
+  server.AddRequest(3u, request);
+  server.AddRequest(4u, request);
+  server.Interrupt(3u);
+  auto [retrieved3, value3] = server.WaitForReply(3u);
+  EXPECT_FALSE(retrieved3);
+  EXPECT_EQ(value3, kInvalidUserInputReply);
+  EXPECT_TRUE(server.SetClientReply(4u, reply_1));
+  auto [retrieved4, value4] = server.WaitForReply(4u);
+  EXPECT_TRUE(retrieved4);
+  EXPECT_EQ(value4, reply_1);
+
+  // A new request started with InitNewRequest discards the others, waking up their waiters:
+  server.AddRequest(5u, request);
+  std::promise<void> ready_discard;
+  auto ready_discard_future = ready_discard.get_future();
+  auto discarded_waiter = [&server, &ready_discard] {
+    ready_discard.set_value();
+    return server.WaitForReply(5u);
+  };
+  auto discarded_future = std::async(std::launch::async, discarded_waiter);
+  ready_discard_future.get();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  server.InitNewRequest(6u);
+  auto [retrieved5, value5] = discarded_future.get();
+  EXPECT_FALSE(retrieved5);
+  EXPECT_EQ(value5, kInvalidUserInputReply);
+  EXPECT_FALSE(server.SetClientReply(5u, reply_1));
+  EXPECT_TRUE(server.SetClientReply(6u, reply_2));
+}
+
+TEST_F(InputRequestServerTest, PendingRequests)
+{
+  InputRequestServer server{};
+  auto request_1 = sup::oac_tree::CreateUserValueRequest(
+    sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, 0u }, "Give a number");
+  auto request_2 = sup::oac_tree::CreateUserValueRequest(
+    sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, 0u }, "Give another number");
+  UserInputReply reply{ InputRequestType::kUserValue, true,
+                        { sup::dto::UnsignedInteger32Type, 42u }};
+
+  // Initially there are no pending requests and waiting for changes times out:
+  EXPECT_TRUE(server.GetPendingRequests().empty());
+  auto [count_0, pending_0] = server.WaitForPendingRequests(0, std::chrono::milliseconds(10));
+  EXPECT_EQ(count_0, 0);
+  EXPECT_TRUE(pending_0.empty());
+
+  // Requests without UserInputRequest are not reported:
+  server.InitNewRequest(1u);
+  EXPECT_TRUE(server.GetPendingRequests().empty());
+
+  // Added requests are reported until they are replied to or interrupted:
+  server.AddRequest(2u, request_1);
+  server.AddRequest(3u, request_2);
+  auto [count_1, pending_1] = server.WaitForPendingRequests(0, std::chrono::milliseconds(10));
+  EXPECT_NE(count_1, 0);
+  std::map<sup::dto::uint64, UserInputRequest> expected{ { 2u, request_1 }, { 3u, request_2 } };
+  EXPECT_EQ(pending_1, expected);
+  EXPECT_TRUE(server.SetClientReply(2u, reply));
+  server.Interrupt(3u);
+  EXPECT_TRUE(server.GetPendingRequests().empty());
+
+  // A waiting client is woken up when a new request is added:
+  auto [count_2, pending_2] = server.WaitForPendingRequests(0, std::chrono::milliseconds(10));
+  EXPECT_TRUE(pending_2.empty());
+  std::promise<void> ready;
+  auto ready_future = ready.get_future();
+  auto waiter = [&server, &ready, count_2 = count_2] {
+    ready.set_value();
+    return server.WaitForPendingRequests(count_2, std::chrono::seconds(10));
+  };
+  auto wait_future = std::async(std::launch::async, waiter);
+  ready_future.get();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  server.AddRequest(4u, request_1);
+  auto [count_3, pending_3] = wait_future.get();
+  EXPECT_NE(count_3, count_2);
+  ASSERT_EQ(pending_3.size(), 1u);
+  EXPECT_EQ(pending_3.begin()->first, 4u);
+}
+
+TEST_F(InputRequestServerTest, Deadline)
+{
+  InputRequestServer server{};
+  auto request = sup::oac_tree::CreateUserValueRequest(
+    sup::dto::AnyValue{ sup::dto::UnsignedInteger32Type, 0u }, "Give a number");
+  UserInputReply reply{ InputRequestType::kUserValue, true,
+                        { sup::dto::UnsignedInteger32Type, 42u }};
+
+  // Reply before the deadline:
+  server.AddRequest(1u, request);
+  EXPECT_TRUE(server.SetClientReply(1u, reply));
+  auto [status_1, value_1] =
+    server.WaitForReplyUntil(1u, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  EXPECT_EQ(status_1, UserInputStatus::kReplied);
+  EXPECT_EQ(value_1, reply);
+
+  // Interrupted before the deadline:
+  server.AddRequest(2u, request);
+  server.Interrupt(2u);
+  auto [status_2, value_2] =
+    server.WaitForReplyUntil(2u, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  EXPECT_EQ(status_2, UserInputStatus::kInterrupted);
+  EXPECT_EQ(value_2, kInvalidUserInputReply);
+
+  // No reply before the deadline abandons the request:
+  server.AddRequest(3u, request);
+  auto [status_3, value_3] =
+    server.WaitForReplyUntil(3u, std::chrono::steady_clock::now() + std::chrono::milliseconds(50));
+  EXPECT_EQ(status_3, UserInputStatus::kTimedOut);
+  EXPECT_EQ(value_3, kInvalidUserInputReply);
+  EXPECT_TRUE(server.GetPendingRequests().empty());
+  EXPECT_FALSE(server.SetClientReply(3u, reply));
+}
@@ -22,6 +22,7 @@
 
 #include <sup/oac-tree-server/control_protocol_server.h>
 #include <sup/oac-tree-server/epics_config_utils.h>
+#include <sup/oac-tree-server/exceptions.h>
 #include <sup/oac-tree-server/info_protocol_server.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
@@ -73,16 +74,44 @@ public:
     return m_job_manager->GetJobInfo(job_idx);
   }
 
+  JobManagerInfo GetAllJobInfos(const std::vector<sup::dto::uint32>& job_indices) const override
+  {
+    return m_job_manager->GetAllJobInfos(job_indices);
+  }
+
+  std::vector<sup::dto::uint64> GetJobGenerations() const override
+  {
+    return m_job_manager->GetJobGenerations();
+  }
+
+  OutputEntries GetOutputEntries(sup::dto::uint32 job_idx,
+                                 const OutputEntryIndices& last_indices) const override
+  {
+    return m_job_manager->GetOutputEntries(job_idx, last_indices);
+  }
+
   void EditBreakpoint(sup::dto::uint32 job_idx, sup::dto::uint32 instr_idx,
                       bool breakpoint_active) override
   {
     m_job_manager->EditBreakpoint(job_idx, instr_idx, breakpoint_active);
   }
 
+  void EditBreakpoints(sup::dto::uint32 job_idx, const std::set<sup::dto::uint32>& instr_indices,
+                       bool breakpoint_active) override
+  {
+    m_job_manager->EditBreakpoints(job_idx, instr_indices, breakpoint_active);
+  }
+
   void SendJobCommand(sup::dto::uint32 job_idx, sup::oac_tree::JobCommand command) override
   {
     m_job_manager->SendJobCommand(job_idx, command);
   }
+
+  std::vector<bool> SendJobCommands(const std::vector<sup::dto::uint32>& job_indices,
+                                    sup::oac_tree::JobCommand command) override
+  {
+    return m_job_manager->SendJobCommands(job_indices, command);
+  }
 private:
   IJobManager* m_job_manager;
 };
@@ -141,12 +170,132 @@ TEST_F(JobManagerClientServerStackTest, GetJobInfo)
   // Create stack and test
   const sup::dto::uint32 n_jobs = 42u;
   const sup::dto::uint32 job_id = 32u;
+  const std::vector<sup::dto::uint64> unknown_generations(n_jobs, 0u);
+  EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(1))
+    .WillOnce(Return(unknown_generations));
   EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
   EXPECT_CALL(m_job_manager, GetJobInfo(job_id)).Times(Exactly(1)).WillOnce(Return(job_info));
   auto job_info_reply = m_client_job_manager->GetJobInfo(job_id);
   EXPECT_EQ(job_info_reply, job_info);
 }
 
+TEST_F(JobManagerClientServerStackTest, GetAllJobInfos)
+{
+  // Test GetAllJobInfos over the whole EPICS stack
+
+  // Build JobInfo
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kWorkspaceSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc.get(), nullptr);
+  auto root = proc->RootInstruction();
+  sup::oac_tree::InstructionMap instr_map{root};
+  auto job_info = sup::oac_tree::utils::CreateJobInfo(*proc, instr_map);
+
+  const std::string server_prefix = "AllJobInfosServerPrefix";
+  const sup::dto::uint32 n_jobs = 42u;
+  const std::vector<sup::dto::uint32> job_ids{ 3u, 32u };
+  JobManagerInfo job_manager_info{ server_prefix, n_jobs, { job_info, job_info }, job_ids };
+  const std::vector<sup::dto::uint64> unknown_generations(n_jobs, 0u);
+  EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(3))
+    .WillRepeatedly(Return(unknown_generations));
+  {
+    // Selection of jobs
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetAllJobInfos(job_ids)).Times(Exactly(1))
+      .WillOnce(Return(job_manager_info));
+    auto reply = m_client_job_manager->GetAllJobInfos(job_ids);
+    EXPECT_EQ(reply.m_server_prefix, server_prefix);
+    EXPECT_EQ(reply.m_n_jobs, n_jobs);
+    ASSERT_EQ(reply.m_job_infos.size(), 2u);
+    EXPECT_EQ(reply.m_job_infos[1], job_info);
+    EXPECT_EQ(reply.m_job_indices, job_ids);
+  }
+  {
+    // All jobs are requested with an empty list; the indices identify the returned jobs when some
+    // were removed
+    const std::vector<sup::dto::uint32> no_job_ids{};
+    const std::vector<sup::dto::uint32> remaining_job_ids{ 0u, 2u };
+    JobManagerInfo remaining_info{ server_prefix, n_jobs, { job_info, job_info },
+                                   remaining_job_ids };
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetAllJobInfos(no_job_ids)).Times(Exactly(1))
+      .WillOnce(Return(remaining_info));
+    auto reply = m_client_job_manager->GetAllJobInfos(no_job_ids);
+    EXPECT_EQ(reply.m_job_infos.size(), 2u);
+    EXPECT_EQ(reply.m_job_indices, remaining_job_ids);
+  }
+  {
+    // Unknown job
+    const std::vector<sup::dto::uint32> unknown_job_ids{ 3u, n_jobs };
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_THROW(m_client_job_manager->GetAllJobInfos(unknown_job_ids),
+                 InvalidOperationException);
+  }
+}
+
+TEST_F(JobManagerClientServerStackTest, JobInfoCache)
+{
+  // Build JobInfo
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kWorkspaceSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc.get(), nullptr);
+  auto root = proc->RootInstruction();
+  sup::oac_tree::InstructionMap instr_map{root};
+  auto job_info = sup::oac_tree::utils::CreateJobInfo(*proc, instr_map);
+
+  const std::string server_prefix = "JobInfoCacheServerPrefix";
+  const sup::dto::uint32 n_jobs = 2u;
+  const std::vector<sup::dto::uint64> generations{ 11u, 12u };
+  JobManagerInfo job_manager_info{ server_prefix, n_jobs, { job_info, job_info }, { 0u, 1u }};
+  {
+    // First request retrieves the full JobInfo objects
+    EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(1))
+      .WillOnce(Return(generations));
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetAllJobInfos(std::vector<sup::dto::uint32>{})).Times(Exactly(1))
+      .WillOnce(Return(job_manager_info));
+    auto reply = m_client_job_manager->GetAllJobInfos({});
+    EXPECT_EQ(reply.m_job_infos.size(), 2u);
+  }
+  {
+    // Unchanged generations only require the generation check
+    EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(2))
+      .WillRepeatedly(Return(generations));
+    auto reply = m_client_job_manager->GetAllJobInfos({ 1u });
+    EXPECT_EQ(reply.m_server_prefix, server_prefix);
+    EXPECT_EQ(reply.m_n_jobs, n_jobs);
+    ASSERT_EQ(reply.m_job_infos.size(), 1u);
+    EXPECT_EQ(reply.m_job_infos[0], job_info);
+    EXPECT_EQ(m_client_job_manager->GetJobInfo(0u), job_info);
+  }
+  {
+    // A changed generation invalidates the cached JobInfo
+    const std::vector<sup::dto::uint64> new_generations{ 11u, 13u };
+    EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(1))
+      .WillOnce(Return(new_generations));
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetJobInfo(1u)).Times(Exactly(1)).WillOnce(Return(job_info));
+    EXPECT_EQ(m_client_job_manager->GetJobInfo(1u), job_info);
+  }
+}
+
+TEST_F(JobManagerClientServerStackTest, GetOutputEntries)
+{
+  // Test GetOutputEntries over the whole EPICS stack
+  OutputEntries output_entries{};
+  output_entries.m_log_entries.push_back({ 3u, 2, "log" });
+  output_entries.m_message_entries.push_back({ 7u, "message" });
+  output_entries.m_output_value_entries.push_back({ 1u, "flag", { sup::dto::BooleanType, true }});
+  const OutputEntryIndices last_indices{ 2u, 6u, 0u };
+  const sup::dto::uint32 n_jobs = 42u;
+  const sup::dto::uint32 job_id = 32u;
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetOutputEntries(job_id, last_indices)).Times(Exactly(1))
+    .WillOnce(Return(output_entries));
+  auto output_entries_reply = m_client_job_manager->GetOutputEntries(job_id, last_indices);
+  EXPECT_EQ(output_entries_reply, output_entries);
+}
+
 TEST_F(JobManagerClientServerStackTest, EditBreakpoint)
 {
   // Build JobInfo
@@ -167,6 +316,34 @@ TEST_F(JobManagerClientServerStackTest, EditBreakpoint)
   m_client_job_manager->EditBreakpoint(job_id, instr_id, true);
 }
 
+TEST_F(JobManagerClientServerStackTest, EditBreakpoints)
+{
+  // Build JobInfo
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kWorkspaceSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc.get(), nullptr);
+  auto root = proc->RootInstruction();
+  sup::oac_tree::InstructionMap instr_map{root};
+  auto job_info = sup::oac_tree::utils::CreateJobInfo(*proc, instr_map);
+  const auto n_instr = job_info.GetNumberOfInstructions();
+
+  // Test EditBreakpoints over the whole EPICS stack
+  const sup::dto::uint32 n_jobs = 42u;
+  const sup::dto::uint32 job_id = 32u;
+  const std::set<sup::dto::uint32> instr_ids{0u, 1u};
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetJobInfo(job_id)).Times(Exactly(1)).WillOnce(Return(job_info));
+  EXPECT_CALL(m_job_manager, EditBreakpoints(job_id, instr_ids, false)).Times(Exactly(1));
+  m_client_job_manager->EditBreakpoints(job_id, instr_ids, false);
+
+  // Invalid instruction index does not edit any breakpoint
+  const std::set<sup::dto::uint32> invalid_instr_ids{0u, n_instr};
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetJobInfo(job_id)).Times(Exactly(1)).WillOnce(Return(job_info));
+  EXPECT_THROW(m_client_job_manager->EditBreakpoints(job_id, invalid_instr_ids, true),
+               InvalidOperationException);
+}
+
 TEST_F(JobManagerClientServerStackTest, SendJobCommand)
 {
   // Test SendJobCommand over the whole EPICS stack
@@ -178,6 +355,30 @@ TEST_F(JobManagerClientServerStackTest, SendJobCommand)
   m_client_job_manager->SendJobCommand(job_id, command);
 }
 
+TEST_F(JobManagerClientServerStackTest, SendJobCommands)
+{
+  // Test SendJobCommands over the whole EPICS stack
+  const sup::dto::uint32 n_jobs = 42u;
+  const std::vector<sup::dto::uint32> job_ids{3u, 32u, 7u};
+  const std::vector<bool> results{true, false, true};
+  auto command = sup::oac_tree::JobCommand::kHalt;
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, SendJobCommands(job_ids, command)).Times(Exactly(1))
+    .WillOnce(Return(results));
+  EXPECT_EQ(m_client_job_manager->SendJobCommands(job_ids, command), results);
+
+  // Empty list of job indices addresses all jobs
+  const std::vector<bool> all_results(n_jobs, true);
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, SendJobCommands(std::vector<sup::dto::uint32>{}, command))
+    .Times(Exactly(1)).WillOnce(Return(all_results));
+  EXPECT_EQ(m_client_job_manager->SendJobCommands({}, command), all_results);
+
+  // Unknown job index
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_THROW(m_client_job_manager->SendJobCommands({3u, n_jobs}, command), InvalidOperationException);
+}
+
 JobManagerClientServerStackTest::JobManagerClientServerStackTest()
   : m_job_manager{}
   , m_client_job_manager{utils::CreateEPICSJobManager(kTestAutomationServiceName)}
@@ -22,6 +22,9 @@
 
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
+#include <sup/protocol/function_protocol.h>
+#include <sup/protocol/function_protocol_pack.h>
+
 #include <gtest/gtest.h>
 
 using namespace sup::oac_tree_server;
@@ -41,6 +44,9 @@ TEST_F(SupAutoProtocolTest, PVNames)
   EXPECT_EQ(GetJobStatePVName(prefix), prefix + kJobStateId);
   EXPECT_EQ(GetInstructionPVName(prefix, 1729u), prefix + kInstructionId + "1729");
   EXPECT_EQ(GetVariablePVName(prefix, 42u), prefix + kVariableId + "42");
+  EXPECT_EQ(GetVariableKeyframePVName(GetVariablePVName(prefix, 42u)),
+            prefix + kVariableKeyframeId + "42");
+  EXPECT_TRUE(GetVariableKeyframePVName(GetInstructionPVName(prefix, 42u)).empty());
 }
 
 TEST_F(SupAutoProtocolTest, JobStateValue)
@@ -237,6 +243,13 @@ TEST_F(SupAutoProtocolTest, ParseValueName)
     EXPECT_EQ(info.val_type, ValueNameType::kVariable);
     EXPECT_EQ(info.idx, max_32);
   }
+  {
+    // Variable keyframe field correctly parsed
+    std::string val_name = "prefix:" + kVariableKeyframeId + "42";
+    auto info = ParseValueName(val_name);
+    EXPECT_EQ(info.val_type, ValueNameType::kVariableKeyframe);
+    EXPECT_EQ(info.idx, 42);
+  }
   {
     // Variable state field without prefix is parsed as unknown
     std::string val_name = kVariableId + "42";
@@ -274,6 +287,84 @@ TEST_F(SupAutoProtocolTest, ParseValueName)
   }
 }
 
+TEST_F(SupAutoProtocolTest, ExtractJobIndices)
+{
+  const sup::dto::uint32 n_jobs = 5u;
+  {
+    // No indices requests all jobs
+    auto input = sup::protocol::FunctionProtocolInput(kGetAllJobInfosFunctionName);
+    std::vector<sup::dto::uint32> job_indices{ 42u };
+    EXPECT_EQ(ExtractJobIndices(input, n_jobs, job_indices), sup::protocol::Success);
+    EXPECT_TRUE(job_indices.empty());
+  }
+  {
+    // Valid indices
+    auto input = sup::protocol::FunctionProtocolInput(kGetAllJobInfosFunctionName);
+    const std::vector<sup::dto::uint32> requested{ 4u, 0u, 2u };
+    sup::protocol::FunctionProtocolPack(input, kJobIndicesFieldName, EncodeJobIndices(requested));
+    std::vector<sup::dto::uint32> job_indices{};
+    EXPECT_EQ(ExtractJobIndices(input, n_jobs, job_indices), sup::protocol::Success);
+    EXPECT_EQ(job_indices, requested);
+  }
+  {
+    // Index out of bounds
+    auto input = sup::protocol::FunctionProtocolInput(kGetAllJobInfosFunctionName);
+    sup::protocol::FunctionProtocolPack(input, kJobIndicesFieldName, EncodeJobIndices({ 1u, 5u }));
+    std::vector<sup::dto::uint32> job_indices{};
+    EXPECT_EQ(ExtractJobIndices(input, n_jobs, job_indices), UnknownJob);
+  }
+  {
+    // Wrong encoding
+    auto input = sup::protocol::FunctionProtocolInput(kGetAllJobInfosFunctionName);
+    sup::protocol::FunctionProtocolPack(input, kJobIndicesFieldName,
+                                        sup::dto::AnyValue{sup::dto::StringType, "not a list"});
+    std::vector<sup::dto::uint32> job_indices{};
+    EXPECT_EQ(ExtractJobIndices(input, n_jobs, job_indices),
+              sup::protocol::ServerProtocolDecodingError);
+  }
+}
+
+TEST_F(SupAutoProtocolTest, DecodeJobIndices)
+{
+  const std::vector<sup::dto::uint32> job_indices{ 0u, 2u, 7u };
+  {
+    auto [decoded, indices] = DecodeJobIndices(EncodeJobIndices(job_indices));
+    EXPECT_TRUE(decoded);
+    EXPECT_EQ(indices, job_indices);
+  }
+  {
+    auto [decoded, indices] = DecodeJobIndices(EncodeJobIndices({}));
+    EXPECT_TRUE(decoded);
+    EXPECT_TRUE(indices.empty());
+  }
+  {
+    sup::dto::AnyValue not_a_list{sup::dto::StringType, "not a list"};
+    auto [decoded, indices] = DecodeJobIndices(not_a_list);
+    EXPECT_FALSE(decoded);
+    EXPECT_TRUE(indices.empty());
+  }
+}
+
+TEST_F(SupAutoProtocolTest, JobCommandResults)
+{
+  const std::vector<bool> results{true, false, false, true};
+  {
+    auto [decoded, decoded_results] = DecodeJobCommandResults(EncodeJobCommandResults(results));
+    EXPECT_TRUE(decoded);
+    EXPECT_EQ(decoded_results, results);
+  }
+  {
+    auto [decoded, decoded_results] = DecodeJobCommandResults(EncodeJobCommandResults({}));
+    EXPECT_TRUE(decoded);
+    EXPECT_TRUE(decoded_results.empty());
+  }
+  {
+    auto [decoded, decoded_results] =
+      DecodeJobCommandResults(sup::dto::AnyValue{sup::dto::StringType, "true"});
+    EXPECT_FALSE(decoded);
+  }
+}
+
 TEST_F(SupAutoProtocolTest, ResultToString)
 {
   EXPECT_EQ(AutomationServerResultToString(sup::protocol::Success), "Success");
@@ -283,3 +374,31 @@ TEST_F(SupAutoProtocolTest, ResultToString)
   EXPECT_EQ(AutomationServerResultToString(ClientReplyRefused), "ClientReplyRefused");
   EXPECT_EQ(AutomationServerResultToString((sup::protocol::ProtocolResult)999), "Unknown ProtocolResult for SUP automation interface: 999");
 }
+
+TEST_F(SupAutoProtocolTest, NativeChannelValue)
+{
+  // Structures without empty leaves can be published natively
+  EXPECT_TRUE(IsNativeChannelValue(kJobStateAnyValue));
+  EXPECT_TRUE(IsNativeChannelValue(kLogEntryAnyValue));
+
+  // Values with empty leaves or non-structured values need base64 encoding
+  EXPECT_FALSE(IsNativeChannelValue(kVariableAnyValue));
+  EXPECT_FALSE(IsNativeChannelValue(sup::dto::AnyValue{sup::dto::UnsignedInteger32Type, 5u}));
+  EXPECT_FALSE(IsNativeChannelValue(sup::dto::AnyValue{}));
+
+  // Decoding supports both encoded and native channel values
+  {
+    auto [decoded, value] = DecodeChannelValue(Base64EncodeAnyValue(kJobStateAnyValue));
+    EXPECT_TRUE(decoded);
+    EXPECT_EQ(value, kJobStateAnyValue);
+  }
+  {
+    auto [decoded, value] = DecodeChannelValue(kJobStateAnyValue);
+    EXPECT_TRUE(decoded);
+    EXPECT_EQ(value, kJobStateAnyValue);
+  }
+  {
+    auto [decoded, value] = DecodeChannelValue(sup::dto::AnyValue{sup::dto::UnsignedInteger32Type, 5u});
+    EXPECT_FALSE(decoded);
+  }
+}
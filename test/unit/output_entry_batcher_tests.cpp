@@ -0,0 +1,152 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/output_entry_batcher.h>
+
+#include <gtest/gtest.h>
+
+using namespace sup::oac_tree_server;
+
+class OutputEntryBatcherTest : public ::testing::Test
+{
+protected:
+  OutputEntryBatcherTest();
+  virtual ~OutputEntryBatcherTest();
+
+  OutputEntryBatcher::LogBatchFunction GetLogBatchFunction();
+  OutputEntryBatcher::MessageBatchFunction GetMessageBatchFunction();
+  bool WaitForLogEntries(std::size_t n_entries, double seconds);
+
+  std::vector<std::vector<LogEntry>> m_log_batches;
+  std::vector<std::vector<MessageEntry>> m_msg_batches;
+  std::mutex m_mtx;
+  std::condition_variable m_cv;
+};
+
+TEST_F(OutputEntryBatcherTest, FlushOnDestruction)
+{
+  {
+    OutputEntryBatcher batcher{std::chrono::seconds(10), 100, GetLogBatchFunction(),
+                               GetMessageBatchFunction()};
+    batcher.AddLogEntry({ 1u, 1, "one" });
+    batcher.AddLogEntry({ 2u, 2, "two" });
+    batcher.AddMessageEntry({ 1u, "hello" });
+  }
+  ASSERT_EQ(m_log_batches.size(), 1u);
+  ASSERT_EQ(m_log_batches[0].size(), 2u);
+  EXPECT_EQ(m_log_batches[0][0].m_message, "one");
+  EXPECT_EQ(m_log_batches[0][1].m_message, "two");
+  ASSERT_EQ(m_msg_batches.size(), 1u);
+  ASSERT_EQ(m_msg_batches[0].size(), 1u);
+  EXPECT_EQ(m_msg_batches[0][0].m_message, "hello");
+}
+
+TEST_F(OutputEntryBatcherTest, FlushOnInterval)
+{
+  OutputEntryBatcher batcher{std::chrono::milliseconds(10), 100, GetLogBatchFunction(),
+                             GetMessageBatchFunction()};
+  batcher.AddLogEntry({ 1u, 1, "one" });
+  batcher.AddLogEntry({ 2u, 2, "two" });
+  EXPECT_TRUE(WaitForLogEntries(2u, 5.0));
+}
+
+TEST_F(OutputEntryBatcherTest, FlushOnSize)
+{
+  OutputEntryBatcher batcher{std::chrono::seconds(10), 4, GetLogBatchFunction(),
+                             GetMessageBatchFunction()};
+  for (sup::dto::uint64 idx = 1; idx <= 4; ++idx)
+  {
+    batcher.AddLogEntry({ idx, 0, "log" });
+  }
+  // Full batch is published long before the interval expires
+  EXPECT_TRUE(WaitForLogEntries(4u, 5.0));
+}
+
+TEST_F(OutputEntryBatcherTest, PreservesOrder)
+{
+  const sup::dto::uint64 n_entries = 1000;
+  {
+    OutputEntryBatcher batcher{std::chrono::milliseconds(1), 16, GetLogBatchFunction(),
+                               GetMessageBatchFunction()};
+    for (sup::dto::uint64 idx = 1; idx <= n_entries; ++idx)
+    {
+      batcher.AddLogEntry({ idx, 0, "log" });
+    }
+  }
+  sup::dto::uint64 expected_idx = 1;
+  for (const auto& batch : m_log_batches)
+  {
+    EXPECT_FALSE(batch.empty());
+    for (const auto& entry : batch)
+    {
+      EXPECT_EQ(entry.m_index, expected_idx);
+      ++expected_idx;
+    }
+  }
+  EXPECT_EQ(expected_idx, n_entries + 1);
+}
+
+OutputEntryBatcherTest::OutputEntryBatcherTest()
+  : m_log_batches{}
+  , m_msg_batches{}
+  , m_mtx{}
+  , m_cv{}
+{}
+
+OutputEntryBatcherTest::~OutputEntryBatcherTest() = default;
+
+OutputEntryBatcher::LogBatchFunction OutputEntryBatcherTest::GetLogBatchFunction()
+{
+  return [this](const std::vector<LogEntry>& log_entries) {
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      m_log_batches.push_back(log_entries);
+    }
+    m_cv.notify_one();
+  };
+}
+
+OutputEntryBatcher::MessageBatchFunction OutputEntryBatcherTest::GetMessageBatchFunction()
+{
+  return [this](const std::vector<MessageEntry>& msg_entries) {
+    {
+      std::lock_guard<std::mutex> lk{m_mtx};
+      m_msg_batches.push_back(msg_entries);
+    }
+    m_cv.notify_one();
+  };
+}
+
+bool OutputEntryBatcherTest::WaitForLogEntries(std::size_t n_entries, double seconds)
+{
+  auto duration = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+    std::chrono::duration<double>(seconds));
+  std::unique_lock<std::mutex> lk{m_mtx};
+  return m_cv.wait_for(lk, duration, [this, n_entries]() {
+    std::size_t n_received = 0;
+    for (const auto& batch : m_log_batches)
+    {
+      n_received += batch.size();
+    }
+    return n_received == n_entries;
+  });
+}
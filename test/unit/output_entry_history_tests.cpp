@@ -0,0 +1,131 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/output_entry_history.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace sup::oac_tree_server;
+
+class OutputEntryHistoryTest : public ::testing::Test
+{
+protected:
+  OutputEntryHistoryTest() = default;
+  virtual ~OutputEntryHistoryTest() = default;
+};
+
+TEST_F(OutputEntryHistoryTest, Construction)
+{
+  OutputEntryHistory history{4u};
+  auto entries = history.GetEntriesAfter({ 0, 0, 0 });
+  EXPECT_TRUE(entries.m_log_entries.empty());
+  EXPECT_TRUE(entries.m_message_entries.empty());
+  EXPECT_TRUE(entries.m_output_value_entries.empty());
+}
+
+TEST_F(OutputEntryHistoryTest, EntriesAfterIndex)
+{
+  OutputEntryHistory history{4u};
+  history.AddLogEntry({ 1u, 0, "one" });
+  history.AddLogEntry({ 2u, 0, "two" });
+  history.AddLogEntry({ 3u, 0, "three" });
+  history.AddMessageEntry({ 1u, "message" });
+  history.AddOutputValueEntry({ 1u, "flag", { sup::dto::BooleanType, true }});
+  {
+    // All entries
+    auto entries = history.GetEntriesAfter({ 0, 0, 0 });
+    ASSERT_EQ(entries.m_log_entries.size(), 3u);
+    EXPECT_EQ(entries.m_log_entries[0].m_message, "one");
+    EXPECT_EQ(entries.m_log_entries[2].m_message, "three");
+    ASSERT_EQ(entries.m_message_entries.size(), 1u);
+    ASSERT_EQ(entries.m_output_value_entries.size(), 1u);
+  }
+  {
+    // Only more recent entries
+    auto entries = history.GetEntriesAfter({ 2u, 1u, 0 });
+    ASSERT_EQ(entries.m_log_entries.size(), 1u);
+    EXPECT_EQ(entries.m_log_entries[0].m_index, 3u);
+    EXPECT_TRUE(entries.m_message_entries.empty());
+    EXPECT_EQ(entries.m_output_value_entries.size(), 1u);
+  }
+}
+
+TEST_F(OutputEntryHistoryTest, BoundedCapacity)
+{
+  OutputEntryHistory history{4u};
+  for (sup::dto::uint64 idx = 1; idx <= 10; ++idx)
+  {
+    history.AddLogEntry({ idx, 0, "log" });
+    history.AddMessageEntry({ idx, "message" });
+  }
+  auto entries = history.GetEntriesAfter({ 0, 0, 0 });
+  ASSERT_EQ(entries.m_log_entries.size(), 4u);
+  EXPECT_EQ(entries.m_log_entries.front().m_index, 7u);
+  EXPECT_EQ(entries.m_log_entries.back().m_index, 10u);
+  ASSERT_EQ(entries.m_message_entries.size(), 4u);
+  EXPECT_EQ(entries.m_message_entries.front().m_index, 7u);
+
+  // Out of order additions are returned sorted:
+  history.AddLogEntry({ 12u, 0, "twelve" });
+  history.AddLogEntry({ 11u, 0, "eleven" });
+  entries = history.GetEntriesAfter({ 10u, 10u, 0 });
+  ASSERT_EQ(entries.m_log_entries.size(), 2u);
+  EXPECT_EQ(entries.m_log_entries[0].m_message, "eleven");
+  EXPECT_EQ(entries.m_log_entries[1].m_message, "twelve");
+  EXPECT_TRUE(entries.m_message_entries.empty());
+}
+
+TEST_F(OutputEntryHistoryTest, ZeroCapacity)
+{
+  OutputEntryHistory history{0};
+  history.AddLogEntry({ 1u, 0, "log" });
+  history.AddMessageEntry({ 1u, "message" });
+  history.AddOutputValueEntry({ 1u, "flag", { sup::dto::BooleanType, true }});
+  auto entries = history.GetEntriesAfter({ 0, 0, 0 });
+  EXPECT_TRUE(entries.m_log_entries.empty());
+  EXPECT_TRUE(entries.m_message_entries.empty());
+  EXPECT_TRUE(entries.m_output_value_entries.empty());
+}
+
+TEST_F(OutputEntryHistoryTest, ConcurrentProducers)
+{
+  const sup::dto::uint64 n_entries = 1000;
+  OutputEntryHistory history{static_cast<sup::dto::uint32>(2 * n_entries)};
+  auto producer = [&history, n_entries](sup::dto::uint64 offset) {
+    for (sup::dto::uint64 idx = 0; idx < n_entries; ++idx)
+    {
+      history.AddLogEntry({ 2 * idx + offset, 0, "log" });
+    }
+  };
+  auto even = std::async(std::launch::async, producer, 1);
+  auto odd = std::async(std::launch::async, producer, 2);
+  even.get();
+  odd.get();
+  auto entries = history.GetEntriesAfter({ 0, 0, 0 });
+  ASSERT_EQ(entries.m_log_entries.size(), 2 * n_entries);
+  for (sup::dto::uint64 idx = 0; idx < entries.m_log_entries.size(); ++idx)
+  {
+    EXPECT_EQ(entries.m_log_entries[idx].m_index, idx + 1);
+  }
+}
@@ -74,3 +74,68 @@ TEST_F(OutputEntriesTest, OutputValueEntrySerialization)
   OutputValueEntry fake{ 42u, "hello", { sup::dto::BooleanType, false }};
   EXPECT_NE(original, fake);
 }
+
+TEST_F(OutputEntriesTest, EntryBatchSerialization)
+{
+  std::vector<LogEntry> log_entries{{ 1u, 1, "hello" }, { 2u, 2, "world" }};
+  auto log_av = EncodeLogEntryBatch(log_entries);
+  EXPECT_TRUE(IsEntryBatch(log_av));
+  auto [log_decoded, decoded_log_entries] = DecodeLogEntryBatch(log_av);
+  ASSERT_TRUE(log_decoded);
+  EXPECT_EQ(decoded_log_entries, log_entries);
+
+  std::vector<MessageEntry> msg_entries{{ 1u, "hello" }};
+  auto msg_av = EncodeMessageEntryBatch(msg_entries);
+  EXPECT_TRUE(IsEntryBatch(msg_av));
+  auto [msg_decoded, decoded_msg_entries] = DecodeMessageEntryBatch(msg_av);
+  ASSERT_TRUE(msg_decoded);
+  EXPECT_EQ(decoded_msg_entries, msg_entries);
+
+  // Single entries are not batches and batches of the wrong kind are rejected
+  EXPECT_FALSE(IsEntryBatch(EncodeLogEntry(log_entries.front())));
+  auto [wrong_decoded, wrong_entries] = DecodeLogEntryBatch(msg_av);
+  EXPECT_FALSE(wrong_decoded);
+}
+
+TEST_F(OutputEntriesTest, OutputEntriesSerialization)
+{
+  OutputEntries original{};
+  {
+    // Empty collection of entries
+    auto av = EncodeOutputEntries(original);
+    auto [decoded, output_entries] = DecodeOutputEntries(av);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(output_entries, original);
+  }
+  original.m_log_entries.push_back({ 5u, 1, "hello" });
+  original.m_log_entries.push_back({ 6u, 2, "world" });
+  original.m_message_entries.push_back({ 42u, "message" });
+  original.m_output_value_entries.push_back({ 1u, "flag", { sup::dto::BooleanType, true }});
+  original.m_output_value_entries.push_back({ 2u, "text", { sup::dto::StringType, "value" }});
+  {
+    // Output value entries with different value types
+    auto av = EncodeOutputEntries(original);
+    auto [decoded, output_entries] = DecodeOutputEntries(av);
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(output_entries, original);
+  }
+  {
+    // Invalid encoding
+    sup::dto::AnyValue av{ sup::dto::BooleanType, true };
+    auto [decoded, output_entries] = DecodeOutputEntries(av);
+    EXPECT_FALSE(decoded);
+  }
+}
+
+TEST_F(OutputEntriesTest, OutputEntryIndicesSerialization)
+{
+  OutputEntryIndices original{ 1u, 2u, 3u };
+  auto av = EncodeOutputEntryIndices(original);
+  auto [decoded, indices] = DecodeOutputEntryIndices(av);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(indices, original);
+  OutputEntryIndices fake{ 1u, 2u, 4u };
+  EXPECT_NE(original, fake);
+  auto [decoded_fake, indices_fake] = DecodeOutputEntryIndices(EncodeLogEntry({ 1u, 2, "log" }));
+  EXPECT_FALSE(decoded_fake);
+}
@@ -22,6 +22,7 @@
 
 #include <sup/oac-tree-server/automation_protocol_client.h>
 #include <sup/oac-tree-server/control_protocol_server.h>
+#include <sup/oac-tree-server/exceptions.h>
 #include <sup/oac-tree-server/info_protocol_server.h>
 #include <sup/oac-tree-server/oac_tree_protocol.h>
 
@@ -111,6 +112,85 @@ TEST_F(ProtocolClientServerTest, GetJobInfo)
   EXPECT_EQ(job_info_reply, job_info);
 }
 
+TEST_F(ProtocolClientServerTest, GetAllJobInfos)
+{
+  // Test GetAllJobInfos over the protocol layer
+
+  // Build JobInfo
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kWorkspaceSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc.get(), nullptr);
+  auto root = proc->RootInstruction();
+  sup::oac_tree::InstructionMap instr_map{root};
+  auto job_info = sup::oac_tree::utils::CreateJobInfo(*proc, instr_map);
+
+  const std::string server_prefix = "AllJobInfosServerPrefix";
+  const sup::dto::uint32 n_jobs = 42u;
+  const std::vector<sup::dto::uint32> job_ids{ 3u, 32u };
+  JobManagerInfo job_manager_info{ server_prefix, n_jobs, { job_info, job_info }, job_ids };
+  {
+    // Selection of jobs
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetAllJobInfos(job_ids)).Times(Exactly(1))
+      .WillOnce(Return(job_manager_info));
+    auto reply = m_client_job_manager.GetAllJobInfos(job_ids);
+    EXPECT_EQ(reply.m_server_prefix, server_prefix);
+    EXPECT_EQ(reply.m_n_jobs, n_jobs);
+    ASSERT_EQ(reply.m_job_infos.size(), 2u);
+    EXPECT_EQ(reply.m_job_infos[1], job_info);
+    EXPECT_EQ(reply.m_job_indices, job_ids);
+  }
+  {
+    // All jobs are requested with an empty list; the indices identify the returned jobs when some
+    // were removed
+    const std::vector<sup::dto::uint32> no_job_ids{};
+    const std::vector<sup::dto::uint32> remaining_job_ids{ 0u, 2u };
+    JobManagerInfo remaining_info{ server_prefix, n_jobs, { job_info, job_info },
+                                   remaining_job_ids };
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_CALL(m_job_manager, GetAllJobInfos(no_job_ids)).Times(Exactly(1))
+      .WillOnce(Return(remaining_info));
+    auto reply = m_client_job_manager.GetAllJobInfos(no_job_ids);
+    EXPECT_EQ(reply.m_job_infos.size(), 2u);
+    EXPECT_EQ(reply.m_job_indices, remaining_job_ids);
+  }
+  {
+    // Unknown job
+    const std::vector<sup::dto::uint32> unknown_job_ids{ 3u, n_jobs };
+    EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+    EXPECT_THROW(m_client_job_manager.GetAllJobInfos(unknown_job_ids),
+                 InvalidOperationException);
+  }
+}
+
+TEST_F(ProtocolClientServerTest, GetOutputEntries)
+{
+  // Test GetOutputEntries over the protocol layer
+  OutputEntries output_entries{};
+  output_entries.m_log_entries.push_back({ 3u, 2, "log" });
+  output_entries.m_log_entries.push_back({ 4u, 6, "another log" });
+  output_entries.m_message_entries.push_back({ 7u, "message" });
+  output_entries.m_output_value_entries.push_back({ 1u, "flag", { sup::dto::BooleanType, true }});
+  output_entries.m_output_value_entries.push_back({ 2u, "count", { sup::dto::UnsignedInteger16Type, 5 }});
+  const OutputEntryIndices last_indices{ 2u, 6u, 0u };
+  const sup::dto::uint32 n_jobs = 42u;
+  const sup::dto::uint32 job_id = 32u;
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetOutputEntries(job_id, last_indices)).Times(Exactly(1))
+    .WillOnce(Return(output_entries));
+  auto output_entries_reply = m_client_job_manager.GetOutputEntries(job_id, last_indices);
+  EXPECT_EQ(output_entries_reply, output_entries);
+}
+
+TEST_F(ProtocolClientServerTest, GetJobGenerations)
+{
+  // Test GetJobGenerations over the protocol layer
+  const std::vector<sup::dto::uint64> generations{ 5u, 6u, 9u };
+  EXPECT_CALL(m_job_manager, GetJobGenerations()).Times(Exactly(1))
+    .WillOnce(Return(generations));
+  EXPECT_EQ(m_client_job_manager.GetJobGenerations(), generations);
+}
+
 TEST_F(ProtocolClientServerTest, EditBreakpoint)
 {
   // Build JobInfo
@@ -131,6 +211,34 @@ TEST_F(ProtocolClientServerTest, EditBreakpoint)
   m_client_job_manager.EditBreakpoint(job_id, instr_id, true);
 }
 
+TEST_F(ProtocolClientServerTest, EditBreakpoints)
+{
+  // Build JobInfo
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kWorkspaceSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  ASSERT_NE(proc.get(), nullptr);
+  auto root = proc->RootInstruction();
+  sup::oac_tree::InstructionMap instr_map{root};
+  auto job_info = sup::oac_tree::utils::CreateJobInfo(*proc, instr_map);
+  const auto n_instr = job_info.GetNumberOfInstructions();
+
+  // Test EditBreakpoints over the protocol layer
+  const sup::dto::uint32 n_jobs = 42u;
+  const sup::dto::uint32 job_id = 32u;
+  const std::set<sup::dto::uint32> instr_ids{0u, 1u};
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetJobInfo(job_id)).Times(Exactly(1)).WillOnce(Return(job_info));
+  EXPECT_CALL(m_job_manager, EditBreakpoints(job_id, instr_ids, false)).Times(Exactly(1));
+  m_client_job_manager.EditBreakpoints(job_id, instr_ids, false);
+
+  // Invalid instruction index does not edit any breakpoint
+  const std::set<sup::dto::uint32> invalid_instr_ids{0u, n_instr};
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, GetJobInfo(job_id)).Times(Exactly(1)).WillOnce(Return(job_info));
+  EXPECT_THROW(m_client_job_manager.EditBreakpoints(job_id, invalid_instr_ids, true),
+               InvalidOperationException);
+}
+
 TEST_F(ProtocolClientServerTest, SendJobCommand)
 {
   // Test SendJobCommand over the protocol layer
@@ -142,6 +250,30 @@ TEST_F(ProtocolClientServerTest, SendJobCommand)
   m_client_job_manager.SendJobCommand(job_id, command);
 }
 
+TEST_F(ProtocolClientServerTest, SendJobCommands)
+{
+  // Test SendJobCommands over the protocol layer
+  const sup::dto::uint32 n_jobs = 42u;
+  const std::vector<sup::dto::uint32> job_ids{3u, 32u, 7u};
+  const std::vector<bool> results{true, false, true};
+  auto command = sup::oac_tree::JobCommand::kHalt;
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, SendJobCommands(job_ids, command)).Times(Exactly(1))
+    .WillOnce(Return(results));
+  EXPECT_EQ(m_client_job_manager.SendJobCommands(job_ids, command), results);
+
+  // Empty list of job indices addresses all jobs
+  const std::vector<bool> all_results(n_jobs, true);
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_CALL(m_job_manager, SendJobCommands(std::vector<sup::dto::uint32>{}, command))
+    .Times(Exactly(1)).WillOnce(Return(all_results));
+  EXPECT_EQ(m_client_job_manager.SendJobCommands({}, command), all_results);
+
+  // Unknown job index
+  EXPECT_CALL(m_job_manager, GetNumberOfJobs()).Times(Exactly(1)).WillOnce(Return(n_jobs));
+  EXPECT_THROW(m_client_job_manager.SendJobCommands({3u, n_jobs}, command), InvalidOperationException);
+}
+
 ProtocolClientServerTest::ProtocolClientServerTest()
   : m_job_manager{}
   , m_info_server{m_job_manager}
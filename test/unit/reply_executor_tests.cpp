@@ -0,0 +1,131 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/client_reply_delegator.h>
+#include <sup/oac-tree-server/exceptions.h>
+#include <sup/oac-tree-server/reply_executor.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace sup::oac_tree_server;
+
+class ReplyExecutorTest : public ::testing::Test
+{
+protected:
+  ReplyExecutorTest() = default;
+  virtual ~ReplyExecutorTest() = default;
+};
+
+TEST_F(ReplyExecutorTest, Construction)
+{
+  EXPECT_THROW(ReplyExecutor{0}, InvalidOperationException);
+  ReplyExecutor executor{2};
+  EXPECT_EQ(executor.GetNumberOfThreads(), 2);
+  EXPECT_EQ(GetSharedReplyExecutor().GetNumberOfThreads(), kDefaultReplyExecutorThreads);
+}
+
+TEST_F(ReplyExecutorTest, RunsAllTasks)
+{
+  std::atomic<int> count{0};
+  {
+    ReplyExecutor executor{3};
+    for (int idx = 0; idx < 100; ++idx)
+    {
+      executor.Post([&count]() { ++count; });
+    }
+    // Queued tasks are still run on destruction
+  }
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(ReplyExecutorTest, DelegatorsShareExecutor)
+{
+  ReplyExecutor executor{2};
+  std::mutex mtx;
+  std::map<int, std::vector<sup::dto::uint64>> delivered;
+  std::promise<void> release;
+  auto release_future = release.get_future().share();
+  std::promise<void> blocked;
+  auto make_reply_func = [&mtx, &delivered](int delegator_idx) {
+    return [&mtx, &delivered, delegator_idx](sup::dto::uint64 id, const UserInputReply&) {
+      std::lock_guard<std::mutex> lk{mtx};
+      delivered[delegator_idx].push_back(id);
+    };
+  };
+  auto interrupt_func = [](sup::dto::uint64) {};
+  // The first delegator blocks on its first reply:
+  auto blocking_reply_func = [&blocked, release_future, reply_func = make_reply_func(0)](
+    sup::dto::uint64 id, const UserInputReply& reply) {
+    if (id == 1u)
+    {
+      blocked.set_value();
+      release_future.wait();
+    }
+    reply_func(id, reply);
+  };
+  auto reply = sup::oac_tree::CreateUserChoiceReply(true, 1);
+  {
+    ClientReplyDelegator delegator_0{blocking_reply_func, interrupt_func, executor};
+    ClientReplyDelegator delegator_1{make_reply_func(1), interrupt_func, executor};
+    for (sup::dto::uint64 id = 1u; id <= 10u; ++id)
+    {
+      delegator_0.QueueReply(id, reply);
+    }
+    blocked.get_future().wait();
+    // Replies of the second delegator are delivered while the first one is blocked:
+    for (sup::dto::uint64 id = 1u; id <= 10u; ++id)
+    {
+      delegator_1.QueueReply(id, reply);
+    }
+    auto all_delivered = [&mtx, &delivered]() {
+      std::lock_guard<std::mutex> lk{mtx};
+      return delivered[1].size() == 10u;
+    };
+    for (int retry = 0; retry < 100 && !all_delivered(); ++retry)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(all_delivered());
+    release.set_value();
+    for (int retry = 0; retry < 100; ++retry)
+    {
+      {
+        std::lock_guard<std::mutex> lk{mtx};
+        if (delivered[0].size() == 10u)
+        {
+          break;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  // Replies of each delegator are delivered in order:
+  std::vector<sup::dto::uint64> expected{ 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u };
+  EXPECT_EQ(delivered[0], expected);
+  EXPECT_EQ(delivered[1], expected);
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "unit_test_helper.h"
+
+#include <sup/oac-tree-server/exceptions.h>
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/server_job_table.h>
+
+#include <sup/oac-tree/sequence_parser.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace sup::oac_tree_server;
+
+class ServerJobTableTest : public ::testing::Test
+{
+protected:
+  ServerJobTableTest();
+  virtual ~ServerJobTableTest() = default;
+
+  std::shared_ptr<ServerJob> CreateLazyJob(sup::dto::uint32 idx);
+
+  UnitTestHelper::TestAnyValueManager m_av_mgr;
+  std::atomic<sup::dto::uint64> m_next_generation;
+};
+
+TEST_F(ServerJobTableTest, AppendAndExchange)
+{
+  ServerJobTable table;
+  EXPECT_EQ(table.GetSize(), 0u);
+  EXPECT_EQ(table.Get(0).get(), nullptr);
+  EXPECT_TRUE(table.GetAll().empty());
+
+  auto job_0 = CreateLazyJob(0);
+  auto job_1 = CreateLazyJob(1);
+  EXPECT_EQ(table.Append(job_0), 0u);
+  EXPECT_EQ(table.Append(job_1), 1u);
+  EXPECT_EQ(table.GetSize(), 2u);
+  EXPECT_EQ(table.Get(0), job_0);
+  EXPECT_EQ(table.Get(1), job_1);
+  EXPECT_EQ(table.Get(2).get(), nullptr);
+
+  // Removing a job leaves an empty slot:
+  EXPECT_EQ(table.Exchange(0, {}), job_0);
+  EXPECT_EQ(table.GetSize(), 2u);
+  EXPECT_EQ(table.Get(0).get(), nullptr);
+  auto all_jobs = table.GetAll();
+  ASSERT_EQ(all_jobs.size(), 2u);
+  EXPECT_EQ(all_jobs[0].get(), nullptr);
+  EXPECT_EQ(all_jobs[1], job_1);
+
+  // Replacing a job:
+  auto job_2 = CreateLazyJob(0);
+  EXPECT_EQ(table.Exchange(0, job_2).get(), nullptr);
+  EXPECT_EQ(table.Get(0), job_2);
+  EXPECT_THROW(table.Exchange(2, job_0), InvalidOperationException);
+}
+
+TEST_F(ServerJobTableTest, ConcurrentReads)
+{
+  // Readers look up jobs while the table grows over multiple chunks:
+  const sup::dto::uint32 n_jobs = ServerJobTable::kChunkSize * 2 + 1;
+  ServerJobTable table;
+  std::atomic<bool> done{false};
+  auto reader = [&table, &done]() {
+    bool consistent = true;
+    while (!done.load())
+    {
+      auto size = table.GetSize();
+      if (size > 0 && !table.Get(size - 1))
+      {
+        consistent = false;
+      }
+    }
+    return consistent;
+  };
+  auto reader_future = std::async(std::launch::async, reader);
+  for (sup::dto::uint32 idx = 0; idx < n_jobs; ++idx)
+  {
+    EXPECT_EQ(table.Append(CreateLazyJob(idx)), idx);
+  }
+  done.store(true);
+  EXPECT_TRUE(reader_future.get());
+  EXPECT_EQ(table.GetSize(), n_jobs);
+  for (sup::dto::uint32 idx = 0; idx < n_jobs; ++idx)
+  {
+    EXPECT_NE(table.Get(idx).get(), nullptr);
+  }
+}
+
+ServerJobTableTest::ServerJobTableTest()
+  : m_av_mgr{}
+  , m_next_generation{1}
+{}
+
+std::shared_ptr<ServerJob> ServerJobTableTest::CreateLazyJob(sup::dto::uint32 idx)
+{
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kShortSequenceBody);
+  auto proc = sup::oac_tree::ParseProcedureString(procedure_string);
+  auto job_prefix = CreateJobPrefix("ServerJobTableTest", idx);
+  return std::make_shared<ServerJob>(job_prefix, m_av_mgr, ServerJobInfoIOConfig{},
+                                     std::move(proc), ProcedureFactory{}, true,
+                                     m_next_generation);
+}
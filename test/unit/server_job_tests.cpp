@@ -0,0 +1,289 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include "unit_test_helper.h"
+
+#include <sup/oac-tree-server/epics/epics_anyvalue_manager.h>
+#include <sup/oac-tree-server/exceptions.h>
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/server_job.h>
+
+#include <sup/oac-tree/sequence_parser.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace sup::oac_tree_server;
+
+class ServerJobTest : public ::testing::Test
+{
+protected:
+  ServerJobTest();
+  virtual ~ServerJobTest() = default;
+
+  std::unique_ptr<sup::oac_tree::Procedure> CreateProcedure();
+
+  UnitTestHelper::TestAnyValueManager m_av_mgr;
+  std::atomic<sup::dto::uint64> m_next_generation;
+  ProcedureFactory m_factory;
+  sup::dto::uint32 m_n_factory_calls;
+};
+
+TEST_F(ServerJobTest, EagerInstantiation)
+{
+  const std::string prefix = "ServerJobTest:Eager:";
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), ProcedureFactory{},
+                false, m_next_generation};
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_TRUE(m_av_mgr.HasAnyValue(GetJobStatePVName(prefix)));
+  EXPECT_EQ(job.GetGeneration(), 1u);
+  EXPECT_EQ(m_next_generation.load(), 2u);
+  auto job_info = job.GetInfo();
+  EXPECT_EQ(job_info.GetProcedureName(), "Common header");
+  EXPECT_EQ(job.GetNumberOfInstructions(), job_info.GetNumberOfInstructions());
+
+  // Without a factory, the job cannot be torn down:
+  EXPECT_FALSE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_THROW(job.SendJobCommand(sup::oac_tree::JobCommand::kTerminate),
+               InvalidOperationException);
+}
+
+TEST_F(ServerJobTest, LazyInstantiation)
+{
+  const std::string prefix = "ServerJobTest:Lazy:";
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), m_factory, true,
+                m_next_generation};
+  EXPECT_FALSE(job.IsInstantiated());
+  EXPECT_FALSE(m_av_mgr.HasAnyValue(GetJobStatePVName(prefix)));
+  auto output_entries = job.GetOutputEntries({ 0, 0, 0 });
+  EXPECT_TRUE(output_entries.m_log_entries.empty());
+  EXPECT_FALSE(job.IsInstantiated());
+
+  // First use instantiates the job from the procedure it was created with:
+  auto job_info = job.GetInfo();
+  EXPECT_EQ(job_info.GetProcedureName(), "Common header");
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_TRUE(m_av_mgr.HasAnyValue(GetJobStatePVName(prefix)));
+  EXPECT_EQ(m_n_factory_calls, 0u);
+  auto generation = job.GetGeneration();
+
+  // Job was used too recently:
+  EXPECT_FALSE(job.TearDownIfIdle(std::chrono::hours(1)));
+  EXPECT_TRUE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_FALSE(job.IsInstantiated());
+  EXPECT_FALSE(m_av_mgr.HasAnyValue(GetJobStatePVName(prefix)));
+  EXPECT_EQ(job.GetGeneration(), generation);
+
+  // Next use instantiates the job from the factory and assigns a new generation:
+  EXPECT_NO_THROW(job.EditBreakpoints({ 0u }, true));
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_EQ(m_n_factory_calls, 1u);
+  EXPECT_NE(job.GetGeneration(), generation);
+  EXPECT_EQ(job.GetNumberOfInstructions(), job_info.GetNumberOfInstructions());
+}
+
+TEST_F(ServerJobTest, NoTearDownWhenRunning)
+{
+  const std::string prefix = "ServerJobTest:Running:";
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), m_factory, true,
+                m_next_generation};
+  EXPECT_NO_THROW(job.SendJobCommand(sup::oac_tree::JobCommand::kStart));
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(sup::oac_tree::JobState::kRunning), 1.0));
+  EXPECT_FALSE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_NO_THROW(job.SendJobCommand(sup::oac_tree::JobCommand::kHalt));
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(sup::oac_tree::JobState::kHalted), 1.0));
+  EXPECT_TRUE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_FALSE(job.IsInstantiated());
+}
+
+TEST_F(ServerJobTest, BreakpointsKeptOnTearDown)
+{
+  const std::string prefix = "ServerJobTest:Breakpoints:";
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), m_factory, true,
+                m_next_generation};
+  EXPECT_NO_THROW(job.EditBreakpoints({ 0u }, true));
+  EXPECT_TRUE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_FALSE(job.IsInstantiated());
+
+  // The recreated job stops at the breakpoint that was set before the teardown:
+  EXPECT_NO_THROW(job.SendJobCommand(sup::oac_tree::JobCommand::kStart));
+  EXPECT_EQ(m_n_factory_calls, 1u);
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(sup::oac_tree::JobState::kPaused), 1.0));
+  EXPECT_NO_THROW(job.SendJobCommand(sup::oac_tree::JobCommand::kHalt));
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(sup::oac_tree::JobState::kHalted), 1.0));
+}
+
+TEST_F(ServerJobTest, FactoryWithoutProcedure)
+{
+  const std::string prefix = "ServerJobTest:NoProcedure:";
+  ProcedureFactory factory = []() { return std::unique_ptr<sup::oac_tree::Procedure>{}; };
+  EXPECT_THROW(ServerJob(prefix, m_av_mgr, ServerJobInfoIOConfig{}, factory(), factory, true,
+                         m_next_generation), InvalidOperationException);
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), factory, true,
+                m_next_generation};
+  EXPECT_NO_THROW(job.GetInfo());
+  EXPECT_TRUE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_THROW(job.GetInfo(), InvalidOperationException);
+}
+
+TEST_F(ServerJobTest, ConcurrentRequests)
+{
+  // Concurrent first requests instantiate the job only once and later requests do not lock:
+  const std::string prefix = "ServerJobTest:Concurrent:";
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), m_factory, true,
+                m_next_generation};
+  auto generation = job.GetGeneration();
+  auto request = [&job]() {
+    for (int i = 0; i < 100; ++i)
+    {
+      if (job.GetInfo().GetProcedureName() != "Common header")
+      {
+        return false;
+      }
+      job.EditBreakpoints({ 0u }, (i % 2) == 0);
+    }
+    return true;
+  };
+  std::vector<std::future<bool>> futures;
+  for (int i = 0; i < 8; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, request));
+  }
+  for (auto& f : futures)
+  {
+    EXPECT_TRUE(f.get());
+  }
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_EQ(job.GetGeneration(), generation);
+  EXPECT_EQ(m_n_factory_calls, 0u);
+}
+
+TEST_F(ServerJobTest, TearDownSingleServer)
+{
+  // Values published through a single EPICS server are released on teardown and published again
+  // on the next use:
+  EPICSServerConfig config{};
+  config.m_single_server = true;
+  EPICSAnyValueManager av_mgr{config};
+  const std::string prefix = "ServerJobTest:SingleServer:";
+  ServerJob job{prefix, av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), m_factory, true,
+                m_next_generation};
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), 0u);
+  EXPECT_NO_THROW(job.GetInfo());
+  auto n_values = av_mgr.GetNumberOfAnyValues();
+  EXPECT_GT(n_values, 0u);
+  EXPECT_TRUE(job.TearDownIfIdle(std::chrono::seconds(0)));
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), 0u);
+  EXPECT_NO_THROW(job.GetInfo());
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), n_values);
+  job.TearDown();
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), 0u);
+}
+
+TEST_F(ServerJobTest, InstantiationRetry)
+{
+  // A failed instantiation releases the values it already published and keeps the procedure, so
+  // it can be retried:
+  EPICSAnyValueManager av_mgr{};
+  const std::string prefix = "ServerJobTest:Retry:";
+  auto input_server_name = GetInputServerName(prefix);
+  ASSERT_TRUE(av_mgr.AddInputHandler(input_server_name));
+  auto n_values = av_mgr.GetNumberOfAnyValues();
+  ServerJob job{prefix, av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), ProcedureFactory{},
+                true, m_next_generation};
+  EXPECT_THROW(job.Instantiate(), InvalidOperationException);
+  EXPECT_FALSE(job.IsInstantiated());
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), n_values);
+
+  // Retry after the conflicting input handler was removed:
+  ASSERT_TRUE(av_mgr.RemoveInputHandler(input_server_name));
+  EXPECT_NO_THROW(job.Instantiate());
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_GT(av_mgr.GetNumberOfAnyValues(), 0u);
+  EXPECT_NO_THROW(job.GetInfo());
+  EXPECT_TRUE(job.TearDown());
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), 0u);
+}
+
+TEST_F(ServerJobTest, TearDownReportsUnreleasedValues)
+{
+  // Teardown reports values that were removed behind the job's back and could not be released:
+  EPICSAnyValueManager av_mgr{};
+  const std::string prefix = "ServerJobTest:Unreleased:";
+  ServerJob job{prefix, av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), ProcedureFactory{},
+                false, m_next_generation};
+  EXPECT_TRUE(job.IsInstantiated());
+  ASSERT_TRUE(av_mgr.RemoveInputHandler(GetInputServerName(prefix)));
+  EXPECT_FALSE(job.TearDown());
+  EXPECT_EQ(av_mgr.GetNumberOfAnyValues(), 0u);
+}
+
+TEST_F(ServerJobTest, PrepareWithoutPublishing)
+{
+  // A prepared job publishes nothing, so another job can still use the same names:
+  using sup::oac_tree::JobState;
+  const std::string prefix = "ServerJobTest:Prepare:";
+  ServerJob other{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(),
+                  ProcedureFactory{}, false, m_next_generation};
+  other.SendJobCommand(sup::oac_tree::JobCommand::kStart);
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(JobState::kRunning), 1.0));
+  ServerJob job{prefix, m_av_mgr, ServerJobInfoIOConfig{}, CreateProcedure(), ProcedureFactory{},
+                true, m_next_generation};
+  EXPECT_NO_THROW(job.Prepare());
+  EXPECT_FALSE(job.IsInstantiated());
+  EXPECT_EQ(m_av_mgr.GetAnyValue(GetJobStatePVName(prefix)), GetJobStateValue(JobState::kRunning));
+
+  // Once the other job released the names, the prepared job publishes its own values:
+  other.TearDown();
+  EXPECT_FALSE(m_av_mgr.HasAnyValue(GetJobStatePVName(prefix)));
+  EXPECT_NO_THROW(job.Instantiate());
+  EXPECT_TRUE(job.IsInstantiated());
+  EXPECT_TRUE(m_av_mgr.WaitForValue(GetJobStatePVName(prefix),
+                                    GetJobStateValue(JobState::kInitial), 1.0));
+  job.TearDown();
+}
+
+ServerJobTest::ServerJobTest()
+  : m_av_mgr{}
+  , m_next_generation{1}
+  , m_factory{}
+  , m_n_factory_calls{0}
+{
+  m_factory = [this]() {
+    ++m_n_factory_calls;
+    return CreateProcedure();
+  };
+}
+
+std::unique_ptr<sup::oac_tree::Procedure> ServerJobTest::CreateProcedure()
+{
+  const auto procedure_string = UnitTestHelper::CreateProcedureString(kLongWaitProcedureBody);
+  return sup::oac_tree::ParseProcedureString(procedure_string);
+}
@@ -247,6 +247,29 @@ void TestAnyValueManager::Interrupt(const std::string& input_server_name, sup::d
   return;
 }
 
+bool TestAnyValueManager::RemoveAnyValues(const std::set<std::string>& names)
+{
+  std::lock_guard<std::mutex> lk{m_mtx};
+  for (const auto& name : names)
+  {
+    if (!HasAnyValueImpl(name))
+    {
+      return false;
+    }
+  }
+  for (const auto& name : names)
+  {
+    (void)m_value_map.erase(name);
+  }
+  return true;
+}
+
+bool TestAnyValueManager::RemoveInputHandler(const std::string& input_server_name)
+{
+  (void)input_server_name;
+  return true;
+}
+
 bool TestAnyValueManager::HasAnyValue(const std::string& name) const
 {
   std::lock_guard<std::mutex> lk{m_mtx};
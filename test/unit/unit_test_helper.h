@@ -34,6 +34,7 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -114,8 +115,17 @@ public:
   MOCK_METHOD(std::string, GetServerPrefix, (), (const override));
   MOCK_METHOD(sup::dto::uint32, GetNumberOfJobs, (), (const override));
   MOCK_METHOD(sup::oac_tree::JobInfo, GetJobInfo, (sup::dto::uint32), (const override));
+  MOCK_METHOD(JobManagerInfo, GetAllJobInfos, (const std::vector<sup::dto::uint32>&),
+              (const override));
+  MOCK_METHOD(std::vector<sup::dto::uint64>, GetJobGenerations, (), (const override));
+  MOCK_METHOD(OutputEntries, GetOutputEntries, (sup::dto::uint32, const OutputEntryIndices&),
+              (const override));
   MOCK_METHOD(void, EditBreakpoint, (sup::dto::uint32, sup::dto::uint32, bool), (override));
+  MOCK_METHOD(void, EditBreakpoints, (sup::dto::uint32, const std::set<sup::dto::uint32>&, bool),
+              (override));
   MOCK_METHOD(void, SendJobCommand, (sup::dto::uint32, sup::oac_tree::JobCommand), (override));
+  MOCK_METHOD(std::vector<bool>, SendJobCommands,
+              (const std::vector<sup::dto::uint32>&, sup::oac_tree::JobCommand), (override));
 };
 
 class TestJobInfoIO : public sup::oac_tree::IJobInfoIO
@@ -171,6 +181,8 @@ public:
   UserInputReply GetUserInput(const std::string& input_server_name, sup::dto::uint64 id,
                               const UserInputRequest& request) override;
   void Interrupt(const std::string& input_server_name, sup::dto::uint64 id) override;
+  bool RemoveAnyValues(const std::set<std::string>& names) override;
+  bool RemoveInputHandler(const std::string& input_server_name) override;
 
   bool HasAnyValue(const std::string& name) const;
 
@@ -0,0 +1,230 @@
+/******************************************************************************
+ * $HeadURL: $
+ * $Id: $
+ *
+ * Project       : SUP - OAC-TREE-SERVER
+ *
+ * Description   : oac-tree server
+ *
+ * Author        : Walter Van Herck (IO)
+ *
+ * Copyright (c) : 2010-2026 ITER Organization,
+ *                 CS 90 046
+ *                 13067 St. Paul-lez-Durance Cedex
+ *                 France
+ * SPDX-License-Identifier: MIT
+ *
+ * This file is part of ITER CODAC software.
+ * For the terms and conditions of redistribution or use of this software
+ * refer to the file LICENSE located in the top level directory
+ * of the distribution package.
+ ******************************************************************************/
+
+#include <sup/oac-tree-server/oac_tree_protocol.h>
+#include <sup/oac-tree-server/variable_delta_codec.h>
+#include <sup/oac-tree-server/variable_delta_helper.h>
+
+#include <sup/dto/anyvalue_helper.h>
+
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+using namespace sup::oac_tree_server;
+
+class VariableDeltaTest : public ::testing::Test
+{
+protected:
+  VariableDeltaTest() = default;
+  virtual ~VariableDeltaTest() = default;
+
+  static sup::dto::AnyValue CreateStructuredValue(sup::dto::int32 a, sup::dto::uint16 element);
+};
+
+TEST_F(VariableDeltaTest, LeafChanges)
+{
+  auto from = CreateStructuredValue(1, 10);
+  auto to = CreateStructuredValue(2, 10);
+  to["arr"][1]["x"] = sup::dto::uint16{20};
+
+  // Only changed leaves are listed
+  auto [compatible, changes] = GetLeafChanges(from, to);
+  ASSERT_TRUE(compatible);
+  ASSERT_EQ(changes.size(), 2);
+  EXPECT_EQ(changes[0].first, "a");
+  EXPECT_EQ(changes[0].second, to["a"]);
+  EXPECT_EQ(changes[1].first, "arr[1].x");
+  EXPECT_EQ(changes[1].second, to["arr"][1]["x"]);
+
+  // Applying the changes restores the changed value
+  auto value = from;
+  EXPECT_TRUE(ApplyLeafChanges(value, changes));
+  EXPECT_EQ(value, to);
+
+  // Different types cannot be compared leaf by leaf
+  sup::dto::AnyValue scalar{ sup::dto::SignedInteger32Type, 1 };
+  EXPECT_FALSE(GetLeafChanges(from, scalar).first);
+
+  // Scalar values have a single leaf with an empty path
+  sup::dto::AnyValue other_scalar{ sup::dto::SignedInteger32Type, 2 };
+  std::tie(compatible, changes) = GetLeafChanges(scalar, other_scalar);
+  ASSERT_TRUE(compatible);
+  ASSERT_EQ(changes.size(), 1);
+  EXPECT_EQ(changes[0].first, "");
+  value = scalar;
+  EXPECT_TRUE(ApplyLeafChanges(value, changes));
+  EXPECT_EQ(value, other_scalar);
+
+  // Unknown paths cannot be applied
+  value = from;
+  EXPECT_FALSE(ApplyLeafChanges(value, {{ "b", scalar }}));
+  EXPECT_FALSE(ApplyLeafChanges(value, {{ "arr[5].x", scalar }}));
+}
+
+TEST_F(VariableDeltaTest, DeltaSerialization)
+{
+  LeafChanges changes{{ "a", sup::dto::AnyValue{ sup::dto::SignedInteger32Type, 4 }}};
+  VariableDelta original{ true, 5, 3, changes };
+  auto encoded = EncodeVariableDelta(original);
+  EXPECT_TRUE(IsVariableDelta(encoded));
+  auto [decoded, delta] = DecodeVariableDelta(encoded);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(delta.m_connected, original.m_connected);
+  EXPECT_EQ(delta.m_seq, original.m_seq);
+  EXPECT_EQ(delta.m_base, original.m_base);
+  EXPECT_EQ(delta.m_changes, original.m_changes);
+
+  // Keyframes are not deltas but can be decoded as plain variable states
+  auto value = CreateStructuredValue(1, 10);
+  auto keyframe = EncodeVariableKeyframe(value, true, 7);
+  EXPECT_FALSE(IsVariableDelta(keyframe));
+  EXPECT_FALSE(DecodeVariableDelta(keyframe).first);
+  auto [var_value, connected] = DecodeVariableState(keyframe);
+  EXPECT_EQ(var_value, value);
+  EXPECT_TRUE(connected);
+}
+
+TEST_F(VariableDeltaTest, EncodeDecode)
+{
+  VariableDeltaEncoder encoder{3};
+  VariableDeltaDecoder decoder{};
+
+  // First update is a keyframe, the next two are deltas
+  auto value_1 = CreateStructuredValue(1, 10);
+  auto encoded_1 = encoder.Encode(value_1, true);
+  EXPECT_FALSE(IsVariableDelta(encoded_1));
+  auto value_2 = CreateStructuredValue(2, 10);
+  auto encoded_2 = encoder.Encode(value_2, true);
+  EXPECT_TRUE(IsVariableDelta(encoded_2));
+  auto value_3 = CreateStructuredValue(3, 30);
+  auto encoded_3 = encoder.Encode(value_3, false);
+  EXPECT_TRUE(IsVariableDelta(encoded_3));
+  auto value_4 = CreateStructuredValue(4, 30);
+  auto encoded_4 = encoder.Encode(value_4, true);
+  EXPECT_FALSE(IsVariableDelta(encoded_4));
+
+  // Deltas are relative to the keyframe, so they can be decoded when intermediate updates are lost
+  EXPECT_EQ(decoder.Decode(encoded_2).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.Decode(encoded_1), std::make_pair(value_1, true));
+  EXPECT_EQ(decoder.Decode(encoded_3), std::make_pair(value_3, false));
+  EXPECT_EQ(decoder.Decode(encoded_2), std::make_pair(value_2, true));
+
+  // Deltas with another keyframe are ignored until the keyframe is received
+  auto value_5 = CreateStructuredValue(5, 30);
+  auto encoded_5 = encoder.Encode(value_5, true);
+  EXPECT_TRUE(IsVariableDelta(encoded_5));
+  EXPECT_EQ(decoder.Decode(encoded_5).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.Decode(encoded_4), std::make_pair(value_4, true));
+  EXPECT_EQ(decoder.Decode(encoded_5), std::make_pair(value_5, true));
+
+  // A type change results in a keyframe
+  sup::dto::AnyValue scalar{ sup::dto::SignedInteger32Type, 1 };
+  auto encoded_6 = encoder.Encode(scalar, true);
+  EXPECT_FALSE(IsVariableDelta(encoded_6));
+  EXPECT_EQ(decoder.Decode(encoded_6), std::make_pair(scalar, true));
+
+  // Plain variable states are decoded as well
+  auto plain = EncodeVariableState(value_1, true);
+  EXPECT_EQ(decoder.Decode(plain), std::make_pair(value_1, true));
+}
+
+TEST_F(VariableDeltaTest, LateJoin)
+{
+  VariableDeltaEncoder encoder{4};
+  auto value_1 = CreateStructuredValue(1, 10);
+  auto keyframe = encoder.Encode(value_1, true);
+  auto value_2 = CreateStructuredValue(2, 10);
+  (void)encoder.Encode(value_2, true);
+  auto value_3 = CreateStructuredValue(3, 20);
+  auto delta = encoder.Encode(value_3, true);
+  ASSERT_TRUE(IsVariableDelta(delta));
+  EXPECT_TRUE(IsSequencedVariableState(keyframe));
+  EXPECT_TRUE(IsSequencedVariableState(delta));
+  EXPECT_FALSE(IsSequencedVariableState(EncodeVariableState(value_1, true)));
+
+  // A client that connects after the keyframe was published, only receives the last delta from
+  // the variable channel, which is decoded as soon as the keyframe channel delivers its keyframe
+  VariableDeltaDecoder decoder{};
+  EXPECT_EQ(decoder.Decode(delta).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.DecodeKeyframe(keyframe), std::make_pair(value_3, true));
+
+  // The keyframe channel can also connect first
+  VariableDeltaDecoder other_decoder{};
+  EXPECT_EQ(other_decoder.DecodeKeyframe(keyframe).first, sup::dto::AnyValue{});
+  EXPECT_EQ(other_decoder.Decode(delta), std::make_pair(value_3, true));
+
+  // Plain variable states are not keyframes
+  EXPECT_EQ(other_decoder.DecodeKeyframe(EncodeVariableState(value_1, true)).first,
+            sup::dto::AnyValue{});
+}
+
+TEST_F(VariableDeltaTest, CoalescedKeyframe)
+{
+  VariableDeltaEncoder encoder{2};
+  VariableDeltaDecoder decoder{};
+  auto value_1 = CreateStructuredValue(1, 10);
+  auto keyframe_1 = encoder.Encode(value_1, true);
+  auto value_2 = CreateStructuredValue(2, 10);
+  auto delta_2 = encoder.Encode(value_2, true);
+  auto value_3 = CreateStructuredValue(3, 10);
+  auto keyframe_3 = encoder.Encode(value_3, true);
+  auto value_4 = CreateStructuredValue(4, 40);
+  auto delta_4 = encoder.Encode(value_4, false);
+  ASSERT_FALSE(IsVariableDelta(keyframe_3));
+  ASSERT_TRUE(IsVariableDelta(delta_4));
+  EXPECT_EQ(decoder.Decode(keyframe_1), std::make_pair(value_1, true));
+  EXPECT_EQ(decoder.DecodeKeyframe(keyframe_1).first, sup::dto::AnyValue{});
+
+  // The variable channel coalesced the second keyframe with the delta that followed it: the delta
+  // is decoded when the keyframe arrives on the keyframe channel
+  EXPECT_EQ(decoder.Decode(delta_4).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.DecodeKeyframe(keyframe_3), std::make_pair(value_4, false));
+
+  // Older keyframes and deltas of older keyframes are ignored
+  EXPECT_EQ(decoder.DecodeKeyframe(keyframe_1).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.Decode(delta_2).first, sup::dto::AnyValue{});
+  EXPECT_EQ(decoder.Decode(delta_4), std::make_pair(value_4, false));
+}
+
+TEST_F(VariableDeltaTest, NoKeyframeInterval)
+{
+  // Without an interval, all updates are keyframes
+  VariableDeltaEncoder encoder{0};
+  EXPECT_FALSE(IsVariableDelta(encoder.Encode(CreateStructuredValue(1, 10), true)));
+  EXPECT_FALSE(IsVariableDelta(encoder.Encode(CreateStructuredValue(2, 10), true)));
+}
+
+sup::dto::AnyValue VariableDeltaTest::CreateStructuredValue(sup::dto::int32 a,
+                                                            sup::dto::uint16 element)
+{
+  sup::dto::AnyValue element_av = {{
+    { "x", { sup::dto::UnsignedInteger16Type, element }},
+    { "name", "element" }
+  }};
+  auto arr = sup::dto::ArrayValue({ element_av, element_av, element_av });
+  sup::dto::AnyValue result = {{
+    { "a", { sup::dto::SignedInteger32Type, a }},
+    { "arr", arr }
+  }};
+  return result;
+}